@@ -0,0 +1,419 @@
+#include "generator.hh"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+/*!
+ * \brief	counter of nested loops is decremented from this value
+ */
+static const uint32_t LOOP_COUNT = 16;
+
+/*!
+ * \brief	nested loops use one register each
+ */
+static const size_t MAX_LOOP_DEPTH = 4;
+
+/*!
+ * \brief	limit of ARM immediates used by cases and stack variables
+ */
+static const size_t MAX_ARM_IMMEDIATE = 255;
+
+/*!
+ * \brief	ARM stores of blocks have a 12 bits offset, so each window
+ *			of 1024 blocks stores relative to its own base, r0 + 0x1000 * window
+ *			The window is an ARM immediate, so at most 256 windows
+ */
+static const size_t ARM_BLOCKS_PER_WINDOW = 0x1000 / 4;
+static const size_t MAX_ARM_BLOCKS = ARM_BLOCKS_PER_WINDOW * (MAX_ARM_IMMEDIATE + 1);
+
+/*!
+ * \brief	distance between two generated callees
+ */
+static const size_t CALLEE_SPACING = 0x10;
+
+/**********************************************************************/
+size_t CodeBuffer::label()
+{
+	m_labels.push_back(std::numeric_limits<size_t>::max());
+	return m_labels.size() - 1;
+}
+
+/**********************************************************************/
+void CodeBuffer::bind(size_t label)
+{
+	bind(label, m_code.size());
+}
+
+/**********************************************************************/
+void CodeBuffer::bind(size_t label, size_t position)
+{
+	m_labels.at(label) = position;
+}
+
+/**********************************************************************/
+size_t CodeBuffer::position() const
+{
+	return m_code.size();
+}
+
+/**********************************************************************/
+void CodeBuffer::emit(std::initializer_list<uint8_t> bytes)
+{
+	m_code.insert(m_code.end(), bytes);
+}
+
+/**********************************************************************/
+void CodeBuffer::emit32(uint32_t value)
+{
+	for (auto i = 0; i < 4; i++)
+	{
+		m_code.push_back(uint8_t(value >> (i * 8)));
+	}
+}
+
+/**********************************************************************/
+void CodeBuffer::emitRel32(size_t label, size_t base)
+{
+	m_fixups.push_back({ FixupKind::Rel32, m_code.size(), label, base });
+	emit32(0);
+}
+
+/**********************************************************************/
+void CodeBuffer::emitRel32(size_t label)
+{
+	emitRel32(label, m_code.size() + 4);
+}
+
+/**********************************************************************/
+void CodeBuffer::emitArmBranch(uint32_t opcode, size_t label)
+{
+	// pc reads two instructions ahead
+	m_fixups.push_back({ FixupKind::Arm24, m_code.size(), label, m_code.size() + 8 });
+	emit32(opcode);
+}
+
+/**********************************************************************/
+void CodeBuffer::align(size_t alignment, uint8_t padding)
+{
+	while (m_code.size() % alignment != 0)
+	{
+		m_code.push_back(padding);
+	}
+}
+
+/**********************************************************************/
+std::vector<uint8_t> CodeBuffer::finish()
+{
+	for (auto& fixup : m_fixups)
+	{
+		auto target = m_labels.at(fixup.label);
+		if (target == std::numeric_limits<size_t>::max())
+		{
+			throw std::logic_error("unbound label");
+		}
+
+		auto distance = int64_t(target) - int64_t(fixup.base);
+		uint32_t value = 0;
+		for (auto i = 0; i < 4; i++)
+		{
+			value |= uint32_t(m_code[fixup.position + i]) << (i * 8);
+		}
+
+		switch (fixup.kind)
+		{
+		case FixupKind::Rel32:
+			value = uint32_t(int32_t(distance));
+			break;
+		case FixupKind::Arm24:
+			value = (value & 0xFF000000) | (uint32_t(distance / 4) & 0x00FFFFFF);
+			break;
+		}
+
+		for (auto i = 0; i < 4; i++)
+		{
+			m_code[fixup.position + i] = uint8_t(value >> (i * 8));
+		}
+	}
+	return m_code;
+}
+
+/**********************************************************************/
+SyntheticFunction::SyntheticFunction(Isa isa, const Shape& shape)
+{
+	m_name = (isa == Isa::X86_64 ? "x86_64" : "arm") +
+		std::string("_b") + std::to_string(shape.blocks) +
+		"_s" + std::to_string(shape.switchCases) +
+		"_l" + std::to_string(shape.loopDepth) +
+		"_c" + std::to_string(shape.calls) +
+		"_v" + std::to_string(shape.stackVars);
+
+	if (isa == Isa::X86_64)
+	{
+		m_code = generateX86_64(shape);
+		m_payload = { m_name.c_str(), "x86:LE:64:default:windows", "__fastcall", 0x140001000, m_code.size(), m_code.data(), m_code.size() };
+	}
+	else
+	{
+		m_code = generateArm(shape);
+		m_payload = { m_name.c_str(), "ARM:LE:32:v7", "__stdcall", 0x10000, m_code.size(), m_code.data(), m_code.size() };
+	}
+}
+
+/**********************************************************************/
+const Payload& SyntheticFunction::getPayload() const
+{
+	return m_payload;
+}
+
+/**********************************************************************/
+std::vector<uint8_t> SyntheticFunction::generateX86_64(const Shape& shape)
+{
+	CodeBuffer code;
+	auto loopDepth = std::min(shape.loopDepth, MAX_LOOP_DEPTH);
+
+	// push rbp ; mov rbp, rsp ; sub rsp, frame (with shadow space for calls)
+	code.emit({ 0x55, 0x48, 0x89, 0xE5, 0x48, 0x81, 0xEC });
+	code.emit32(uint32_t((shape.stackVars * 8 + 15) / 16 * 16 + 32));
+
+	// xor eax, eax
+	code.emit({ 0x31, 0xC0 });
+
+	// mov dword ptr [rbp - 8 * (i + 1)], i
+	for (size_t i = 0; i < shape.stackVars; i++)
+	{
+		code.emit({ 0xC7, 0x85 });
+		code.emit32(uint32_t(-int32_t((i + 1) * 8)));
+		code.emit32(uint32_t(i));
+	}
+
+	// test edx, edx ; je over the store ; mov dword ptr [rcx + 4 * i], i
+	for (size_t i = 0; i < shape.blocks; i++)
+	{
+		code.emit({ 0x85, 0xD2, 0x74, 0x0A, 0xC7, 0x81 });
+		code.emit32(uint32_t(i * 4));
+		code.emit32(uint32_t(i));
+	}
+
+	// counters are r8d to r11d
+	std::vector<size_t> loops;
+	for (size_t k = 0; k < loopDepth; k++)
+	{
+		// mov r(8+k)d, LOOP_COUNT
+		code.emit({ 0x41, uint8_t(0xB8 + k) });
+		code.emit32(LOOP_COUNT);
+		loops.push_back(code.label());
+		code.bind(loops.back());
+	}
+
+	if (loopDepth != 0)
+	{
+		// add dword ptr [rcx], 1
+		code.emit({ 0x83, 0x01, 0x01 });
+	}
+
+	for (size_t k = loopDepth; k-- > 0;)
+	{
+		// dec r(8+k)d ; jnz loop
+		code.emit({ 0x41, 0xFF, uint8_t(0xC8 + k), 0x0F, 0x85 });
+		code.emitRel32(loops[k]);
+	}
+
+	std::vector<size_t> cases;
+	auto table = code.label();
+	if (shape.switchCases != 0)
+	{
+		auto end = code.label();
+
+		// cmp edx, cases - 1 ; ja end
+		code.emit({ 0x81, 0xFA });
+		code.emit32(uint32_t(shape.switchCases - 1));
+		code.emit({ 0x0F, 0x87 });
+		code.emitRel32(end);
+
+		// mov edx, edx ; lea r10, [rip + table]
+		code.emit({ 0x89, 0xD2, 0x4C, 0x8D, 0x15 });
+		code.emitRel32(table);
+
+		// movsxd r11, dword ptr [r10 + rdx * 4] ; add r11, r10 ; jmp r11
+		code.emit({ 0x4D, 0x63, 0x1C, 0x92, 0x4D, 0x01, 0xD3, 0x41, 0xFF, 0xE3 });
+
+		for (size_t i = 0; i < shape.switchCases; i++)
+		{
+			cases.push_back(code.label());
+			code.bind(cases.back());
+
+			// mov dword ptr [rcx + 4 * i], i ; jmp end
+			code.emit({ 0xC7, 0x81 });
+			code.emit32(uint32_t(i * 4));
+			code.emit32(uint32_t(i));
+			code.emit({ 0xE9 });
+			code.emitRel32(end);
+		}
+		code.bind(end);
+	}
+
+	// mov ecx, i ; call callee
+	std::vector<size_t> callees;
+	for (size_t i = 0; i < shape.calls; i++)
+	{
+		code.emit({ 0xB9 });
+		code.emit32(uint32_t(i));
+		code.emit({ 0xE8 });
+		callees.push_back(code.label());
+		code.emitRel32(callees.back());
+	}
+
+	// add eax, dword ptr [rbp - 8 * (i + 1)]
+	for (size_t i = 0; i < shape.stackVars; i++)
+	{
+		code.emit({ 0x03, 0x85 });
+		code.emit32(uint32_t(-int32_t((i + 1) * 8)));
+	}
+
+	// mov rsp, rbp ; pop rbp ; ret
+	code.emit({ 0x48, 0x89, 0xEC, 0x5D, 0xC3 });
+
+	// jump table entries are relative to the table
+	code.align(4, 0xCC);
+	code.bind(table);
+	auto tableStart = code.position();
+	for (auto label : cases)
+	{
+		code.emitRel32(label, tableStart);
+	}
+
+	// callees are after the function, the loader reads them as zeros
+	auto end = code.position();
+	for (size_t i = 0; i < callees.size(); i++)
+	{
+		code.bind(callees[i], end + (i + 1) * CALLEE_SPACING);
+	}
+
+	return code.finish();
+}
+
+/**********************************************************************/
+std::vector<uint8_t> SyntheticFunction::generateArm(const Shape& shape)
+{
+	CodeBuffer code;
+	auto loopDepth = std::min(shape.loopDepth, MAX_LOOP_DEPTH);
+	auto stackVars = std::min(shape.stackVars, MAX_ARM_IMMEDIATE);
+	auto switchCases = std::min(shape.switchCases, MAX_ARM_IMMEDIATE);
+
+	// push {r4-r8, r11, lr} ; sub sp, sp, 4 * vars ; mov r4, 0
+	code.emit32(0xE92D49F0);
+	code.emit32(0xE24DDF00 | uint32_t(stackVars));
+	code.emit32(0xE3A04000);
+
+	// mov r3, i ; str r3, [sp, 4 * i]
+	for (size_t i = 0; i < stackVars; i++)
+	{
+		code.emit32(0xE3A03000 | uint32_t(i));
+		code.emit32(0xE58D3000 | uint32_t(i * 4));
+	}
+
+	// cmp r1, 0 ; beq over the store ; mov r3, i ; str r3, [base, 4 * i]
+	// the first window stores relative to r0, the next ones to r2
+	auto blocks = std::min(shape.blocks, MAX_ARM_BLOCKS);
+	for (size_t i = 0; i < blocks; i++)
+	{
+		auto window = i / ARM_BLOCKS_PER_WINDOW;
+		if (window != 0 && i % ARM_BLOCKS_PER_WINDOW == 0)
+		{
+			// add r2, r0, 0x1000 * window
+			code.emit32(0xE2802A00 | uint32_t(window));
+		}
+
+		auto base = uint32_t(window == 0 ? 0 : 2);
+		code.emit32(0xE3510000);
+		code.emit32(0x0A000001);
+		code.emit32(0xE3A03000 | uint32_t(i & 0xFF));
+		code.emit32(0xE5803000 | (base << 16) | uint32_t((i % ARM_BLOCKS_PER_WINDOW) * 4));
+	}
+
+	// counters are r5 to r8
+	std::vector<size_t> loops;
+	for (size_t k = 0; k < loopDepth; k++)
+	{
+		// mov r(5+k), LOOP_COUNT
+		code.emit32(0xE3A00000 | uint32_t((5 + k) << 12) | LOOP_COUNT);
+		loops.push_back(code.label());
+		code.bind(loops.back());
+	}
+
+	if (loopDepth != 0)
+	{
+		// ldr r3, [r0] ; add r3, r3, 1 ; str r3, [r0]
+		code.emit32(0xE5903000);
+		code.emit32(0xE2833001);
+		code.emit32(0xE5803000);
+	}
+
+	for (size_t k = loopDepth; k-- > 0;)
+	{
+		// subs r(5+k), r(5+k), 1 ; bne loop
+		auto reg = uint32_t(5 + k);
+		code.emit32(0xE2500001 | (reg << 16) | (reg << 12));
+		code.emitArmBranch(0x1A000000, loops[k]);
+	}
+
+	if (switchCases != 0)
+	{
+		auto end = code.label();
+
+		// cmp r1, cases - 1 ; bhi end ; add pc, pc, r1, lsl 2 ; b end
+		code.emit32(0xE3510000 | uint32_t(switchCases - 1));
+		code.emitArmBranch(0x8A000000, end);
+		code.emit32(0xE08FF101);
+		code.emitArmBranch(0xEA000000, end);
+
+		// table of branches to cases
+		std::vector<size_t> cases;
+		for (size_t i = 0; i < switchCases; i++)
+		{
+			cases.push_back(code.label());
+			code.emitArmBranch(0xEA000000, cases.back());
+		}
+
+		// mov r3, i ; str r3, [r0, 4 * i] ; b end
+		for (size_t i = 0; i < switchCases; i++)
+		{
+			code.bind(cases[i]);
+			code.emit32(0xE3A03000 | uint32_t(i));
+			code.emit32(0xE5803000 | uint32_t(i * 4));
+			code.emitArmBranch(0xEA000000, end);
+		}
+		code.bind(end);
+	}
+
+	// mov r0, i ; bl callee
+	std::vector<size_t> callees;
+	for (size_t i = 0; i < shape.calls; i++)
+	{
+		code.emit32(0xE3A00000 | uint32_t(i & 0xFF));
+		callees.push_back(code.label());
+		code.emitArmBranch(0xEB000000, callees.back());
+	}
+
+	// ldr r3, [sp, 4 * i] ; add r4, r4, r3
+	for (size_t i = 0; i < stackVars; i++)
+	{
+		code.emit32(0xE59D3000 | uint32_t(i * 4));
+		code.emit32(0xE0844003);
+	}
+
+	// mov r0, r4 ; add sp, sp, 4 * vars ; pop {r4-r8, r11, pc}
+	code.emit32(0xE1A00004);
+	code.emit32(0xE28DDF00 | uint32_t(stackVars));
+	code.emit32(0xE8BD89F0);
+
+	// callees are after the function, the loader reads them as zeros
+	auto end = code.position();
+	for (size_t i = 0; i < callees.size(); i++)
+	{
+		code.bind(callees[i], end + (i + 1) * CALLEE_SPACING);
+	}
+
+	return code.finish();
+}
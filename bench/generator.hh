@@ -0,0 +1,170 @@
+#ifndef __YAGI_BENCH_GENERATOR__
+#define __YAGI_BENCH_GENERATOR__
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "payload_test.h"
+
+/*!
+ * \brief	Shape of a synthetic function
+ */
+struct Shape
+{
+	/*!
+	 * \brief	number of conditional stores, two basic blocks each
+	 *			ARM is limited to 262144 stores
+	 */
+	size_t blocks;
+
+	/*!
+	 * \brief	number of cases of a jump table, none if zero
+	 */
+	size_t switchCases;
+
+	/*!
+	 * \brief	number of nested loops, at most 4
+	 */
+	size_t loopDepth;
+
+	/*!
+	 * \brief	number of calls to distinct functions
+	 */
+	size_t calls;
+
+	/*!
+	 * \brief	number of stack variables, written then summed
+	 */
+	size_t stackVars;
+};
+
+/*!
+ * \brief	Instruction set of a synthetic function
+ */
+enum class Isa
+{
+	X86_64,
+	Arm
+};
+
+/*!
+ * \brief	Machine code with labels resolved once all code is emitted
+ */
+class CodeBuffer
+{
+private:
+	/*!
+	 * \brief	how a label is written into the code
+	 */
+	enum class FixupKind
+	{
+		Rel32,	// 32 bits distance from a base position
+		Arm24	// 24 bits word distance of an ARM branch
+	};
+
+	struct Fixup
+	{
+		FixupKind kind;
+		size_t position;
+		size_t label;
+		size_t base;
+	};
+
+	std::vector<uint8_t> m_code;
+	std::vector<size_t> m_labels;
+	std::vector<Fixup> m_fixups;
+
+public:
+	/*!
+	 * \brief	declare a new unbound label
+	 * \return	label id
+	 */
+	size_t label();
+
+	/*!
+	 * \brief	bind a label to the current position
+	 */
+	void bind(size_t label);
+
+	/*!
+	 * \brief	bind a label to any position, even outside the code
+	 */
+	void bind(size_t label, size_t position);
+
+	/*!
+	 * \return	current position
+	 */
+	size_t position() const;
+
+	void emit(std::initializer_list<uint8_t> bytes);
+	void emit32(uint32_t value);
+
+	/*!
+	 * \brief	emit a 32 bits distance between a label and a base position
+	 */
+	void emitRel32(size_t label, size_t base);
+
+	/*!
+	 * \brief	emit an x86 rel32 operand, relative to the next instruction
+	 */
+	void emitRel32(size_t label);
+
+	/*!
+	 * \brief	emit an ARM branch or branch with link to a label
+	 * \param	opcode	condition and opcode bits, offset is set to zero
+	 */
+	void emitArmBranch(uint32_t opcode, size_t label);
+
+	/*!
+	 * \brief	pad the code with a byte up to an alignment
+	 */
+	void align(size_t alignment, uint8_t padding);
+
+	/*!
+	 * \brief	resolve all labels
+	 * \return	final code
+	 */
+	std::vector<uint8_t> finish();
+};
+
+/*!
+ * \brief	A generated function and the payload to decompile it
+ *			Payload points to the code, so it can't be copied
+ */
+class SyntheticFunction
+{
+private:
+	std::string m_name;
+	std::vector<uint8_t> m_code;
+	Payload m_payload;
+
+public:
+	/*!
+	 * \brief	generate a function
+	 * \param	isa	instruction set
+	 * \param	shape	shape of the function
+	 */
+	SyntheticFunction(Isa isa, const Shape& shape);
+
+	SyntheticFunction(const SyntheticFunction&) = delete;
+	SyntheticFunction& operator=(const SyntheticFunction&) = delete;
+
+	/*!
+	 * \return	payload to give to a session
+	 */
+	const Payload& getPayload() const;
+
+	/*!
+	 * \brief	generate x86-64 code, parameters are in rcx and edx
+	 */
+	static std::vector<uint8_t> generateX86_64(const Shape& shape);
+
+	/*!
+	 * \brief	generate ARM code, parameters are in r0 and r1
+	 *			switch cases and stack variables are limited to 255
+	 */
+	static std::vector<uint8_t> generateArm(const Shape& shape);
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+#include "session.hh"
+#include "symbolcollector.hh"
+#include "revision.hh"
+
+/*!
+ * \brief	Build the architecture of a payload, load its sleigh
+ *			specification and find the function to decompile
+ */
+static void BM_ArchitectureInit(benchmark::State& state, const Payload* payload)
+{
+	for (auto _ : state)
+	{
+		Session session(*payload);
+		benchmark::DoNotOptimize(session.func);
+	}
+	state.SetLabel(payload->sleighId);
+}
+
+/*!
+ * \brief	Run all decompiler actions on a payload
+ */
+static void BM_PerformActions(benchmark::State& state, const Payload* payload)
+{
+	Session session(*payload);
+
+	for (auto _ : state)
+	{
+		session.arch->clearAnalysis(session.func);
+		session.arch->performActions(*session.func);
+	}
+	state.SetLabel(payload->sleighId);
+}
+
+/*!
+ * \brief	Print an already decompiled payload
+ */
+static void BM_DocFunction(benchmark::State& state, const Payload* payload)
+{
+	Session session(*payload);
+	session.arch->performActions(*session.func);
+
+	for (auto _ : state)
+	{
+		std::stringstream ss;
+		session.arch->print->setOutputStream(&ss);
+		session.arch->print->docFunction(session.func);
+		benchmark::DoNotOptimize(ss.str());
+	}
+	state.SetLabel(payload->sleighId);
+}
+
+/*!
+ * \brief	Collect symbols used to navigate from an already decompiled payload
+ */
+static void BM_CollectSymbols(benchmark::State& state, const Payload* payload)
+{
+	Session session(*payload);
+	session.arch->performActions(*session.func);
+
+	size_t symbols = 0;
+	for (auto _ : state)
+	{
+		symbols = yagi::SymbolCollector::collect(*session.func).size();
+	}
+	state.counters["symbols"] = double(symbols);
+	state.SetLabel(payload->sleighId);
+}
+
+/*!
+ * \brief	Register every benchmark for every payload of unit tests
+ *			and record revisions compared by the report
+ */
+static bool RegisterPayloadBenchmarks()
+{
+	benchmark::AddCustomContext("yagi_version", YAGI_BENCH_VERSION);
+	benchmark::AddCustomContext("yagi_revision", YAGI_BENCH_REVISION);
+	benchmark::AddCustomContext("ghidra_revision", YAGI_BENCH_GHIDRA_REVISION);
+
+	for (auto& payload : PAYLOADS)
+	{
+		auto suffix = std::string("/") + payload.name;
+		benchmark::RegisterBenchmark(("BM_ArchitectureInit" + suffix).c_str(), BM_ArchitectureInit, &payload)->Unit(benchmark::kMillisecond);
+		benchmark::RegisterBenchmark(("BM_PerformActions" + suffix).c_str(), BM_PerformActions, &payload)->Unit(benchmark::kMicrosecond);
+		benchmark::RegisterBenchmark(("BM_DocFunction" + suffix).c_str(), BM_DocFunction, &payload)->Unit(benchmark::kMicrosecond);
+		benchmark::RegisterBenchmark(("BM_CollectSymbols" + suffix).c_str(), BM_CollectSymbols, &payload)->Unit(benchmark::kMicrosecond);
+	}
+	return true;
+}
+
+static const bool PAYLOAD_BENCHMARKS = RegisterPayloadBenchmarks();
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include "session.hh"
+
+static const Payload PAYLOAD_X86_64_SMALL = { "x86_64_small", "x86:LE:64:default:windows", "__fastcall", 0xaaaaaaaa, 27, X86_64_BYTES, sizeof(X86_64_BYTES) };
+static const Payload PAYLOAD_X86_64_LOOP = { "x86_64_loop", "x86:LE:64:default:windows", "__fastcall", 0x140018A70, 90, X86_64_CFG_BYTES, sizeof(X86_64_CFG_BYTES) };
+static const Payload PAYLOAD_ARM_32 = { "arm_32", "ARM:LE:32:v7", "__stdcall", 0xaaaaaaaa, 20, ARM_32_BYTES, sizeof(ARM_32_BYTES) };
+
+/*!
+ * \brief	Decompile and print a payload with a profile
+ */
+static void BM_Decompile(benchmark::State& state, const Payload* payload, yagi::Decompiler::Profile profile)
+{
+	Session session(*payload);
+	session.arch->setActionProfile(profile);
+
+	for (auto _ : state)
+	{
+		session.arch->clearAnalysis(session.func);
+		session.arch->performActions(*session.func);
+
+		std::stringstream ss;
+		session.arch->print->setOutputStream(&ss);
+		session.arch->print->docFunction(session.func);
+		benchmark::DoNotOptimize(ss.str());
+	}
+}
+
+BENCHMARK_CAPTURE(BM_Decompile, x86_64_small_full, &PAYLOAD_X86_64_SMALL, yagi::Decompiler::Profile::Full)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Decompile, x86_64_small_preview, &PAYLOAD_X86_64_SMALL, yagi::Decompiler::Profile::Preview)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Decompile, x86_64_loop_full, &PAYLOAD_X86_64_LOOP, yagi::Decompiler::Profile::Full)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Decompile, x86_64_loop_preview, &PAYLOAD_X86_64_LOOP, yagi::Decompiler::Profile::Preview)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Decompile, arm_32_full, &PAYLOAD_ARM_32, yagi::Decompiler::Profile::Full)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Decompile, arm_32_preview, &PAYLOAD_ARM_32, yagi::Decompiler::Profile::Preview)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include "session.hh"
+#include "print.hh"
+#include "generator.hh"
+
+// if (param_2 != 0) { *(int32_t *)(param_1 + offset) = value; } repeated
+static const SyntheticFunction X86_64_LARGE(Isa::X86_64, Shape{ 256, 0, 0, 0, 0 });
+
+/*!
+ * \brief	Print an already decompiled function
+ * \param	language	name of the print language
+ */
+static void BM_DocFunction(benchmark::State& state, const Payload* payload, const char* language)
+{
+	Session session(*payload);
+	session.arch->performActions(*session.func);
+	session.arch->setPrintLanguage(language);
+
+	// keep the IDA emitter linked, it registers the yagi print language
+	if (std::string(language) == "yagi-c-language" && dynamic_cast<yagi::IdaPrint*>(session.arch->print) == nullptr)
+	{
+		state.SkipWithError("yagi print language is not registered");
+		return;
+	}
+
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		std::stringstream ss;
+		session.arch->print->setOutputStream(&ss);
+		session.arch->print->docFunction(session.func);
+		bytes += ss.str().size();
+	}
+	state.SetBytesProcessed(int64_t(bytes));
+}
+
+BENCHMARK_CAPTURE(BM_DocFunction, x86_64_large_c, &X86_64_LARGE.getPayload(), "c-language")->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DocFunction, x86_64_large_ida, &X86_64_LARGE.getPayload(), "yagi-c-language")->Unit(benchmark::kMicrosecond);
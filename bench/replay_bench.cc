@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "session.hh"
+#include "trace.hh"
+#include "exception.hh"
+
+/*!
+ * \brief	Decompile a function recorded in an IDA session
+ *			the backend is replayed from the trace, no IDA is needed
+ */
+static void BM_ReplayDecompile(benchmark::State& state, std::shared_ptr<const yagi::TraceReplay> replay, uint64_t address)
+{
+	auto& content = replay->getContent();
+	Session session(
+		content.sleighId,
+		content.defaultCC,
+		address,
+		std::make_unique<yagi::ReplayLoaderFactory>(replay),
+		std::make_unique<yagi::ReplaySymbolInfoFactory>(replay),
+		std::make_unique<yagi::ReplayTypeInfoFactory>(replay)
+	);
+	if (session.func == nullptr)
+	{
+		state.SkipWithError("function not found in trace");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		session.arch->clearAnalysis(session.func);
+		session.arch->performActions(*session.func);
+		std::stringstream ss;
+		session.arch->print->setOutputStream(&ss);
+		session.arch->print->docFunction(session.func);
+		benchmark::DoNotOptimize(ss.str());
+	}
+	state.SetLabel(content.sleighId);
+}
+
+/*!
+ * \brief	Register a benchmark for every function of the trace
+ *			given by YAGI_TRACE, recorded with -Oyagi:record_trace
+ */
+static bool RegisterReplayBenchmarks()
+{
+	auto path = std::getenv("YAGI_TRACE");
+	if (path == nullptr)
+	{
+		return false;
+	}
+
+	try
+	{
+		auto replay = yagi::TraceReplay::load(path);
+		for (auto& [address, function] : replay->getContent().functions)
+		{
+			benchmark::RegisterBenchmark(("BM_ReplayDecompile/" + function.symbol.name).c_str(), BM_ReplayDecompile, replay, address)->Unit(benchmark::kMillisecond);
+		}
+	}
+	catch (yagi::Error& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+static const bool REPLAY_BENCHMARKS = RegisterReplayBenchmarks();
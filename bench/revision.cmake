@@ -0,0 +1,40 @@
+# Write the revisions of Yagi and of the Ghidra submodule in a header
+# Run at each build, the header is only rewritten when a revision changed
+# so benchmarks are not rebuilt for nothing
+#   SOURCE_DIR	root of the Yagi repository
+#   OUTPUT	header to write
+
+execute_process(
+  COMMAND git rev-parse HEAD
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE YAGI_BENCH_REVISION
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET
+)
+
+# commit checked out in the submodule, not the one recorded by Yagi
+# git would report the Yagi commit for a submodule not checked out
+set(YAGI_BENCH_GHIDRA_REVISION "")
+if(EXISTS ${SOURCE_DIR}/ghidra/ghidra/.git)
+  execute_process(
+    COMMAND git -C ghidra/ghidra rev-parse HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE YAGI_BENCH_GHIDRA_REVISION
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+  )
+endif()
+
+set(REVISION_CONTENT
+"#define YAGI_BENCH_REVISION \"${YAGI_BENCH_REVISION}\"
+#define YAGI_BENCH_GHIDRA_REVISION \"${YAGI_BENCH_GHIDRA_REVISION}\"
+")
+
+set(PREVIOUS_CONTENT "")
+if(EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} PREVIOUS_CONTENT)
+endif()
+
+if(NOT PREVIOUS_CONTENT STREQUAL REVISION_CONTENT)
+  file(WRITE ${OUTPUT} "${REVISION_CONTENT}")
+endif()
@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "session.hh"
+#include "generator.hh"
+#include "symbolcollector.hh"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/*!
+ * \brief	Peak resident set size of the process
+ * \return	size in bytes
+ */
+static double PeakRss()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return double(counters.PeakWorkingSetSize);
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return double(usage.ru_maxrss);
+#else
+	return double(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/*!
+ * \brief	Dimension of a shape that varies in a benchmark
+ */
+enum class Dimension
+{
+	Blocks,
+	SwitchCases,
+	LoopDepth,
+	Calls,
+	StackVars
+};
+
+/*!
+ * \brief	A small shape where only one dimension grows
+ */
+static Shape MakeShape(Dimension dimension, size_t size)
+{
+	Shape shape{ 4, 4, 1, 1, 4 };
+	switch (dimension)
+	{
+	case Dimension::Blocks:
+		shape.blocks = size;
+		break;
+	case Dimension::SwitchCases:
+		shape.switchCases = size;
+		break;
+	case Dimension::LoopDepth:
+		shape.loopDepth = size;
+		break;
+	case Dimension::Calls:
+		shape.calls = size;
+		break;
+	case Dimension::StackVars:
+		shape.stackVars = size;
+		break;
+	}
+	return shape;
+}
+
+/*!
+ * \brief	Report size of the function and memory used
+ *			Peak RSS never decreases, sizes are run in increasing order
+ *			so the growth is the cost of the largest function so far
+ */
+static void SetScaleCounters(benchmark::State& state, const Payload& payload, double rssBefore)
+{
+	auto rss = PeakRss();
+	state.SetComplexityN(state.range(0));
+	state.counters["code_bytes"] = double(payload.length);
+	state.counters["peak_rss"] = benchmark::Counter(rss, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+	state.counters["rss_growth"] = benchmark::Counter(rss - rssBefore, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+/*!
+ * \brief	Run all decompiler actions on a synthetic function
+ */
+static void BM_ScaleActions(benchmark::State& state, Isa isa, Dimension dimension)
+{
+	auto rssBefore = PeakRss();
+	SyntheticFunction function(isa, MakeShape(dimension, size_t(state.range(0))));
+	Session session(function.getPayload());
+
+	for (auto _ : state)
+	{
+		session.arch->clearAnalysis(session.func);
+		session.arch->performActions(*session.func);
+	}
+	SetScaleCounters(state, function.getPayload(), rssBefore);
+}
+
+/*!
+ * \brief	Collect symbols of an already decompiled synthetic function
+ */
+static void BM_ScaleSymbols(benchmark::State& state, Isa isa, Dimension dimension)
+{
+	auto rssBefore = PeakRss();
+	SyntheticFunction function(isa, MakeShape(dimension, size_t(state.range(0))));
+	Session session(function.getPayload());
+	session.arch->performActions(*session.func);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(yagi::SymbolCollector::collect(*session.func));
+	}
+	SetScaleCounters(state, function.getPayload(), rssBefore);
+}
+
+/*!
+ * \brief	Sizes of a dimension, ARM immediates limit cases and variables to 255
+ */
+static void ApplySizes(benchmark::internal::Benchmark* benchmark, Dimension dimension)
+{
+	switch (dimension)
+	{
+	case Dimension::Blocks:
+		benchmark->RangeMultiplier(4)->Range(16, 4096);
+		break;
+	case Dimension::Calls:
+		benchmark->RangeMultiplier(4)->Range(4, 1024);
+		break;
+	case Dimension::SwitchCases:
+	case Dimension::StackVars:
+		benchmark->RangeMultiplier(4)->Range(4, 255);
+		break;
+	case Dimension::LoopDepth:
+		benchmark->DenseRange(1, 4);
+		break;
+	}
+	benchmark->Complexity()->Unit(benchmark::kMillisecond);
+}
+
+/*!
+ * \brief	Register both benchmarks for every instruction set and dimension
+ */
+static bool RegisterScaleBenchmarks()
+{
+	const std::pair<Isa, const char*> isas[] = {
+		{ Isa::X86_64, "x86_64" },
+		{ Isa::Arm, "arm" }
+	};
+
+	const std::pair<Dimension, const char*> dimensions[] = {
+		{ Dimension::Blocks, "blocks" },
+		{ Dimension::SwitchCases, "switch_cases" },
+		{ Dimension::LoopDepth, "loop_depth" },
+		{ Dimension::Calls, "calls" },
+		{ Dimension::StackVars, "stack_vars" }
+	};
+
+	for (auto& [isa, isaName] : isas)
+	{
+		for (auto& [dimension, dimensionName] : dimensions)
+		{
+			auto suffix = std::string("/") + isaName + "/" + dimensionName;
+			ApplySizes(benchmark::RegisterBenchmark(("BM_ScaleActions" + suffix).c_str(), BM_ScaleActions, isa, dimension), dimension);
+			ApplySizes(benchmark::RegisterBenchmark(("BM_ScaleSymbols" + suffix).c_str(), BM_ScaleSymbols, isa, dimension), dimension);
+		}
+	}
+	return true;
+}
+
+static const bool SCALE_BENCHMARKS = RegisterScaleBenchmarks();
@@ -0,0 +1,103 @@
+#ifndef __YAGI_BENCH_SESSION__
+#define __YAGI_BENCH_SESSION__
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "yagiarchitecture.hh"
+#include "mock_logger_test.h"
+#include "mock_symbol_test.h"
+#include "mock_type_test.h"
+#include "mock_loader_test.h"
+#include "ghidra.hh"
+#include "payload_test.h"
+
+/*!
+ * \brief	An architecture ready to decompile a payload
+ */
+class Session
+{
+public:
+	DocumentStorage store;
+	std::unique_ptr<yagi::YagiArchitecture> arch;
+	Funcdata* func;
+
+	/*!
+	 * \brief	Build an architecture from any backend
+	 * \param	sleighId	sleigh id of the architecture
+	 * \param	defaultCC	default calling convention
+	 * \param	address	address of the function to decompile
+	 */
+	explicit Session(
+		const std::string& sleighId,
+		const std::string& defaultCC,
+		uint64_t address,
+		std::unique_ptr<yagi::LoaderFactory> loader,
+		std::unique_ptr<yagi::SymbolInfoFactory> symbols,
+		std::unique_ptr<yagi::TypeInfoFactory> types
+	)
+	{
+		// rescanning sleigh directories would be measured with the architecture
+		static const bool initialized = [] {
+			auto dir = std::getenv("GHIDRADIRTEST");
+			yagi::ghidra::init(dir != nullptr ? dir : "");
+			return true;
+		}();
+		(void)initialized;
+
+		arch = std::make_unique<yagi::YagiArchitecture>(
+			"bench",
+			sleighId,
+			std::move(loader),
+			std::make_unique<MockLogger>([](const std::string&) {}),
+			std::move(symbols),
+			std::move(types),
+			defaultCC
+		);
+
+		arch->init(store);
+		arch->setPrintLanguage("c-language");
+		func = arch->symboltab->getGlobalScope()->findFunction(
+			Address(arch->getDefaultCodeSpace(), address)
+		);
+	}
+
+	/*!
+	 * \brief	Build an architecture from the mocks of unit tests
+	 */
+	explicit Session(const Payload& payload)
+		: Session(
+			payload.sleighId,
+			payload.defaultCC,
+			payload.address,
+			std::make_unique<MockLoaderFactory>([&payload](uint1* ptr, int4 size, const Address& addr) {
+				std::memset(ptr, 0, size);
+				auto offset = addr.getOffset() - payload.address;
+				if (addr.getOffset() >= payload.address && offset < payload.length)
+				{
+					std::memcpy(ptr, payload.bytes + offset, std::min<size_t>(size, payload.length - offset));
+				}
+			}),
+			std::make_unique<MockSymbolInfoFactory>([&payload](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+				if (ea == payload.address)
+				{
+					return std::make_unique<MockSymbolInfo>(
+						payload.address, "test", payload.size, true, false, false, false
+					);
+				}
+				return std::nullopt;
+			},
+			[&payload](uint64_t) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+				return std::make_unique<MockFunctionSymbolInfo>(
+					std::make_unique<MockSymbolInfo>(
+						payload.address, "test", payload.size, true, false, false, false
+					)
+				);
+			}),
+			std::make_unique<MockTypeInfoFactory>([](uint64_t) { return std::nullopt; }, [](const std::string&) { return std::nullopt; })
+		)
+	{
+	}
+};
+
+#endif
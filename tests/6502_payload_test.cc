@@ -5,15 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0x0000EFD3
 #define FUNC_SIZE 14
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0xA9, 0x00, 0x85, 0x4A, 0x85, 0x4C, 0xA9, 0x08,
-	0x85, 0x4B, 0xA9, 0x10, 0x85, 0x4D, 
-};
+static const auto& PAYLOAD = MOS_6502_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_6502, DecompileWithoutType) {
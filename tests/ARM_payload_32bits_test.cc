@@ -5,17 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 20
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0x10, 0x30, 0x9F, 0xE5, 0x00, 0x20, 0xD3, 0xE5, 
-	0x00, 0x00, 0x52, 0xE3, 0x01, 0x20, 0xA0, 0x03,
-	0x00, 0x20, 0xC3, 0x05, 0x1E, 0xFF, 0x2F, 0xE1, 
-	0x7C, 0x08, 0x01, 0x00, 0x24, 0x00, 0x9F, 0xE5
-};
+static const auto& PAYLOAD = ARM_32_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_ARM_32, DecompileWithoutType) {
@@ -5,19 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 20
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0x3C, 0x1C, 0x00, 0x03, 0x27, 0x9C, 0x55, 0x68, 0x03, 0x99, 0xE0, 0x21, 0x27, 0xBD, 0xFF, 0xE0, 0x8F, 0x99, 0x81, 0x0C, 0xAF, 0xB0, 0x00, 0x18,
-	0x00, 0x80, 0x80, 0x25, 0x24, 0x04, 0x00, 0x04, 0xAF, 0xBC, 0x00, 0x10, 0xAF, 0xBF, 0x00, 0x1C,
-	0x04, 0x11, 0xD4, 0xEF, 0x02, 0x00, 0x28, 0x25, 0x1A, 0x00, 0x00, 0x09, 0x8F, 0xBF, 0x00, 0x1C,
-	0x00, 0x10, 0x20, 0x80, 0x24, 0x05, 0xFF, 0xFF, 0x00, 0x82, 0x20, 0x21, 0x00, 0x40, 0x18, 0x25,
-	0xAC, 0x65, 0x00, 0x00, 0x24, 0x63, 0x00, 0x04, 0x14, 0x64, 0xFF, 0xFD, 0x8F, 0xBF, 0x00, 0x1C,
-	0x8F, 0xB0, 0x00, 0x18, 0x03, 0xE0, 0x00, 0x08, 0x27, 0xBD, 0x00, 0x20, 0x3C, 0x1C, 0x00, 0x03
-};
+static const auto& PAYLOAD = MIPS_32_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_MIPS_32, DecompileWithoutType) {
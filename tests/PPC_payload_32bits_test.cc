@@ -5,21 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 20
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0x94, 0x21, 0xFF, 0xF0, 0x7C, 0x08, 0x02, 0xA6, 
-	0x93, 0xE1, 0x00, 0x0C, 0x3F, 0xE0, 0x10, 0x01,
-	0x89, 0x3F, 0x30, 0x94, 0x90, 0x01, 0x00, 0x14, 
-	0x2F, 0x89, 0x00, 0x00, 0x40, 0x9E, 0x00, 0x10,
-	0x4B, 0xFF, 0xFF, 0x61, 0x39, 0x20, 0x00, 0x01, 
-	0x99, 0x3F, 0x30, 0x94, 0x80, 0x01, 0x00, 0x14,
-	0x83, 0xE1, 0x00, 0x0C, 0x38, 0x21, 0x00, 0x10, 
-	0x7C, 0x08, 0x03, 0xA6, 0x4E, 0x80, 0x00, 0x20
-};
+static const auto& PAYLOAD = PPC_32_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_PPC_32, DecompileWithoutType) {
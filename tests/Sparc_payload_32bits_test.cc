@@ -5,16 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0x000111A8
 #define FUNC_SIZE 20
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0x9D, 0xE3, 0xBF, 0xA0, 0xF0, 0x27, 0xA0, 0x44,
-0x40, 0x00, 0x45, 0x8B, 0x90, 0x16, 0x00, 0x00, 0x40, 0x00, 0x45, 0x83, 0x90, 0x10, 0x20, 0x01,
-0x81, 0xC7, 0xE0, 0x08, 0x81, 0xE8, 0x00, 0x00, 0x81, 0xC7, 0xE0, 0x08
-	};
+static const auto& PAYLOAD = SPARC_32_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_sparc_32, DecompileWithoutType) {
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "codeview.hh"
+
+static std::shared_ptr<const yagi::Decompiler::Result> makeResult(const std::string& code)
+{
+	return std::make_shared<const yagi::Decompiler::Result>("test", 0x1000, code, std::map<std::string, yagi::MemoryLocation>{});
+}
+
+TEST(TestCodeView, IndexLines) {
+
+	yagi::CodeView view(makeResult("\nvoid test(void)\n\n{\n  return;\n}\n"));
+
+	ASSERT_EQ(view.size(), 6);
+	ASSERT_EQ(view.getLine(0), "");
+	ASSERT_EQ(view.getLine(1), "void test(void)");
+	ASSERT_EQ(view.getLine(4), "  return;");
+	ASSERT_EQ(view.getLine(5), "}");
+	ASSERT_EQ(view.getLine(6), "");
+	ASSERT_EQ(view.getResult().name, "test");
+}
+
+TEST(TestCodeView, LastLineWithoutLineFeed) {
+
+	yagi::CodeView view(makeResult("a\nb"));
+
+	ASSERT_EQ(view.size(), 2);
+	ASSERT_EQ(view.getLine(0), "a");
+	ASSERT_EQ(view.getLine(1), "b");
+
+	ASSERT_EQ(yagi::CodeView(makeResult("")).size(), 0);
+}
+
+TEST(TestCodeView, DiffRename) {
+
+	yagi::CodeView from(makeResult("void test(void)\n{\n  int a;\n  a = 0;\n  return;\n}\n"));
+	yagi::CodeView to(makeResult("void test(void)\n{\n  int counter;\n  counter = 0;\n  return;\n}\n"));
+
+	auto diff = yagi::CodeView::diff(from, to);
+	ASSERT_EQ(diff.prefix, 2);
+	ASSERT_EQ(diff.suffix, 2);
+	ASSERT_EQ(diff.getChangedLines(), 2);
+
+	// lines keep their place
+	for (size_t line = 0; line < from.size(); line++)
+	{
+		ASSERT_EQ(diff.remap(line), line);
+	}
+}
+
+TEST(TestCodeView, DiffInsertRemove) {
+
+	yagi::CodeView from(makeResult("a\nb\nc\nd\n"));
+	yagi::CodeView to(makeResult("a\nx\ny\nb\nc\nd\n"));
+
+	auto inserted = yagi::CodeView::diff(from, to);
+	ASSERT_EQ(inserted.prefix, 1);
+	ASSERT_EQ(inserted.suffix, 3);
+	ASSERT_EQ(inserted.getChangedLines(), 2);
+	ASSERT_EQ(inserted.remap(0), 0);
+	ASSERT_EQ(inserted.remap(2), 4);
+	ASSERT_EQ(inserted.remap(3), 5);
+
+	auto removed = yagi::CodeView::diff(to, from);
+	ASSERT_EQ(removed.getChangedLines(), 0);
+	ASSERT_EQ(removed.remap(2), 1);
+	ASSERT_EQ(removed.remap(5), 3);
+
+	// identical views
+	auto same = yagi::CodeView::diff(from, from);
+	ASSERT_EQ(same.prefix, 4);
+	ASSERT_EQ(same.getChangedLines(), 0);
+	ASSERT_EQ(same.remap(3), 3);
+}
+
+TEST(TestCodeView, CloseRenamedView) {
+
+	struct View
+	{
+		yagi::CodeView lines;
+	};
+
+	yagi::ViewRegistry<View> views;
+	View opened{ yagi::CodeView(makeResult("void test(void)\n")) };
+	views.add("test", &opened);
+
+	// the function is renamed, its view keeps its title
+	opened.lines = yagi::CodeView(std::make_shared<const yagi::Decompiler::Result>("renamed", 0x1000, "void renamed(void)\n", std::map<std::string, yagi::MemoryLocation>{}));
+	View other{ yagi::CodeView(makeResult("void renamed(void)\n")) };
+	views.add("renamed", &other);
+
+	views.remove(&opened);
+	ASSERT_EQ(views.find("test"), nullptr);
+	ASSERT_EQ(views.find("renamed"), &other);
+	ASSERT_EQ(std::distance(views.begin(), views.end()), 1);
+}
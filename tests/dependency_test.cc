@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "dependency.hh"
+
+#define FUNC_ADDR 0xaaaaaaaa
+#define CALLEE_ADDR 0xbbbbbbbb
+
+TEST(TestDependency, UnrelatedChangeKeepsResult) {
+
+	yagi::EpochTracker epochs;
+	yagi::DependencySet dependencies;
+	dependencies.addAddress(FUNC_ADDR);
+	dependencies.addAddress(CALLEE_ADDR);
+	dependencies.addBytes(FUNC_ADDR, 0x20);
+	dependencies.addType("struct_a");
+	auto epoch = epochs.getCurrent();
+
+	epochs.touchAddress(0x1000);
+	epochs.touchBytes(0x2000, 4);
+	epochs.touchType("struct_b");
+
+	ASSERT_FALSE(dependencies.isStale(epochs, epoch));
+}
+
+TEST(TestDependency, ConsultedChangeMakesStale) {
+
+	yagi::EpochTracker epochs;
+	yagi::DependencySet dependencies;
+	dependencies.addAddress(CALLEE_ADDR);
+	dependencies.addBytes(FUNC_ADDR, 0x20);
+	dependencies.addType("struct_a");
+	auto epoch = epochs.getCurrent();
+
+	yagi::EpochTracker renamed;
+	renamed.touchAddress(CALLEE_ADDR);
+	ASSERT_TRUE(dependencies.isStale(renamed, epoch));
+
+	yagi::EpochTracker patched;
+	patched.touchBytes(FUNC_ADDR + 0x10, 1);
+	ASSERT_TRUE(dependencies.isStale(patched, epoch));
+
+	yagi::EpochTracker retyped;
+	retyped.touchType("struct_a");
+	ASSERT_TRUE(dependencies.isStale(retyped, epoch));
+
+	yagi::EpochTracker rebased;
+	rebased.touchMemory();
+	ASSERT_TRUE(dependencies.isStale(rebased, epoch));
+}
+
+TEST(TestDependency, BytesAcrossPages) {
+
+	yagi::DependencySet dependencies;
+	dependencies.addBytes(yagi::EpochTracker::LOADER_PAGE_SIZE - 1, 2);
+	ASSERT_EQ(dependencies.getPages().size(), 2);
+
+	// types are recorded once
+	ASSERT_TRUE(dependencies.addType("struct_a"));
+	ASSERT_FALSE(dependencies.addType("struct_a"));
+}
+
+TEST(TestDependency, RecoveredCalleeMakesStale) {
+
+	yagi::EpochTracker epochs;
+	yagi::PrototypeStore prototypes;
+	auto guess = yagi::RecoveredPrototype{
+		"__fastcall", "<type name=\"void\" metatype=\"void\"/>", {}, {}, false,
+		yagi::RecoveredPrototype::Source::CallSite, 1, { FUNC_ADDR }, {}, 0
+	};
+
+	// the caller consults its callee before anything is recovered
+	yagi::DependencySet dependencies;
+	dependencies.addPrototype(CALLEE_ADDR, prototypes.getVersion(CALLEE_ADDR));
+	auto epoch = epochs.getCurrent();
+
+	// its own guess doesn't outdate it
+	prototypes.publish(CALLEE_ADDR, guess, 0);
+	dependencies.updatePrototypes(prototypes);
+	ASSERT_FALSE(dependencies.isStale(epochs, epoch, &prototypes));
+
+	// the same caller voting again changes nothing
+	prototypes.publish(CALLEE_ADDR, guess, 0);
+	ASSERT_FALSE(dependencies.isStale(epochs, epoch, &prototypes));
+
+	// the callee is decompiled
+	auto recovered = guess;
+	recovered.source = yagi::RecoveredPrototype::Source::Decompilation;
+	recovered.callers.clear();
+	prototypes.publish(CALLEE_ADDR, recovered, 0);
+	ASSERT_TRUE(dependencies.isStale(epochs, epoch, &prototypes));
+	ASSERT_FALSE(dependencies.isStale(epochs, epoch));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "ebpfhelper.hh"
+#include "exception.hh"
+
+TEST(TestEbpfHelper, BuiltinHelpers) {
+
+	yagi::EbpfHelperTable table;
+	auto& helpers = table.getHelpers();
+
+	auto lookup = helpers.find(0x1);
+	ASSERT_NE(lookup, helpers.end());
+	ASSERT_EQ(lookup->second.name, "bpf_map_lookup_elem");
+	ASSERT_EQ(lookup->second.returnType, yagi::EbpfType::Ptr);
+	ASSERT_EQ(lookup->second.params.size(), 2);
+	ASSERT_EQ(lookup->second.params[1].name, "key");
+
+	auto printk = helpers.find(0x6);
+	ASSERT_NE(printk, helpers.end());
+	ASSERT_TRUE(printk->second.dotdotdot);
+}
+
+TEST(TestEbpfHelper, LoadOverrides) {
+
+	yagi::EbpfHelperTable table;
+	std::istringstream input(
+		"# id return name params\n"
+		"\n"
+		"0x1 int bpf_map_lookup_elem_custom ptr:map\n"
+		"1000 u64 bpf_new_helper str:fmt u32:size ...\n"
+	);
+	table.load(input, "test");
+
+	auto& helpers = table.getHelpers();
+	ASSERT_EQ(helpers.at(0x1).name, "bpf_map_lookup_elem_custom");
+	ASSERT_EQ(helpers.at(0x1).params.size(), 1);
+
+	auto& added = helpers.at(1000);
+	ASSERT_EQ(added.name, "bpf_new_helper");
+	ASSERT_EQ(added.returnType, yagi::EbpfType::U64);
+	ASSERT_EQ(added.params[0].type, yagi::EbpfType::Str);
+	ASSERT_TRUE(added.dotdotdot);
+}
+
+TEST(TestEbpfHelper, RejectInvalidLine) {
+
+	yagi::EbpfHelperTable table;
+	std::istringstream input(
+		"0x1 int bpf_map_lookup_elem_custom\n"
+		"0x2 pointer bpf_unknown_type\n"
+	);
+	ASSERT_THROW(table.load(input, "test"), yagi::InvalidEbpfHelper);
+
+	// the table is left unchanged
+	ASSERT_EQ(table.getHelpers().at(0x1).name, "bpf_map_lookup_elem");
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "mock_logger_test.h"
+
+TEST(TestLogger, DisabledLevelIsNotEvaluated) {
+
+	std::vector<std::string> messages;
+	MockLogger logger([&messages](const std::string& message) { messages.push_back(message); });
+
+	size_t evaluated = 0;
+	auto parameter = [&evaluated]() {
+		evaluated++;
+		return std::string("param");
+	};
+
+	// debug is dropped by default
+	YAGI_DEBUG(logger, "debug", parameter());
+	ASSERT_EQ(evaluated, 0);
+	ASSERT_TRUE(messages.empty());
+
+	if (!yagi::Logger::isCompiled(yagi::Logger::Level::Debug))
+	{
+		GTEST_SKIP();
+	}
+
+	logger.setLevel(yagi::Logger::Level::Debug);
+	YAGI_DEBUG(logger, "debug", parameter());
+	ASSERT_EQ(evaluated, 1);
+	ASSERT_EQ(messages.size(), 1);
+}
+
+TEST(TestLogger, FormatParameters) {
+
+	if (!yagi::Logger::isCompiled(yagi::Logger::Level::Info))
+	{
+		GTEST_SKIP();
+	}
+
+	std::string output;
+	MockLogger logger([&output](const std::string& message) { output = message; });
+
+	YAGI_INFO(logger, "Found symbol", std::string("main"), "at", 42);
+	ASSERT_EQ(output, "[Yagi] INFO :  Found symbol main at 42\n");
+}
@@ -5,6 +5,8 @@
 #include "mock_type_test.h"
 #include "base.hh"
 #include <functional>
+#include <map>
+#include <tuple>
 #include <optional>
 #include <memory>
 
@@ -15,6 +17,7 @@ class MockSymbolInfoFactory : public yagi::SymbolInfoFactory
 protected:
 	MockSymbolInfoFactoryFind m_findCallback;
 	MockSymbolInfoFactoryFindFunction m_findFunctionCallback;
+	std::map<uint64_t, size_t> m_lookups;
 
 public:
 	explicit MockSymbolInfoFactory(MockSymbolInfoFactoryFind findCallback, MockSymbolInfoFactoryFindFunction findFunctionCallback)
@@ -23,9 +26,16 @@ public:
 
 	std::optional<std::unique_ptr<yagi::SymbolInfo>> find(uint64_t ea) override
 	{
+		m_lookups[ea]++;
 		return m_findCallback(ea);
 	}
 
+	size_t getLookups(uint64_t ea) const
+	{
+		auto lookups = m_lookups.find(ea);
+		return lookups == m_lookups.end() ? 0 : lookups->second;
+	}
+
 	std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> find_function(uint64_t ea) override
 	{
 		return m_findFunctionCallback(ea);
@@ -78,8 +88,8 @@ public:
 class MockFunctionSymbolInfo : public yagi::FunctionSymbolInfo
 {
 public:
-	std::map<std::string, std::tuple<std::string, uint64_t>> m_name;
-	std::map<std::string, std::tuple<MockTypeInfo, uint64_t>> m_type;
+	std::map<std::tuple<uint64_t, std::string>, std::tuple<std::string, uint64_t>> m_name;
+	std::map<std::tuple<uint64_t, std::string>, std::tuple<MockTypeInfo, uint64_t>> m_type;
 
 	explicit MockFunctionSymbolInfo(std::unique_ptr<yagi::SymbolInfo> symbol)
 		: yagi::FunctionSymbolInfo{ std::move(symbol) }
@@ -93,10 +103,7 @@ public:
 
 	std::optional<std::string> findName(uint64_t pc, const std::string& space, uint64_t& offset) override
 	{
-		std::stringstream ss;
-		ss << yagi::to_hex(pc) << "." << space;
-
-		auto iter = m_name.find(ss.str());
+		auto iter = m_name.find(std::make_tuple(pc, space));
 		if (iter == m_name.end())
 		{
 			return std::nullopt;
@@ -108,16 +115,12 @@ public:
 
 	void saveName(const yagi::MemoryLocation& loc, const std::string& value)  override
 	{
-		std::stringstream ss;
-		ss << yagi::to_hex(loc.pc.front()) << "." << loc.spaceName;
-		m_name.emplace(ss.str(), std::make_tuple(value, loc.offset));
+		m_name.emplace(std::make_tuple(loc.pc.front(), loc.spaceName), std::make_tuple(value, loc.offset));
 	}
 
 	void saveType(const yagi::MemoryLocation& loc, const yagi::TypeInfo& newType) override
 	{
-		std::stringstream ss;
-		ss << yagi::to_hex(loc.pc.front()) << "." << loc.spaceName;
-		m_type.emplace(ss.str(), std::make_tuple(MockTypeInfo(newType.getSize(), newType.getName(), newType.isInt(), newType.isBool(), newType.isFloat(), newType.isVoid(), newType.isConst(), newType.isChar(), newType.isUnicode()), loc.offset));
+		m_type.emplace(std::make_tuple(loc.pc.front(), loc.spaceName), std::make_tuple(MockTypeInfo(newType.getSize(), newType.getName(), newType.isInt(), newType.isBool(), newType.isFloat(), newType.isVoid(), newType.isConst(), newType.isChar(), newType.isUnicode()), loc.offset));
 	}
 
 	bool clearType(const yagi::MemoryLocation& loc)
@@ -127,10 +130,7 @@ public:
 
 	std::optional<std::unique_ptr<yagi::TypeInfo>> findType(uint64_t pc, const std::string& from, uint64_t& offset) override
 	{
-		std::stringstream ss;
-		ss << yagi::to_hex(pc) << "." << from;
-
-		auto iter = m_type.find(ss.str());
+		auto iter = m_type.find(std::make_tuple(pc, from));
 		if (iter == m_type.end())
 		{
 			return std::nullopt;
@@ -138,6 +138,26 @@ public:
 		offset = std::get<1>(iter->second);
 		return std::make_unique<MockTypeInfo>(std::get<0>(iter->second));
 	}
+
+	std::vector<yagi::LocalName> getLocalNames() override
+	{
+		std::vector<yagi::LocalName> result;
+		for (auto& [key, value] : m_name)
+		{
+			result.push_back(yagi::LocalName{ std::get<1>(key), std::get<0>(key), std::get<1>(value), std::get<0>(value) });
+		}
+		return result;
+	}
+
+	std::vector<yagi::LocalType> getLocalTypes() override
+	{
+		std::vector<yagi::LocalType> result;
+		for (auto& [key, value] : m_type)
+		{
+			result.push_back(yagi::LocalType{ std::get<1>(key), std::get<0>(key), std::get<1>(value), std::make_unique<MockTypeInfo>(std::get<0>(value)) });
+		}
+		return result;
+	}
 };
 
 #endif
@@ -0,0 +1,174 @@
+#ifndef __YAGI_PAYLOAD_TEST__
+#define __YAGI_PAYLOAD_TEST__
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \brief	A function to decompile
+ *			Shared by unit tests and benchmarks
+ */
+struct Payload
+{
+	const char* name;
+	const char* sleighId;
+	const char* defaultCC;
+	uint64_t address;
+	uint64_t size;
+	const uint8_t* bytes;
+	size_t length;
+};
+
+/*!
+ * \brief	used by x86_payload_16bits_test.cc
+ */
+inline constexpr uint8_t X86_16_BYTES[] = {
+	0x55, 0x50, 0x53, 0x89, 0xE5, 0x8B, 0x76, 0x08, 0xAC, 0x3C, 0x00, 0x74, 0x09, 0xB4, 0x0E, 0xBB,
+	0x00, 0x00, 0xCD, 0x10, 0xEB, 0xF2, 0x89, 0xEC, 0x5B, 0x58, 0x5D, 0xC3, 0x55, 0x50, 0x53, 0x52,
+	0x89, 0xE5, 0xB4, 0x03, 0xBB, 0x00, 0x00, 0xCD, 0x10, 0xFE, 0xC6
+};
+
+/*!
+ * \brief	used by x86_payload_32bits_test.cc
+ */
+inline constexpr uint8_t X86_32_BYTES[] = {
+	0x53, 0x6A, 0x09, 0x8B, 0xD9, 0xE8, 0x3E, 0x58, 0x03, 0x00, 0x83, 0xC4, 0x04, 0x85, 0xC0, 0x74,
+	0x14, 0xC7, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC7, 0x40, 0x04, 0x01, 0x00, 0x00, 0x00, 0x83, 0xC0,
+	0x08, 0x88, 0x18, 0x5B, 0xC3, 0x33, 0xC0, 0x5B, 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC
+};
+
+/*!
+ * \brief	used by x86_payload_32bits_test_local_var.cc
+ */
+inline constexpr uint8_t X86_32_LOCAL_VAR_BYTES[] = {
+	0x56, 0x57, 0x8B, 0x7C, 0x24, 0x10, 0x57, 0xE8, 0xB2, 0x00, 0x00, 0x00, 0x8B, 0xF0, 0x8B, 0x44,
+	0x24, 0x10, 0x57, 0x50, 0x46, 0xE8, 0x92, 0x04, 0x00, 0x00, 0x83, 0xC4, 0x0C, 0x8B, 0xC6, 0x5F,
+	0x5E, 0xC3
+};
+
+/*!
+ * \brief	used by x86_payload_64bits_test.cc, print_test.cc,
+ *			profiler_test.cc and typedatabase_test.cc
+ */
+inline constexpr uint8_t X86_64_BYTES[] = {
+	0x48, 0x89, 0x54, 0x24, 0x10, 0x48, 0x89, 0x4C, 0x24, 0x08, 0x57, 0x48, 0x8B, 0x44, 0x24, 0x18,
+	0xC7, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x33, 0xC0, 0x5F, 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC
+};
+
+/*!
+ * \brief	used by x86_payload_64bits_test.cc,
+ *			a switch on the first parameter through a relative jump table
+ *			stored right after the code
+ */
+inline constexpr uint8_t X86_64_SWITCH_BYTES[] = {
+	0x83, 0xF9, 0x03, 0x77, 0x2A, 0x89, 0xC8, 0x48, 0x8D, 0x15, 0x26, 0x00, 0x00, 0x00, 0x48, 0x63,
+	0x04, 0x82, 0x48, 0x01, 0xD0, 0xFF, 0xE0, 0xB8, 0x0A, 0x00, 0x00, 0x00, 0xC3, 0xB8, 0x14, 0x00,
+	0x00, 0x00, 0xC3, 0xB8, 0x21, 0x00, 0x00, 0x00, 0xC3, 0xB8, 0x2F, 0x00, 0x00, 0x00, 0xC3, 0x31,
+	0xC0, 0xC3, 0x66, 0x90, 0xE3, 0xFF, 0xFF, 0xFF, 0xE9, 0xFF, 0xFF, 0xFF, 0xEF, 0xFF, 0xFF, 0xFF,
+	0xF5, 0xFF, 0xFF, 0xFF
+};
+
+/*!
+ * \brief	used by x86_payload_64bits_cfg.cc
+ */
+inline constexpr uint8_t X86_64_CFG_BYTES[] = {
+	0x48, 0x89, 0x5C, 0x24, 0x08, 0x48, 0x89, 0x6C, 0x24, 0x10, 0x48, 0x89, 0x74, 0x24, 0x18, 0x57,
+	0x48, 0x83, 0xEC, 0x20, 0x48, 0x8B, 0xE9, 0x49, 0x8B, 0xF9, 0x49, 0x8B, 0xC9, 0x41, 0x8B, 0xF0,
+	0x48, 0x8B, 0xDA, 0x48, 0xFF, 0x15, 0x86, 0xAB, 0x01, 0x00, 0x0F, 0x1F, 0x44, 0x00, 0x00, 0x85,
+	0xC0, 0x75, 0x2A, 0x48, 0xFF, 0x15, 0x2E, 0xAB, 0x01, 0x00, 0x0F, 0x1F, 0x44, 0x00, 0x00, 0x89,
+	0x05, 0xF3, 0xD0, 0x02, 0x00, 0x32, 0xC0, 0x48, 0x8B, 0x5C, 0x24, 0x30, 0x48, 0x8B, 0x6C, 0x24,
+	0x38, 0x48, 0x8B, 0x74, 0x24, 0x40, 0x48, 0x83, 0xC4, 0x20, 0x5F, 0xC3, 0xCC, 0x8B, 0xD6, 0x48,
+	0x8B, 0xCB, 0x48, 0x8B, 0xC5, 0xFF, 0x15, 0x9D, 0xB3, 0x01, 0x00, 0x85, 0xC0, 0x74, 0x0B, 0x83,
+	0x25, 0xC2, 0xD0, 0x02, 0x00, 0x00, 0xB0, 0x01, 0xEB, 0xCD, 0x48, 0x8B, 0xD3, 0x48, 0x8B, 0xCF,
+	0xEB, 0xA1, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC
+};
+
+/*!
+ * \brief	used by x86_payload_64bits_gcc_test.cc
+ */
+inline constexpr uint8_t X86_64_GCC_BYTES[] = {
+	0xF3, 0x0F, 0x1E, 0xFA, 0x8B, 0x05, 0x96, 0xA4, 0x01, 0x00, 0x41, 0x54, 0x41, 0x89, 0xFC, 0x85,
+	0xC0, 0x75, 0x35, 0x48, 0x8B, 0x05, 0x96, 0x58, 0x01, 0x00, 0x48, 0x8D, 0x15, 0x1E, 0x9A, 0x01,
+	0x00, 0x48, 0x39, 0xD0, 0x73, 0x3A, 0x48, 0x8D, 0x50, 0x01, 0x44, 0x88, 0x20, 0x44, 0x89, 0xE0,
+	0x41, 0x5C, 0x48, 0x89, 0x15, 0x77, 0x58, 0x01, 0x00, 0xC7, 0x05, 0x65, 0xA4, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xC3, 0x0F, 0x1F, 0x40, 0x00, 0xC7, 0x05, 0x4E, 0xA4, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xE8, 0xC9, 0xF7, 0xFE, 0xFF, 0xEB, 0xBA, 0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00,
+	0xE8, 0x3B, 0xFF, 0xFF, 0xFF, 0x48, 0x8B, 0x05, 0x44, 0x58, 0x01, 0x00, 0xEB, 0xB8, 0x66, 0x90,
+	0xF3, 0x0F, 0x1E, 0xFA, 0x41, 0x54, 0x55, 0x53, 0x48, 0x83, 0xEC, 0x10, 0x8B, 0x1D, 0x46, 0xA4
+};
+
+/*!
+ * \brief	used by ARM_payload_32bits_test.cc
+ */
+inline constexpr uint8_t ARM_32_BYTES[] = {
+	0x10, 0x30, 0x9F, 0xE5, 0x00, 0x20, 0xD3, 0xE5, 0x00, 0x00, 0x52, 0xE3, 0x01, 0x20, 0xA0, 0x03,
+	0x00, 0x20, 0xC3, 0x05, 0x1E, 0xFF, 0x2F, 0xE1, 0x7C, 0x08, 0x01, 0x00, 0x24, 0x00, 0x9F, 0xE5
+};
+
+/*!
+ * \brief	used by MIPS_payload_32bits_test.cc
+ */
+inline constexpr uint8_t MIPS_32_BYTES[] = {
+	0x3C, 0x1C, 0x00, 0x03, 0x27, 0x9C, 0x55, 0x68, 0x03, 0x99, 0xE0, 0x21, 0x27, 0xBD, 0xFF, 0xE0,
+	0x8F, 0x99, 0x81, 0x0C, 0xAF, 0xB0, 0x00, 0x18, 0x00, 0x80, 0x80, 0x25, 0x24, 0x04, 0x00, 0x04,
+	0xAF, 0xBC, 0x00, 0x10, 0xAF, 0xBF, 0x00, 0x1C, 0x04, 0x11, 0xD4, 0xEF, 0x02, 0x00, 0x28, 0x25,
+	0x1A, 0x00, 0x00, 0x09, 0x8F, 0xBF, 0x00, 0x1C, 0x00, 0x10, 0x20, 0x80, 0x24, 0x05, 0xFF, 0xFF,
+	0x00, 0x82, 0x20, 0x21, 0x00, 0x40, 0x18, 0x25, 0xAC, 0x65, 0x00, 0x00, 0x24, 0x63, 0x00, 0x04,
+	0x14, 0x64, 0xFF, 0xFD, 0x8F, 0xBF, 0x00, 0x1C, 0x8F, 0xB0, 0x00, 0x18, 0x03, 0xE0, 0x00, 0x08,
+	0x27, 0xBD, 0x00, 0x20, 0x3C, 0x1C, 0x00, 0x03
+};
+
+/*!
+ * \brief	used by PPC_payload_32bits_test.cc
+ */
+inline constexpr uint8_t PPC_32_BYTES[] = {
+	0x94, 0x21, 0xFF, 0xF0, 0x7C, 0x08, 0x02, 0xA6, 0x93, 0xE1, 0x00, 0x0C, 0x3F, 0xE0, 0x10, 0x01,
+	0x89, 0x3F, 0x30, 0x94, 0x90, 0x01, 0x00, 0x14, 0x2F, 0x89, 0x00, 0x00, 0x40, 0x9E, 0x00, 0x10,
+	0x4B, 0xFF, 0xFF, 0x61, 0x39, 0x20, 0x00, 0x01, 0x99, 0x3F, 0x30, 0x94, 0x80, 0x01, 0x00, 0x14,
+	0x83, 0xE1, 0x00, 0x0C, 0x38, 0x21, 0x00, 0x10, 0x7C, 0x08, 0x03, 0xA6, 0x4E, 0x80, 0x00, 0x20
+};
+
+/*!
+ * \brief	used by Sparc_payload_32bits_test.cc
+ */
+inline constexpr uint8_t SPARC_32_BYTES[] = {
+	0x9D, 0xE3, 0xBF, 0xA0, 0xF0, 0x27, 0xA0, 0x44, 0x40, 0x00, 0x45, 0x8B, 0x90, 0x16, 0x00, 0x00,
+	0x40, 0x00, 0x45, 0x83, 0x90, 0x10, 0x20, 0x01, 0x81, 0xC7, 0xE0, 0x08, 0x81, 0xE8, 0x00, 0x00,
+	0x81, 0xC7, 0xE0, 0x08
+};
+
+/*!
+ * \brief	used by 6502_payload_test.cc
+ */
+inline constexpr uint8_t MOS_6502_BYTES[] = {
+	0xA9, 0x00, 0x85, 0x4A, 0x85, 0x4C, 0xA9, 0x08, 0x85, 0x4B, 0xA9, 0x10, 0x85, 0x4D
+};
+
+/*!
+ * \brief	used by z80_payload_test.cc
+ */
+inline constexpr uint8_t Z80_BYTES[] = {
+	0x21, 0x00, 0x00, 0x2B, 0xCD, 0x08, 0x00, 0x76, 0x3E, 0x30, 0xD3, 0x01, 0x3E, 0x78, 0xD3, 0x01,
+	0x4C, 0xCD, 0x19, 0x00, 0x4D, 0xCD, 0x19, 0x00, 0xC9
+};
+
+/*!
+ * \brief	All payloads, at least one per sleigh id
+ */
+inline const Payload PAYLOADS[] = {
+	{ "x86_16", "x86:LE:16:Real Mode", "__fastcall", 0xaaaaaaaa, 28, X86_16_BYTES, sizeof(X86_16_BYTES) },
+	{ "x86_32", "x86:LE:32:default:windows", "__stdcall", 0xaaaaaaaa, 20, X86_32_BYTES, sizeof(X86_32_BYTES) },
+	{ "x86_32_local_var", "x86:LE:32:default:windows", "__stdcall", 0x401fa0, 34, X86_32_LOCAL_VAR_BYTES, sizeof(X86_32_LOCAL_VAR_BYTES) },
+	{ "x86_64", "x86:LE:64:default:windows", "__fastcall", 0xaaaaaaaa, 27, X86_64_BYTES, sizeof(X86_64_BYTES) },
+	{ "x86_64_switch", "x86:LE:64:default:windows", "__fastcall", 0xaaaaaaaa, 50, X86_64_SWITCH_BYTES, sizeof(X86_64_SWITCH_BYTES) },
+	{ "x86_64_cfg", "x86:LE:64:default:windows", "__fastcall", 0x140018A70, 90, X86_64_CFG_BYTES, sizeof(X86_64_CFG_BYTES) },
+	{ "x86_64_gcc", "x86:LE:64:default:gcc", "__stdcall", 0xaaaaaaaa, 20, X86_64_GCC_BYTES, sizeof(X86_64_GCC_BYTES) },
+	{ "arm_32", "ARM:LE:32:v7", "__stdcall", 0xaaaaaaaa, 20, ARM_32_BYTES, sizeof(ARM_32_BYTES) },
+	{ "mips_32", "MIPS:BE:32:default", "__stdcall", 0xaaaaaaaa, 20, MIPS_32_BYTES, sizeof(MIPS_32_BYTES) },
+	{ "ppc_32", "PowerPC:BE:32:default", "__stdcall", 0xaaaaaaaa, 20, PPC_32_BYTES, sizeof(PPC_32_BYTES) },
+	{ "sparc_32", "sparc:BE:32:default", "__stdcall", 0x000111A8, 20, SPARC_32_BYTES, sizeof(SPARC_32_BYTES) },
+	{ "6502", "6502:LE:16:default", "__stdcall", 0x0000EFD3, 14, MOS_6502_BYTES, sizeof(MOS_6502_BYTES) },
+	{ "z80", "z80:LE:16:default", "__fastcall", 0x00, 0x19, Z80_BYTES, sizeof(Z80_BYTES) }
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "yagiarchitecture.hh"
+#include "print.hh"
+#include "mock_logger_test.h"
+#include "mock_symbol_test.h"
+#include "mock_type_test.h"
+#include "mock_loader_test.h"
+#include "ghidra.hh"
+#include "payload_test.h"
+
+#define FUNC_ADDR 0xaaaaaaaa
+#define FUNC_SIZE 27
+#define FUNC_NAME "test"
+
+static const auto& PAYLOAD_1 = X86_64_BYTES;
+
+TEST(TestIdaPrint, ColorTags) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto arch = std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+			memcpy(ptr, PAYLOAD_1 + addr.getOffset() - FUNC_ADDR, size);
+		}),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+			if (ea == FUNC_ADDR)
+			{
+				return std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+				);
+			}
+			return std::nullopt;
+		},
+		[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+			return std::make_unique<MockFunctionSymbolInfo>(
+				std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					)
+				);
+		}),
+		std::make_unique<MockTypeInfoFactory>([](uint64_t) { return std::nullopt; }, [](const std::string&) { return std::nullopt; }),
+		"__fastcall"
+	);
+
+	DocumentStorage store;
+	arch->init(store);
+
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	arch->performActions(*func);
+
+	arch->setPrintLanguage("yagi-c-language");
+	ASSERT_NE(dynamic_cast<yagi::IdaPrint*>(arch->print), nullptr);
+
+	stringstream ss;
+	arch->print->setOutputStream(&ss);
+	arch->print->docFunction(func);
+
+	// every token is wrapped into an IDA color tag
+	auto output = ss.str();
+	ASSERT_NE(output.find("\x01\x20{\x02\x20"), std::string::npos);
+
+	std::string text;
+	for (size_t i = 0; i < output.size(); i++)
+	{
+		if (output[i] == '\x01' || output[i] == '\x02')
+		{
+			i++;
+			continue;
+		}
+		text += output[i];
+	}
+	ASSERT_NE(text.find("test(__uint64 param_1,int64_t param_2)"), std::string::npos);
+	ASSERT_NE(text.find("*(__uint32 *)(param_2 + 4) = 0;"), std::string::npos);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "yagiarchitecture.hh"
+#include "profiler.hh"
+#include "mock_logger_test.h"
+#include "mock_symbol_test.h"
+#include "mock_type_test.h"
+#include "mock_loader_test.h"
+#include "ghidra.hh"
+#include "payload_test.h"
+
+#define FUNC_ADDR 0xaaaaaaaa
+#define FUNC_SIZE 27
+#define FUNC_NAME "test"
+
+static const auto& PAYLOAD_1 = X86_64_BYTES;
+
+TEST(TestProfiler, ParseStatistics) {
+
+	yagi::Profiler profiler;
+	std::stringstream statistics(
+		"universal Tested=1 Apply=1\n"
+		"  deadcode Tested=12 Apply=3\n"
+		"  earlyremoval Tested=4 Applied=2\n"
+		"unused Tested=0 Applied=0\n"
+		"garbage\n"
+	);
+
+	profiler.begin("f1");
+	profiler.addStatistics("universal", statistics);
+	profiler.addStage("universal", std::chrono::nanoseconds(2000), 5);
+	profiler.end();
+
+	profiler.begin("f2");
+	profiler.addCounter("universal/deadcode", 8, 1);
+	profiler.end();
+
+	auto last = profiler.getLastReport().getSorted();
+	ASSERT_EQ(last.size(), 1);
+	ASSERT_EQ(last[0].tests, 8);
+
+	auto session = profiler.getSessionReport().getSorted();
+	ASSERT_EQ(profiler.getSessionReport().getFunctionCount(), 2);
+	ASSERT_EQ(session.size(), 4);
+	ASSERT_EQ(session[0].name, "universal");
+	ASSERT_EQ(session[0].changes, 5);
+	ASSERT_EQ(session[1].name, "universal/deadcode");
+	ASSERT_EQ(session[1].tests, 20);
+	ASSERT_EQ(session[1].applies, 4);
+	ASSERT_EQ(session[2].name, "universal/earlyremoval");
+	ASSERT_EQ(session[2].applies, 2);
+
+	std::stringstream json;
+	profiler.getSessionReport().toJson(json);
+	ASSERT_EQ(json.str().find("{\"functions\":2,\"entries\":[{\"name\":\"universal\",\"time_ns\":2000"), 0);
+}
+
+TEST(TestProfiler, ProfileDecompilation) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto arch = std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+			memcpy(ptr, PAYLOAD_1 + addr.getOffset() - FUNC_ADDR, size);
+			}),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+			if (ea == FUNC_ADDR)
+			{
+				return std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					);
+			}
+			return std::nullopt;
+		},
+		[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+			return std::make_unique<MockFunctionSymbolInfo>(
+				std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					)
+				);
+		}),
+		std::make_unique<MockTypeInfoFactory>([](uint64_t) { return std::nullopt; }, [](const std::string&) { return std::nullopt; }),
+		"__fastcall"
+	);
+
+	DocumentStorage store;
+	arch->init(store);
+	arch->setProfiling(true);
+
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	arch->performActions(*func);
+
+	ASSERT_NE(arch->getProfiler(), nullptr);
+	auto& report = arch->getProfiler()->getLastReport();
+	ASSERT_EQ(report.getFunctionCount(), 1);
+	ASSERT_EQ(arch->getProfiler()->getLastFunction(), FUNC_NAME);
+
+	std::stringstream text;
+	report.toText(text);
+	ASSERT_NE(text.str().find("universal.start"), std::string::npos);
+	ASSERT_NE(text.str().find("universal/"), std::string::npos);
+
+	// actions and rules of a built architecture print different counter names
+	std::stringstream statistics;
+	arch->allacts.getCurrent()->printStatistics(statistics);
+	ASSERT_NE(statistics.str().find(" Apply="), std::string::npos);
+	ASSERT_NE(statistics.str().find(" Applied="), std::string::npos);
+
+	yagi::Profiler parsed;
+	parsed.begin(FUNC_NAME);
+	parsed.addStatistics("universal", statistics);
+	parsed.end();
+
+	std::stringstream parsedText;
+	parsed.getLastReport().toText(parsedText);
+	ASSERT_NE(parsedText.str().find("universal/deadcode"), std::string::npos);
+
+	arch->setProfiling(false);
+	ASSERT_EQ(arch->getProfiler(), nullptr);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "prototypestore.hh"
+
+#define FUNC_ADDR 0xaaaaaaaa
+#define CALLER_ADDR 0xbbbbbbbb
+
+static yagi::RecoveredPrototype makePrototype(yagi::RecoveredPrototype::Source source, size_t inputs, uint64_t epoch, uint64_t caller = CALLER_ADDR)
+{
+	return yagi::RecoveredPrototype{
+		"__fastcall",
+		"<type name=\"void\" metatype=\"void\"/>",
+		std::vector<std::string>(inputs, "<type name=\"int4\" size=\"4\" metatype=\"int\"/>"),
+		std::vector<std::string>(inputs, "param"),
+		false,
+		source,
+		1,
+		source == yagi::RecoveredPrototype::Source::CallSite ? std::set<uint64_t>{ caller } : std::set<uint64_t>{},
+		{},
+		epoch
+	};
+}
+
+TEST(TestPrototypeStore, DecompilationBeatsCallSites) {
+
+	yagi::PrototypeStore store;
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::Decompilation, 2, 0), 0);
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 3, 0), 0);
+
+	auto prototype = store.find(FUNC_ADDR, 0);
+	ASSERT_TRUE(prototype.has_value());
+	ASSERT_EQ(prototype.value().source, yagi::RecoveredPrototype::Source::Decompilation);
+	ASSERT_EQ(prototype.value().inputs.size(), 2);
+}
+
+TEST(TestPrototypeStore, CallSitesVote) {
+
+	yagi::PrototypeStore store;
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 2, 0, CALLER_ADDR), 0);
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 2, 0, CALLER_ADDR + 1), 0);
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 1, 0, CALLER_ADDR + 2), 0);
+
+	// two call sites agree against one
+	auto prototype = store.find(FUNC_ADDR, 0);
+	ASSERT_EQ(prototype.value().inputs.size(), 2);
+	ASSERT_EQ(prototype.value().confidence, 1);
+
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 1, 0, CALLER_ADDR + 3), 0);
+	ASSERT_EQ(store.find(FUNC_ADDR, 0).value().inputs.size(), 1);
+}
+
+TEST(TestPrototypeStore, CallerVotesOnce) {
+
+	yagi::PrototypeStore store;
+
+	// two calls of the same caller, then the caller is decompiled again
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 2, 0), 0);
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 2, 0), 0);
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 2, 1), 0);
+
+	auto prototype = store.find(FUNC_ADDR, 0);
+	ASSERT_EQ(prototype.value().confidence, 1);
+	ASSERT_LT(prototype.value().confidence, yagi::RecoveredPrototype::LOCK_CONFIDENCE);
+
+	// another caller agrees
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 2, 1, CALLER_ADDR + 1), 0);
+	ASSERT_EQ(store.find(FUNC_ADDR, 0).value().confidence, yagi::RecoveredPrototype::LOCK_CONFIDENCE);
+}
+
+TEST(TestPrototypeStore, StalePrototypeIsReplaced) {
+
+	yagi::PrototypeStore store;
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::Decompilation, 2, 1), 0);
+
+	// the function changed in the backend at epoch 2
+	ASSERT_FALSE(store.find(FUNC_ADDR, 2).has_value());
+
+	store.publish(FUNC_ADDR, makePrototype(yagi::RecoveredPrototype::Source::CallSite, 3, 3), 2);
+	auto prototype = store.find(FUNC_ADDR, 2);
+	ASSERT_TRUE(prototype.has_value());
+	ASSERT_EQ(prototype.value().source, yagi::RecoveredPrototype::Source::CallSite);
+	ASSERT_EQ(prototype.value().inputs.size(), 3);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include "scheduler.hh"
+
+TEST(TestScheduler, ComponentsCalleesFirst) {
+
+	// 1 -> 2 <-> 3 -> 4, 5 alone
+	yagi::CallGraph graph;
+	graph.addCall(1, 2);
+	graph.addCall(2, 3);
+	graph.addCall(3, 2);
+	graph.addCall(3, 4);
+	graph.addFunction(5);
+
+	auto components = graph.getComponents();
+	ASSERT_EQ(components.size(), 4);
+
+	std::map<uint64_t, size_t> order;
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		for (auto ea : components[i])
+		{
+			order[ea] = i;
+		}
+	}
+
+	ASSERT_EQ(order.at(2), order.at(3));
+	ASSERT_LT(order.at(4), order.at(3));
+	ASSERT_LT(order.at(2), order.at(1));
+}
+
+TEST(TestScheduler, RunAfterCallees) {
+
+	// a long chain and a wide fan out
+	yagi::CallGraph graph;
+	for (uint64_t ea = 1; ea < 1000; ea++)
+	{
+		graph.addCall(ea + 1, ea);
+		graph.addCall(0, 2000 + ea);
+	}
+
+	std::mutex mutex;
+	std::map<uint64_t, size_t> done;
+	yagi::CallGraphScheduler(4).run(graph, [&](const std::vector<uint64_t>& component) {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto ea : component)
+		{
+			for (auto callee : graph.getCallees(ea))
+			{
+				ASSERT_EQ(done.count(callee), 1);
+			}
+		}
+		for (auto ea : component)
+		{
+			done[ea] = done.size();
+		}
+	});
+
+	ASSERT_EQ(done.size(), graph.size());
+}
+
+TEST(TestScheduler, RaiseJobError) {
+
+	yagi::CallGraph graph;
+	for (uint64_t ea = 0; ea < 100; ea++)
+	{
+		graph.addFunction(ea);
+	}
+
+	ASSERT_THROW(yagi::CallGraphScheduler(4).run(graph, [](const std::vector<uint64_t>& component) {
+		if (component.front() == 42)
+		{
+			throw std::runtime_error("job failed");
+		}
+	}), std::runtime_error);
+}
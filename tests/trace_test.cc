@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "yagiarchitecture.hh"
+#include "trace.hh"
+#include "exception.hh"
+#include "mock_logger_test.h"
+#include "mock_symbol_test.h"
+#include "mock_type_test.h"
+#include "mock_loader_test.h"
+#include "ghidra.hh"
+#include "payload_test.h"
+
+#define FUNC_ADDR 0xaaaaaaaa
+#define FUNC_SIZE 27
+#define FUNC_NAME "test"
+
+static const auto& PAYLOAD_1 = X86_64_BYTES;
+
+static std::string decompile(std::unique_ptr<yagi::YagiArchitecture> arch)
+{
+	DocumentStorage store;
+	arch->init(store);
+
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	if (func == nullptr)
+	{
+		return "";
+	}
+	arch->performActions(*func);
+
+	arch->setPrintLanguage("c-language");
+
+	stringstream ss;
+	arch->print->setOutputStream(&ss);
+	arch->print->docFunction(func);
+	return ss.str();
+}
+
+TEST(TestTrace, RecordAndReplay) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto recorder = std::make_shared<yagi::TraceRecorder>();
+	recorder->setArchitecture("x86:LE:64:default:windows", "__fastcall");
+
+	auto recorded = decompile(std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<yagi::RecordingLoaderFactory>(
+			std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+				memcpy(ptr, PAYLOAD_1 + addr.getOffset() - FUNC_ADDR, size);
+			}),
+			recorder
+		),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<yagi::RecordingSymbolInfoFactory>(
+			std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+				if (ea == FUNC_ADDR)
+				{
+					return std::make_unique<MockSymbolInfo>(
+						FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					);
+				}
+				return std::nullopt;
+			},
+			[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+				return std::make_unique<MockFunctionSymbolInfo>(
+					std::make_unique<MockSymbolInfo>(
+						FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					)
+				);
+			}),
+			recorder
+		),
+		std::make_unique<yagi::RecordingTypeInfoFactory>(
+			std::make_unique<MockTypeInfoFactory>(
+				[](uint64_t ea) -> std::optional<std::unique_ptr<yagi::TypeInfo>> {
+					if (ea != FUNC_ADDR)
+					{
+						return std::nullopt;
+					}
+					return std::make_unique<MockTypeInfo>(
+						8, "functionName",
+						MockFuncInfo(
+							false, "__fastcall",
+							std::vector<MockTypeInfo>{},
+							std::vector<std::string>{}
+						)
+					);
+				},
+				[](const std::string&) {
+					return std::nullopt;
+				}
+			),
+			recorder
+		),
+		"__fastcall"
+	));
+	ASSERT_STREQ(recorded.c_str(), "\nvoid test(void)\n\n{\n  int64_t in_RDX;\n  \n  *(__uint32 *)(in_RDX + 4) = 0;\n  return;\n}\n");
+
+	auto path = (std::filesystem::temp_directory_path() / "yagi_replay.ytrc").string();
+	recorder->save(path);
+
+	// no mock is used anymore, every answer comes from the trace
+	auto replay = yagi::TraceReplay::load(path);
+	ASSERT_EQ(replay->getContent().sleighId, "x86:LE:64:default:windows");
+	ASSERT_EQ(replay->getContent().defaultCC, "__fastcall");
+
+	auto replayed = decompile(std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		replay->getContent().sleighId,
+		std::make_unique<yagi::ReplayLoaderFactory>(replay),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<yagi::ReplaySymbolInfoFactory>(replay),
+		std::make_unique<yagi::ReplayTypeInfoFactory>(replay),
+		replay->getContent().defaultCC
+	));
+	ASSERT_EQ(replayed, recorded);
+
+	replay.reset();
+	std::filesystem::remove(path);
+}
+
+TEST(TestTrace, RejectInvalidFile) {
+
+	auto path = (std::filesystem::temp_directory_path() / "yagi_invalid.ytrc").string();
+	std::ofstream(path, std::ios::binary) << std::string(128, 'x');
+
+	ASSERT_THROW(yagi::TraceReplay::load(path), yagi::InvalidTrace);
+	std::filesystem::remove(path);
+}
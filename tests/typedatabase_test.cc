@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "yagiarchitecture.hh"
+#include "typedatabase.hh"
+#include "exception.hh"
+#include "mock_logger_test.h"
+#include "mock_symbol_test.h"
+#include "mock_type_test.h"
+#include "mock_loader_test.h"
+#include "ghidra.hh"
+#include "payload_test.h"
+
+#define FUNC_ADDR 0xaaaaaaaa
+#define FUNC_SIZE 27
+#define FUNC_NAME "test"
+
+static const auto& PAYLOAD_1 = X86_64_BYTES;
+
+static std::string writeDatabase(const std::string& fileName)
+{
+	auto path = (std::filesystem::temp_directory_path() / fileName).string();
+	MockTypeInfo function(
+		8, "functionName",
+		MockFuncInfo(
+			true, "__fastcall",
+			std::vector<MockTypeInfo>{
+				MockTypeInfo(8, "testUint8", true, false, false, false, false, false, false),
+				MockTypeInfo(1, "testBool", false, true, false, false, true, false, false)
+			},
+			std::vector<std::string>{
+				"flag"
+			}
+		)
+	);
+
+	yagi::TypeDatabaseWriter writer;
+	writer.addName("testUint8", MockTypeInfo(8, "testUint8", true, false, false, false, false, false, false));
+	writer.addAddress(FUNC_ADDR, function);
+	writer.save(path);
+	return path;
+}
+
+TEST(TestTypeDatabase, RoundTrip) {
+
+	auto path = writeDatabase("yagi_roundtrip.ytdb");
+	{
+		yagi::FileTypeInfoFactory factory(yagi::TypeDatabase::load(path));
+
+		ASSERT_EQ(factory.getTypeNames(), std::vector<std::string>{ "testUint8" });
+		ASSERT_FALSE(factory.build("unknown").has_value());
+		ASSERT_FALSE(factory.build(uint64_t(FUNC_ADDR + 1)).has_value());
+
+		auto integer = factory.build("testUint8");
+		ASSERT_TRUE(integer.has_value());
+		ASSERT_EQ(integer.value()->getSize(), 8);
+		ASSERT_TRUE(integer.value()->isInt());
+		ASSERT_FALSE(integer.value()->toFunc().has_value());
+
+		auto function = factory.build(uint64_t(FUNC_ADDR));
+		ASSERT_TRUE(function.has_value());
+		ASSERT_EQ(function.value()->getName(), "functionName");
+
+		auto funcInfo = function.value()->toFunc();
+		ASSERT_TRUE(funcInfo.has_value());
+		ASSERT_TRUE(funcInfo.value()->isDotDotDot());
+		ASSERT_EQ(funcInfo.value()->getCallingConv(), "__fastcall");
+		ASSERT_EQ(funcInfo.value()->getFuncParamName(), std::vector<std::string>{ "flag" });
+
+		auto prototype = funcInfo.value()->getFuncPrototype();
+		ASSERT_EQ(prototype.size(), 2);
+		ASSERT_EQ(prototype[0]->getName(), "testUint8");
+		ASSERT_TRUE(prototype[1]->isBool());
+		ASSERT_TRUE(prototype[1]->isConst());
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(TestTypeDatabase, NameDiffersFromTypeName) {
+
+	auto path = (std::filesystem::temp_directory_path() / "yagi_alias.ytdb").string();
+	{
+		yagi::TypeDatabaseWriter writer;
+		writer.addName("aliasUint8", MockTypeInfo(8, "testUint8", true, false, false, false, false, false, false));
+		writer.save(path);
+	}
+	{
+		yagi::FileTypeInfoFactory factory(yagi::TypeDatabase::load(path));
+		ASSERT_EQ(factory.getTypeNames(), std::vector<std::string>{ "aliasUint8" });
+
+		auto integer = factory.build("aliasUint8");
+		ASSERT_TRUE(integer.has_value());
+		ASSERT_EQ(integer.value()->getName(), "testUint8");
+		ASSERT_FALSE(factory.build("testUint8").has_value());
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(TestTypeDatabase, RejectInvalidFile) {
+
+	auto path = (std::filesystem::temp_directory_path() / "yagi_invalid.ytdb").string();
+	std::ofstream(path, std::ios::binary) << std::string(128, 'x');
+
+	ASSERT_THROW(yagi::TypeDatabase::load(path), yagi::InvalidTypeDatabase);
+	std::filesystem::remove(path);
+}
+
+TEST(TestTypeDatabase, SnapshotKeepsBackendKeys) {
+
+	yagi::TypeDatabaseWriter writer;
+	auto index = writer.add(MockTypeInfo(
+		8, "functionName",
+		MockFuncInfo(
+			false, "__fastcall",
+			std::vector<MockTypeInfo>{
+				MockTypeInfo(8, "testUint8", true, false, false, false, false, false, false)
+			},
+			std::vector<std::string>{}
+		)
+	));
+
+	// the type keeps the snapshot alive
+	yagi::FileTypeInfo function(yagi::TypeDatabase::snapshot(writer), index);
+	ASSERT_EQ(function.getKey(), "functionName");
+
+	auto prototype = function.toFunc().value()->getFuncPrototype();
+	ASSERT_EQ(prototype.size(), 1);
+	ASSERT_EQ(prototype[0]->getKey(), "testUint8");
+}
+
+TEST(TestTypeDatabase, DecompileWithTypeDatabase) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto path = writeDatabase("yagi_decompile.ytdb");
+	auto arch = std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+			memcpy(ptr, PAYLOAD_1 + addr.getOffset() - FUNC_ADDR, size);
+			}),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+			if (ea == FUNC_ADDR)
+			{
+				return std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					);
+			}
+			return std::nullopt;
+		},
+		[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+			return std::make_unique<MockFunctionSymbolInfo>(
+				std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					)
+				);
+		}),
+		std::make_unique<yagi::FileTypeInfoFactory>(yagi::TypeDatabase::load(path)),
+		"__fastcall"
+	);
+
+	DocumentStorage store;
+	arch->init(store);
+
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	arch->performActions(*func);
+
+	arch->setPrintLanguage("c-language");
+
+	stringstream ss;
+	arch->print->setOutputStream(&ss);
+	//print as C
+	arch->print->docFunction(func);
+
+	ASSERT_NE(ss.str().find("\ntestUint8 test("), std::string::npos);
+
+	arch.reset();
+	std::filesystem::remove(path);
+}
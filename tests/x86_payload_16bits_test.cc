@@ -5,19 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 28
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD_1[] = {
-	0x55, 0x50, 0x53, 0x89, 0xE5, 0x8B, 0x76, 0x08,
-	0xAC, 0x3C, 0x00, 0x74, 0x09, 0xB4, 0x0E, 0xBB,
-	0x00, 0x00, 0xCD, 0x10, 0xEB, 0xF2, 0x89, 0xEC,
-	0x5B, 0x58, 0x5D, 0xC3, 0x55, 0x50, 0x53, 0x52,
-	0x89, 0xE5, 0xB4, 0x03, 0xBB, 0x00, 0x00, 0xCD,
-	0x10, 0xFE, 0xC6
-};
+static const auto& PAYLOAD_1 = X86_16_BYTES;
 
 
 // Demonstrate some basic assertions.
@@ -5,19 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 20
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0x53, 0x6A, 0x09, 0x8B, 0xD9, 0xE8, 0x3E, 0x58, 
-	0x03, 0x00, 0x83, 0xC4, 0x04, 0x85, 0xC0, 0x74,
-	0x14, 0xC7, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC7, 
-	0x40, 0x04, 0x01, 0x00, 0x00, 0x00, 0x83, 0xC0,
-	0x08, 0x88, 0x18, 0x5B, 0xC3, 0x33, 0xC0, 0x5B, 
-	0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC
-};
+static const auto& PAYLOAD = X86_32_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_x86_32, DecompileWithoutType) {
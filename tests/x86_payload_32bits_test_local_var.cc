@@ -5,16 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0x401fa0
 #define FUNC_SIZE 34
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0x56, 0x57, 0x8B, 0x7C, 0x24, 0x10, 0x57, 0xE8, 0xB2, 0x00, 0x00, 0x00, 0x8B, 0xF0, 0x8B, 0x44,
-	0x24, 0x10, 0x57, 0x50, 0x46, 0xE8, 0x92, 0x04, 0x00, 0x00, 0x83, 0xC4, 0x0C, 0x8B, 0xC6, 0x5F,
-	0x5E, 0xC3,
-};
+static const auto& PAYLOAD = X86_32_LOCAL_VAR_BYTES;
 
 
 TEST(TestDecompilationPayload_x86_32, RenameLocalRegVar) {
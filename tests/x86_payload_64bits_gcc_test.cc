@@ -5,21 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 20
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD[] = {
-	0xF3, 0x0F, 0x1E, 0xFA, 0x8B, 0x05, 0x96, 0xA4, 0x01, 0x00, 0x41, 0x54, 0x41, 0x89, 0xFC, 0x85,
-	0xC0, 0x75, 0x35, 0x48, 0x8B, 0x05, 0x96, 0x58, 0x01, 0x00, 0x48, 0x8D, 0x15, 0x1E, 0x9A, 0x01,
-	0x00, 0x48, 0x39, 0xD0, 0x73, 0x3A, 0x48, 0x8D, 0x50, 0x01, 0x44, 0x88, 0x20, 0x44, 0x89, 0xE0,
-	0x41, 0x5C, 0x48, 0x89, 0x15, 0x77, 0x58, 0x01, 0x00, 0xC7, 0x05, 0x65, 0xA4, 0x01, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0xC3, 0x0F, 0x1F, 0x40, 0x00, 0xC7, 0x05, 0x4E, 0xA4, 0x01, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0xE8, 0xC9, 0xF7, 0xFE, 0xFF, 0xEB, 0xBA, 0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00,
-	0xE8, 0x3B, 0xFF, 0xFF, 0xFF, 0x48, 0x8B, 0x05, 0x44, 0x58, 0x01, 0x00, 0xEB, 0xB8, 0x66, 0x90,
-	0xF3, 0x0F, 0x1E, 0xFA, 0x41, 0x54, 0x55, 0x53, 0x48, 0x83, 0xEC, 0x10, 0x8B, 0x1D, 0x46, 0xA4
-};
+static const auto& PAYLOAD = X86_64_GCC_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_x86_64_gcc, DecompileWithoutType) {
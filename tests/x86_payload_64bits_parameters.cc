@@ -1,21 +1,19 @@
 #include <gtest/gtest.h>
 #include "yagiarchitecture.hh"
+#include "typemanager.hh"
+#include "prototypestore.hh"
 #include "mock_logger_test.h"
 #include "mock_symbol_test.h"
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 27
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD_1[] = {
-	0x48, 0x89, 0x54, 0x24, 0x10, 0x48, 0x89, 0x4C,
-	0x24, 0x08, 0x57, 0x48, 0x8B, 0x44, 0x24, 0x18,
-	0xC7, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x33,
-	0xC0, 0x5F, 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC
-};
+static const auto& PAYLOAD_1 = X86_64_BYTES;
 
 TEST(TestDecompilationPayload_x86_64, DecompileWithFunctionReturnType) {
 
@@ -235,4 +233,72 @@ TEST(TestDecompilationPayload_x86_64, DecompileWithFunctionReturnTypeAndParamete
 	arch->print->docFunction(func);
 
 	ASSERT_STREQ(ss.str().c_str(), "\ntestUint8 test(testUint864 test_param_1,testUint864 test_param_2)\n\n{\n  *(__uint32 *)(test_param_2 + 4) = 0;\n  return 0;\n}\n");
-}
\ No newline at end of file
+}
+
+TEST(TestDecompilationPayload_x86_64, CallSitePrototypeIsLockedOnceConfirmed) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto arch = std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+			memcpy(ptr, PAYLOAD_1 + addr.getOffset() - FUNC_ADDR, size);
+		}),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+			if (ea == FUNC_ADDR)
+			{
+				return std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+				);
+			}
+			return std::nullopt;
+		},
+		[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+			return std::make_unique<MockFunctionSymbolInfo>(
+				std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					)
+				);
+		}),
+		std::make_unique<MockTypeInfoFactory>([](uint64_t) { return std::nullopt; }, [](const std::string&) { return std::nullopt; }),
+		"__fastcall"
+	);
+
+	auto prototypes = std::make_shared<yagi::PrototypeStore>();
+	arch->setPrototypeStore(prototypes);
+
+	DocumentStorage store;
+	arch->init(store);
+
+	auto guess = yagi::RecoveredPrototype{
+		"__fastcall",
+		"<type name=\"void\" metatype=\"void\"/>",
+		std::vector<std::string>(2, "<type name=\"int8\" size=\"8\" metatype=\"int\"/>"),
+		std::vector<std::string>{ "param_1", "param_2" },
+		false,
+		yagi::RecoveredPrototype::Source::CallSite,
+		1,
+		{ 0x1000 },
+		{},
+		arch->getEpochs().getCurrent()
+	};
+	prototypes->publish(FUNC_ADDR, guess, 0);
+
+	// a single call site is only a hint
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	ASSERT_NE(func, nullptr);
+	ASSERT_FALSE(func->getFuncProto().isInputLocked());
+	ASSERT_FALSE(func->getFuncProto().isOutputLocked());
+
+	// another caller agrees
+	guess.callers = { 0x2000 };
+	prototypes->publish(FUNC_ADDR, guess, 0);
+	static_cast<yagi::TypeManager*>(arch->types)->update(*func);
+	ASSERT_TRUE(func->getFuncProto().isInputLocked());
+	ASSERT_EQ(func->getFuncProto().numParams(), 2);
+}
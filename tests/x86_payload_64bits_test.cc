@@ -1,21 +1,18 @@
 #include <gtest/gtest.h>
 #include "yagiarchitecture.hh"
+#include "profiler.hh"
 #include "mock_logger_test.h"
 #include "mock_symbol_test.h"
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0xaaaaaaaa
 #define FUNC_SIZE 27
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD_1[] = {
-	0x48, 0x89, 0x54, 0x24, 0x10, 0x48, 0x89, 0x4C,
-	0x24, 0x08, 0x57, 0x48, 0x8B, 0x44, 0x24, 0x18,
-	0xC7, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x33,
-	0xC0, 0x5F, 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC
-};
+static const auto& PAYLOAD_1 = X86_64_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_x86_64, UnableToFindFunctionSymbol) {
@@ -166,4 +163,142 @@ TEST(TestDecompilationPayload_x86_64, DecompileWithFunctionType) {
 	arch->print->docFunction(func);
 
 	ASSERT_STREQ(ss.str().c_str(), "\nvoid test(void)\n\n{\n  int64_t in_RDX;\n  \n  *(__uint32 *)(in_RDX + 4) = 0;\n  return;\n}\n");
-}
\ No newline at end of file
+}
+
+TEST(TestDecompilationPayload_x86_64, DecompilePreview) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto arch = std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+			memcpy(ptr, PAYLOAD_1 + addr.getOffset() - FUNC_ADDR, size);
+		}),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+			if (ea == FUNC_ADDR)
+			{
+				return std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+				);
+			}
+			return std::nullopt;
+		},
+		[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+			return std::make_unique<MockFunctionSymbolInfo>(
+				std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, FUNC_SIZE, true, false, false, false
+					)
+				);
+		}),
+		std::make_unique<MockTypeInfoFactory>([](uint64_t) { return std::nullopt; }, [](const std::string&) { return std::nullopt; }),
+		"__fastcall"
+	);
+
+	DocumentStorage store;
+	arch->init(store);
+	arch->setActionProfile(yagi::Decompiler::Profile::Preview);
+
+	// removed groups are not part of the preview action
+	ASSERT_EQ(arch->allacts.getCurrentName(), "preview");
+	ASSERT_EQ(arch->allacts.getCurrent()->getSubRule("deindirect"), nullptr);
+	ASSERT_EQ(arch->allacts.getCurrent()->getSubRule("subvar_and"), nullptr);
+	ASSERT_EQ(arch->allacts.getCurrent()->getSubRule("doubleload"), nullptr);
+	ASSERT_EQ(arch->allacts.getCurrent()->getSubRule("splitcopy"), nullptr);
+
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	arch->performActions(*func);
+
+	arch->setPrintLanguage("c-language");
+
+	stringstream ss;
+	arch->print->setOutputStream(&ss);
+	//print as C
+	arch->print->docFunction(func);
+
+	// parameters and the store are still recovered
+	ASSERT_NE(ss.str().find("test(__uint64 param_1,int64_t param_2)"), std::string::npos);
+	ASSERT_NE(ss.str().find("*(__uint32 *)(param_2 + 4) = 0;"), std::string::npos);
+}
+
+TEST(TestDecompilationPayload_x86_64, DecompilePreviewSwitch) {
+
+	yagi::ghidra::init(std::getenv("GHIDRADIRTEST"));
+
+	auto arch = std::make_unique<yagi::YagiArchitecture>(
+		"test",
+		"x86:LE:64:default:windows",
+		std::make_unique<MockLoaderFactory>([](uint1* ptr, int4 size, const Address& addr) {
+			memset(ptr, 0, size);
+			auto offset = addr.getOffset() - FUNC_ADDR;
+			if (addr.getOffset() >= FUNC_ADDR && offset < sizeof(X86_64_SWITCH_BYTES))
+			{
+				memcpy(ptr, X86_64_SWITCH_BYTES + offset, std::min<size_t>(size, sizeof(X86_64_SWITCH_BYTES) - offset));
+			}
+		}),
+		std::make_unique<MockLogger>([](const std::string&) {}),
+		std::make_unique<MockSymbolInfoFactory>([](uint64_t ea) -> std::optional<std::unique_ptr<yagi::SymbolInfo>> {
+			if (ea == FUNC_ADDR)
+			{
+				return std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, 50, true, false, false, false
+				);
+			}
+			return std::nullopt;
+		},
+		[](uint64_t func_addr) -> std::optional<std::unique_ptr<yagi::FunctionSymbolInfo>> {
+			return std::make_unique<MockFunctionSymbolInfo>(
+				std::make_unique<MockSymbolInfo>(
+					FUNC_ADDR, FUNC_NAME, 50, true, false, false, false
+					)
+				);
+		}),
+		std::make_unique<MockTypeInfoFactory>([](uint64_t) { return std::nullopt; }, [](const std::string&) { return std::nullopt; }),
+		"__fastcall"
+	);
+
+	DocumentStorage store;
+	arch->init(store);
+	arch->setProfiling(true);
+
+	// rules tried by a decompilation, the work the preview profile saves
+	auto countTests = [&arch]() {
+		uint64_t tests = 0;
+		for (auto& entry : arch->getProfiler()->getLastReport().getSorted())
+		{
+			if (entry.name.find("universal/") == 0)
+			{
+				tests += entry.tests;
+			}
+		}
+		return tests;
+	};
+
+	auto scope = arch->symboltab->getGlobalScope();
+	auto func = scope->findFunction(
+		Address(arch->getDefaultCodeSpace(), FUNC_ADDR)
+	);
+	arch->setActionProfile(yagi::Decompiler::Profile::Full);
+	arch->performActions(*func);
+	auto fullTests = countTests();
+
+	arch->clearAnalysis(func);
+	arch->setActionProfile(yagi::Decompiler::Profile::Preview);
+	arch->performActions(*func);
+	ASSERT_LT(countTests(), fullTests);
+
+	// the jump table is recovered and normalized by the preview profile
+	ASSERT_EQ(func->numJumpTables(), 1);
+
+	arch->setPrintLanguage("c-language");
+
+	stringstream ss;
+	arch->print->setOutputStream(&ss);
+	arch->print->docFunction(func);
+
+	ASSERT_NE(ss.str().find("switch"), std::string::npos);
+}
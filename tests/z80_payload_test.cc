@@ -5,17 +5,13 @@
 #include "mock_type_test.h"
 #include "mock_loader_test.h"
 #include "ghidra.hh"
+#include "payload_test.h"
 
 #define FUNC_ADDR 0x00
 #define FUNC_SIZE 0x19
 #define FUNC_NAME "test"
 
-static const uint8_t PAYLOAD_1[] = {
-	0x21, 0x00, 0x00, 0x2B, 0xCD, 0x08, 0x00, 0x76, 
-	0x3E, 0x30, 0xD3, 0x01, 0x3E, 0x78, 0xD3, 0x01,
-	0x4C, 0xCD, 0x19, 0x00, 0x4D, 0xCD, 0x19, 0x00, 
-	0xC9
-};
+static const auto& PAYLOAD_1 = Z80_BYTES;
 
 // Demonstrate some basic assertions.
 TEST(TestDecompilationPayload_z80, DecompileWithoutType) {
@@ -0,0 +1,59 @@
+#ifndef __YAGI_CALLGRAPH__
+#define __YAGI_CALLGRAPH__
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Calls between functions of the program
+	 *			Functions are identified by their entry point
+	 */
+	class CallGraph
+	{
+	protected:
+		/*!
+		 * \brief	callees of each function
+		 */
+		std::map<uint64_t, std::set<uint64_t>> m_callees;
+
+	public:
+		/*!
+		 * \brief	Add a function without call
+		 * \param	ea	entry point of the function
+		 */
+		void addFunction(uint64_t ea);
+
+		/*!
+		 * \brief	Add a call, both functions are added if needed
+		 * \param	caller	entry point of the calling function
+		 * \param	callee	entry point of the called function
+		 */
+		void addCall(uint64_t caller, uint64_t callee);
+
+		/*!
+		 * \brief	Functions called by a function
+		 * \param	ea	entry point of the function
+		 * \return	callees, empty if the function is unknown
+		 */
+		const std::set<uint64_t>& getCallees(uint64_t ea) const;
+
+		/*!
+		 * \brief	number of functions
+		 */
+		size_t size() const noexcept;
+
+		/*!
+		 * \brief	Strongly connected components (Tarjan)
+		 *			Mutually recursive functions share a component
+		 * \return	components, callees always before their callers
+		 */
+		std::vector<std::vector<uint64_t>> getComponents() const;
+	};
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef __YAGI_CODEVIEW__
+#define __YAGI_CODEVIEW__
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "decompiler.hh"
+
+namespace yagi 
+{
+	/*!
+	 * \brief	Lines changed between two versions of a view
+	 *			Lines are compared from both ends, the changed lines
+	 *			are the block between the common prefix and suffix
+	 */
+	struct LineDiff
+	{
+		/*!
+		 * \brief	number of unchanged lines at the start
+		 */
+		size_t prefix;
+
+		/*!
+		 * \brief	number of unchanged lines at the end
+		 */
+		size_t suffix;
+
+		/*!
+		 * \brief	number of lines of the old view
+		 */
+		size_t oldSize;
+
+		/*!
+		 * \brief	number of lines of the new view
+		 */
+		size_t newSize;
+
+		/*!
+		 * \brief	number of lines of the new view that changed
+		 */
+		size_t getChangedLines() const noexcept;
+
+		/*!
+		 * \brief	Follow a line of the old view into the new view
+		 *			a line inside the changed block stays inside it
+		 * \param	line	index in the old view
+		 * \return	index in the new view
+		 */
+		size_t remap(size_t line) const noexcept;
+	};
+
+	/*!
+	 * \brief	Line access into a decompilation result
+	 *			Only the offset of each line is stored,
+	 *			lines are read from the result when displayed
+	 */
+	class CodeView
+	{
+	protected:
+		/*!
+		 * \brief	displayed decompilation, shared with the viewer
+		 */
+		std::shared_ptr<const Decompiler::Result> m_result;
+
+		/*!
+		 * \brief	offset of the first char of each line in the code
+		 */
+		std::vector<size_t> m_lines;
+
+	public:
+		/*!
+		 * \brief	ctor, index lines of the code
+		 * \param	result	decompilation result to display
+		 */
+		explicit CodeView(std::shared_ptr<const Decompiler::Result> result);
+
+		/*!
+		 * \brief	number of lines
+		 */
+		size_t size() const noexcept;
+
+		/*!
+		 * \brief	Content of a line, without the line feed
+		 * \param	index	index of the line
+		 * \return	empty if index is out of range
+		 */
+		std::string_view getLine(size_t index) const;
+
+		/*!
+		 * \brief	displayed decompilation
+		 */
+		const Decompiler::Result& getResult() const noexcept;
+
+		/*!
+		 * \brief	Compare lines of two views
+		 * \param	from	old view
+		 * \param	to	new view
+		 */
+		static LineDiff diff(const CodeView& from, const CodeView& to);
+	};
+
+	/*!
+	 * \brief	Opened views by title, views are not owned
+	 *			A view keeps its title when its function is renamed,
+	 *			so a view is removed by identity, not by its current name
+	 */
+	template<typename View>
+	class ViewRegistry
+	{
+	protected:
+		std::map<std::string, View*> m_views;
+
+	public:
+		/*!
+		 * \brief	Register a view
+		 * \param	title	title of the view
+		 * \param	view	the view
+		 */
+		void add(const std::string& title, View* view)
+		{
+			m_views.insert_or_assign(title, view);
+		}
+
+		/*!
+		 * \brief	Find a view by its title
+		 * \return	null if no view has this title
+		 */
+		View* find(const std::string& title) const
+		{
+			auto found = m_views.find(title);
+			return found == m_views.end() ? nullptr : found->second;
+		}
+
+		/*!
+		 * \brief	Unregister a view, whatever its title
+		 * \param	view	the view
+		 */
+		void remove(const View* view)
+		{
+			for (auto it = m_views.begin(); it != m_views.end(); ++it)
+			{
+				if (it->second == view)
+				{
+					m_views.erase(it);
+					return;
+				}
+			}
+		}
+
+		typename std::map<std::string, View*>::const_iterator begin() const noexcept
+		{
+			return m_views.begin();
+		}
+
+		typename std::map<std::string, View*>::const_iterator end() const noexcept
+		{
+			return m_views.end();
+		}
+	};
+}
+
+#endif
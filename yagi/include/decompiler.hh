@@ -4,8 +4,11 @@
 #include <string>
 #include <map>
 #include <optional>
+#include <ostream>
 #include <vector>
 
+#include "callgraph.hh"
+
 namespace yagi 
 {
 	/*!
@@ -125,6 +128,48 @@ namespace yagi
 			{}
 		};
 
+		/*!
+		 * \brief	progress of a job done by slices
+		 */
+		struct Progress
+		{
+			/*!
+			 * \brief	number of items already processed
+			 */
+			size_t done;
+
+			/*!
+			 * \brief	total number of items
+			 */
+			size_t total;
+
+			/*!
+			 * \brief	is the job finished
+			 */
+			bool isFinished() const
+			{
+				return done >= total;
+			}
+		};
+
+		/*!
+		 * \brief	set of actions used to decompile
+		 */
+		enum class Profile
+		{
+			Full,		// every ghidra action
+			Preview		// faster, skips the expensive simplifications
+		};
+
+		/*!
+		 * \brief	output format of a profiling report
+		 */
+		enum class ProfileFormat
+		{
+			Text,
+			Json
+		};
+
 		virtual ~Decompiler() = default;
 
 		/*!
@@ -133,6 +178,75 @@ namespace yagi
 		 * \return	decompiled source code
 		 */
 		virtual std::optional<Result> decompile(uint64_t funcAddress) = 0;
+
+		/*!
+		 * \brief	decompile with a specific set of actions
+		 * \param	funcAddress	address of the function to decompile
+		 * \param	profile	full or preview decompilation
+		 * \return	decompiled source code
+		 */
+		virtual std::optional<Result> decompile(uint64_t funcAddress, Profile profile)
+		{
+			return decompile(funcAddress);
+		}
+
+		/*!
+		 * \brief	Decompile every function of a call graph, callees first
+		 *			so prototypes recovered from callees are used by callers
+		 * \param	graph	call graph of the functions
+		 * \return	number of decompiled functions
+		 */
+		virtual size_t decompileAll(const CallGraph& graph)
+		{
+			return 0;
+		}
+
+		/*!
+		 * \brief	Functions whose last decompilation consulted something
+		 *			that changed in the backend since
+		 * \return	entry points of the functions to decompile again
+		 */
+		virtual std::vector<uint64_t> getStaleFunctions() const
+		{
+			return {};
+		}
+
+		/*!
+		 * \brief	Translate backend types before any decompilation
+		 *			Work is done by slices to keep the UI responsive
+		 * \param	budget	maximum number of types translated by this call
+		 * \return	progress of the whole import
+		 */
+		virtual Progress importTypes(size_t budget)
+		{
+			return Progress{ 0, 0 };
+		}
+
+		/*!
+		 * \brief	Enable or disable the profiling of decompilation stages
+		 * \param	enable	true to enable
+		 */
+		virtual void setProfiling(bool enable)
+		{}
+
+		/*!
+		 * \brief	Stop a running decompilation as soon as possible
+		 *			Can be called from any thread, the decompiler can't be used after
+		 */
+		virtual void cancel() noexcept
+		{}
+
+		/*!
+		 * \brief	Write a profiling report
+		 * \param	out	output stream
+		 * \param	session	true for all decompiled functions, false for the last one
+		 * \param	format	text or JSON
+		 * \return	false if profiling is disabled or not supported
+		 */
+		virtual bool writeProfile(std::ostream& out, bool session, ProfileFormat format) const
+		{
+			return false;
+		}
 	};
 }
 
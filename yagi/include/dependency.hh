@@ -0,0 +1,93 @@
+#ifndef __YAGI_DEPENDENCY__
+#define __YAGI_DEPENDENCY__
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+#include "epoch.hh"
+#include "prototypestore.hh"
+
+namespace yagi
+{
+	/*!
+	 * \brief	Everything a decompilation consulted in the backend
+	 *			The result stays valid until one of them changes
+	 */
+	class DependencySet
+	{
+	protected:
+		/*!
+		 * \brief	addresses of looked up symbols and functions
+		 */
+		std::set<uint64_t> m_addresses;
+
+		/*!
+		 * \brief	loader pages read, indexed by page number
+		 */
+		std::set<uint64_t> m_pages;
+
+		/*!
+		 * \brief	names of translated types
+		 */
+		std::set<std::string> m_types;
+
+		/*!
+		 * \brief	version of each consulted recovered prototype, by entry point
+		 */
+		std::map<uint64_t, uint64_t> m_prototypes;
+
+	public:
+		/*!
+		 * \brief	A symbol was looked up at an address
+		 * \param	ea	address of the lookup
+		 */
+		void addAddress(uint64_t ea);
+
+		/*!
+		 * \brief	Bytes were read from the loader
+		 * \param	ea	first read byte
+		 * \param	size	number of read bytes
+		 */
+		void addBytes(uint64_t ea, uint64_t size);
+
+		/*!
+		 * \brief	A type was translated
+		 * \param	name	name of the type
+		 * \return	false if the type was already recorded
+		 */
+		bool addType(const std::string& name);
+
+		/*!
+		 * \brief	A recovered prototype was looked up, even if none was found
+		 * \param	ea	entry point of the function
+		 * \param	version	version of its prototype in the store
+		 */
+		void addPrototype(uint64_t ea, uint64_t version);
+
+		/*!
+		 * \brief	Take the current version of every consulted prototype
+		 *			so the decompilation doesn't outdate itself with what it published
+		 * \param	prototypes	store of recovered prototypes
+		 */
+		void updatePrototypes(const PrototypeStore& prototypes);
+
+		const std::set<uint64_t>& getAddresses() const noexcept;
+		const std::set<uint64_t>& getPages() const noexcept;
+		const std::set<std::string>& getTypes() const noexcept;
+		const std::map<uint64_t, uint64_t>& getPrototypes() const noexcept;
+
+		/*!
+		 * \brief	Check if something changed since a result was computed
+		 * \param	epochs	tracker of backend changes
+		 * \param	epoch	epoch of the result
+		 * \param	prototypes	store of recovered prototypes, null if not shared
+		 * \return	true if any address, page or type changed after epoch,
+		 *			or if a consulted prototype was published again
+		 */
+		bool isStale(const EpochTracker& epochs, uint64_t epoch, const PrototypeStore* prototypes = nullptr) const;
+	};
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef __YAGI_EBPF_HELPER__
+#define __YAGI_EBPF_HELPER__
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Types used by eBPF helper prototypes
+	 */
+	enum class EbpfType
+	{
+		Void,
+		Int,
+		Ptr,
+		Str,
+		U16,
+		U32,
+		U64,
+		S32,
+		S64
+	};
+
+	/*!
+	 * \brief	A parameter of an eBPF helper
+	 */
+	struct EbpfParameter
+	{
+		std::string name;
+		EbpfType type;
+	};
+
+	/*!
+	 * \brief	An eBPF helper, called through the syscall space
+	 */
+	struct EbpfHelper
+	{
+		/*!
+		 * \brief	helper number, address in the syscall space
+		 */
+		uint32_t id;
+
+		/*!
+		 * \brief	name of the helper
+		 */
+		std::string name;
+
+		/*!
+		 * \brief	return type
+		 */
+		EbpfType returnType;
+
+		/*!
+		 * \brief	parameters, in order
+		 */
+		std::vector<EbpfParameter> params;
+
+		/*!
+		 * \brief	true if the helper takes variable arguments
+		 */
+		bool dotdotdot;
+	};
+
+	/*!
+	 * \brief	Table of eBPF helpers by id
+	 *			Built from the static table compiled into yagi
+	 *			and extended by data files, one helper per line :
+	 *			<id> <return type> <name> [<type>:<param name>]... [...]
+	 *			types are void, int, ptr, str, u16, u32, u64, s32 and s64
+	 *			a line starting with # is a comment
+	 */
+	class EbpfHelperTable
+	{
+	protected:
+		/*!
+		 * \brief	helpers by id
+		 */
+		std::map<uint32_t, EbpfHelper> m_helpers;
+
+	public:
+		/*!
+		 * \brief	name of the data file searched in ghidra spec paths
+		 */
+		static constexpr const char* FILE_NAME = "ebpf_helpers.txt";
+
+		/*!
+		 * \brief	ctor, with the built-in helpers
+		 */
+		explicit EbpfHelperTable();
+
+		/*!
+		 * \brief	Add or replace helpers from a data file
+		 * \param	input	content of the data file
+		 * \param	source	name of the data file, for error report
+		 * \throw	InvalidEbpfHelper	a line can't be parsed, the table is left unchanged
+		 */
+		void load(std::istream& input, const std::string& source);
+
+		/*!
+		 * \brief	all helpers, sorted by id
+		 */
+		const std::map<uint32_t, EbpfHelper>& getHelpers() const;
+	};
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef __YAGI_EPOCH__
+#define __YAGI_EPOCH__
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace yagi 
+{
+	/*!
+	 * \brief	Track changes made into the backend database
+	 *			Each change bumps a global counter (the epoch)
+	 *			which is recorded for the changed address, page or type
+	 *			A cache entry is valid while its epoch is greater or equal
+	 *			than the epoch of what it was built from
+	 *			Changes come from the main thread, checks from the decompilation thread
+	 */
+	class EpochTracker
+	{
+	public:
+		/*!
+		 * \brief	granularity of byte changes
+		 */
+		static const uint64_t LOADER_PAGE_SIZE = 0x1000;
+
+	protected:
+		/*!
+		 * \brief	protect every epoch
+		 */
+		mutable std::mutex m_mutex;
+
+		/*!
+		 * \brief	current epoch, incremented on each change
+		 */
+		uint64_t m_current;
+
+		/*!
+		 * \brief	epoch of the last change per address (name, type, function bounds)
+		 */
+		std::map<uint64_t, uint64_t> m_addresses;
+
+		/*!
+		 * \brief	epoch of the last byte change per loader page
+		 */
+		std::map<uint64_t, uint64_t> m_pages;
+
+		/*!
+		 * \brief	epoch of the last change per type name
+		 */
+		std::map<std::string, uint64_t> m_types;
+
+		/*!
+		 * \brief	epoch of the last change that may impact every page
+		 *			(segment creation, rebase, etc...)
+		 */
+		uint64_t m_allPages;
+
+		/*!
+		 * \brief	epoch of the last change that may impact every type
+		 */
+		uint64_t m_allTypes;
+
+		/*!
+		 * \brief	epoch of the last change of any type
+		 */
+		uint64_t m_lastType;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 */
+		EpochTracker();
+
+		/*!
+		 * \brief	Copy is forbidden, tracker is shared between caches
+		 */
+		EpochTracker(const EpochTracker&) = delete;
+		EpochTracker& operator=(const EpochTracker&) = delete;
+
+		/*!
+		 * \brief	current epoch
+		 *			Use it to tag a cache entry built now
+		 */
+		uint64_t getCurrent() const noexcept;
+
+		/*!
+		 * \brief	Something changed at address (name, type, function bounds)
+		 * \param	ea	address of the change
+		 */
+		void touchAddress(uint64_t ea);
+
+		/*!
+		 * \brief	Bytes of the program changed
+		 * \param	ea		first patched byte
+		 * \param	size	number of patched bytes
+		 */
+		void touchBytes(uint64_t ea, uint64_t size);
+
+		/*!
+		 * \brief	Memory layout changed, every page is impacted
+		 */
+		void touchMemory();
+
+		/*!
+		 * \brief	A type definition changed
+		 * \param	name	name of the type
+		 */
+		void touchType(const std::string& name);
+
+		/*!
+		 * \brief	The whole type library may have changed
+		 */
+		void touchTypeLibrary();
+
+		/*!
+		 * \brief	epoch of the last change at an address
+		 */
+		uint64_t getAddressEpoch(uint64_t ea) const;
+
+		/*!
+		 * \brief	epoch of the last change of the page that contains ea
+		 */
+		uint64_t getPageEpoch(uint64_t ea) const;
+
+		/*!
+		 * \brief	epoch of the last change of a type
+		 */
+		uint64_t getTypeEpoch(const std::string& name) const;
+
+		/*!
+		 * \brief	epoch of the last change of the whole type library
+		 */
+		uint64_t getTypeLibraryEpoch() const noexcept;
+
+		/*!
+		 * \brief	epoch of the last change of any type
+		 *			Use by caches of types that depend on other types
+		 */
+		uint64_t getLastTypeEpoch() const noexcept;
+
+		/*!
+		 * \brief	List types changed after an epoch
+		 * \param	epoch	reference epoch
+		 * \return	names of types changed strictly after epoch
+		 */
+		std::vector<std::string> getTypesChangedSince(uint64_t epoch) const;
+
+		/*!
+		 * \brief	epoch of the last change that may impact every page
+		 */
+		uint64_t getMemoryEpoch() const noexcept;
+
+		/*!
+		 * \brief	List addresses changed after an epoch
+		 * \param	epoch	reference epoch
+		 * \return	addresses changed strictly after epoch
+		 */
+		std::set<uint64_t> getAddressesChangedSince(uint64_t epoch) const;
+	};
+}
+
+#endif
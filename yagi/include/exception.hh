@@ -130,6 +130,53 @@ namespace yagi
 	public:
 		explicit UnableToFoundGhidraFolder();
 	};
+
+	/*!
+	 * \brief	A type database file can't be read
+	 */
+	class InvalidTypeDatabase : public Error
+	{
+	public:
+		explicit InvalidTypeDatabase(const std::string& path, const std::string& reason);
+	};
+
+	/*!
+	 * \brief	A line of an eBPF helper file can't be parsed
+	 */
+	class InvalidEbpfHelper : public Error
+	{
+	public:
+		explicit InvalidEbpfHelper(const std::string& source, size_t line, const std::string& reason);
+	};
+
+	/*!
+	 * \brief	A backend trace file can't be read or written
+	 */
+	class InvalidTrace : public Error
+	{
+	public:
+		explicit InvalidTrace(const std::string& path, const std::string& reason);
+	};
+
+	/*!
+	 * \brief	A backend query can't reach the main thread anymore
+	 *			because the plugin is closed
+	 */
+	class MainThreadClosed : public Error
+	{
+	public:
+		explicit MainThreadClosed();
+	};
+
+	/*!
+	 * \brief	A running decompilation is stopped
+	 *			because the plugin is closed
+	 */
+	class DecompilationCanceled : public Error
+	{
+	public:
+		explicit DecompilationCanceled();
+	};
 }
 
 #endif
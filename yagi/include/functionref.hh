@@ -0,0 +1,53 @@
+#ifndef __YAGI_FUNCTIONREF__
+#define __YAGI_FUNCTIONREF__
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace yagi
+{
+	template<typename Signature>
+	class FunctionRef;
+
+	/*!
+	 * \brief	Non owning reference to a callable
+	 *			Unlike std::function it never allocates,
+	 *			the callable must outlive the reference
+	 *			Use it for visitors called during the call only
+	 */
+	template<typename Result, typename... Args>
+	class FunctionRef<Result(Args...)>
+	{
+	protected:
+		/*!
+		 * \brief	referenced callable
+		 */
+		void* m_callable;
+
+		/*!
+		 * \brief	call m_callable with its real type
+		 */
+		Result(*m_invoke)(void*, Args...);
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	callable	lambda or function object, must outlive the reference
+		 */
+		template<typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, FunctionRef>>>
+		FunctionRef(Callable&& callable) noexcept
+			: m_callable{ const_cast<void*>(static_cast<const void*>(std::addressof(callable))) },
+			m_invoke{ [](void* callable, Args... args) -> Result {
+				return (*static_cast<std::remove_reference_t<Callable>*>(callable))(std::forward<Args>(args)...);
+			} }
+		{}
+
+		Result operator()(Args... args) const
+		{
+			return m_invoke(m_callable, std::forward<Args>(args)...);
+		}
+	};
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef __YAGI_DECOMPILER__
 #define __YAGI_DECOMPILER__
 
+#include <list>
+#include <map>
 #include <memory>
 #include <optional>
 
@@ -9,6 +11,8 @@
 #include "symbolinfo.hh"
 #include "logger.hh"
 #include "loader.hh"
+#include "epoch.hh"
+#include "dependency.hh"
 
 class Funcdata;
 
@@ -16,6 +20,8 @@ namespace yagi
 {
 
 	class YagiArchitecture;
+	class TraceRecorder;
+	class MainThread;
 
 	/*!
 	 *	\brief	Implement the IDecompile interface for Ghidra
@@ -28,27 +34,71 @@ namespace yagi
 		 */
 		std::unique_ptr<YagiArchitecture> m_architecture;
 
-	protected:
 		/*!
-		 * \brief	Find high level variable and defined address
-		 * \param	data	the source function
-		 * \param	symbols	the output list of symbols
+		 * \brief	A decompilation result, the epoch when it was computed
+		 *			and what it consulted in the backend
+		 */
+		struct CachedResult
+		{
+			uint64_t epoch;
+			Decompiler::Profile profile;
+			Decompiler::Result result;
+			DependencySet dependencies;
+
+			/*!
+			 * \brief	position of the function in m_recent
+			 */
+			std::list<uint64_t>::iterator recent;
+		};
+
+		/*!
+		 * \brief	maximum number of cached results, the least recently
+		 *			used one is dropped first
 		 */
-		void findVarSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols) const;
+		static const size_t MAX_RESULTS = 1024;
 
 		/*!
-		 * \brief	Find calling function and populate the sylbol map
-		 * \param	data	the source function
-		 * \param	symbols	the output map populate by algo
+		 * \brief	results already computed, indexed by function address
+		 *			an entry is valid until one of its dependencies changes
 		 */
-		void findFunctionSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols) const;
+		std::map<uint64_t, CachedResult> m_results;
 
 		/*!
-		 * \param	Trying to find Constant symbols
-		 * \param	data	the source function
-		 * \param	symbols	the output symbol maps
+		 * \brief	addresses of cached results, most recently used first
 		 */
-		void findConstantSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols) const;
+		std::list<uint64_t> m_recent;
+
+		/*!
+		 * \brief	epoch when ghidra scope and types were last synchronized
+		 *			with the backend
+		 */
+		std::optional<uint64_t> m_syncEpoch;
+
+		/*!
+		 * \brief	names of types to import, computed on the first import slice
+		 */
+		std::optional<std::vector<std::string>> m_typesToImport;
+
+		/*!
+		 * \brief	number of types already imported
+		 */
+		size_t m_typesImported;
+
+	protected:
+		/*!
+		 * \brief	Cache a result, drop the least recently used ones
+		 *			when the cache is full
+		 * \param	ea	entry point of the function
+		 * \param	cached	result to cache
+		 */
+		void cacheResult(uint64_t ea, CachedResult cached);
+
+		/*!
+		 * \brief	Bring ghidra scope and types up to date with the backend
+		 *			Only symbols built from changed addresses or types are dropped,
+		 *			scope is cleared when the memory layout or the type library changed
+		 */
+		void synchronize();
 
 	public:
 		/*!
@@ -91,6 +141,59 @@ namespace yagi
 		 */
 		std::optional<Decompiler::Result> decompile(uint64_t funcAddress) override;
 
+		/*!
+		 *	\brief	decompile with a specific set of actions
+		 *	\param	funcAddress	address of function to decompile
+		 *	\param	profile	full or preview decompilation
+		 *	\raise	DecompilationCanceled
+		 */
+		std::optional<Decompiler::Result> decompile(uint64_t funcAddress, Profile profile) override;
+
+		/*!
+		 * \brief	Decompile every function of a call graph, callees first
+		 *			Recovered prototypes are published to their callers
+		 *			Ghidra shares its sleigh translator between architectures
+		 *			of a language, so components are run by a single worker
+		 * \param	graph	call graph of the functions
+		 * \return	number of decompiled functions
+		 */
+		size_t decompileAll(const CallGraph& graph) override;
+
+		/*!
+		 * \brief	Cached results whose dependencies changed in the backend
+		 * \return	entry points of the stale functions
+		 */
+		std::vector<uint64_t> getStaleFunctions() const override;
+
+		/*!
+		 * \brief	Translate backend types by slices
+		 *			Types used by a type are translated with it
+		 * \param	budget	maximum number of types translated by this call
+		 * \return	progress of the import
+		 */
+		Decompiler::Progress importTypes(size_t budget) override;
+
+		/*!
+		 * \brief	Enable the profiling of YagiArchitecture::performActions
+		 * \param	enable	true to enable
+		 */
+		void setProfiling(bool enable) override;
+
+		/*!
+		 * \brief	Stop the running decompilation at its next action stage,
+		 *			a canceled decompilation raises DecompilationCanceled
+		 */
+		void cancel() noexcept override;
+
+		/*!
+		 * \brief	Write the profile of the last function or of the session
+		 * \param	out	output stream
+		 * \param	session	true for all decompiled functions
+		 * \param	format	text or JSON
+		 * \return	false if profiling is disabled
+		 */
+		bool writeProfile(std::ostream& out, bool session, ProfileFormat format) const override;
+
 		/*!
 		 *	\brief	factory
 		 *			Use to build a ghidra decompiler interface
@@ -99,12 +202,18 @@ namespace yagi
 		 *  \param	logger	logger use to inform state of the decompilation
 		 *	\param	symbolDatabase	symboles database use to increase the decompilation output
 		 *  \param	typeDatabase	type declared use to increase the decompilation output
+		 *	\param	epochs	tracker of backend changes, use to invalidate caches
+		 *	\param	mainThread	gate to the main thread of IDA, use to load bytes
+		 *	\param	recorder	if set, record loaded bytes and the architecture
 		 */
 		static std::optional<std::unique_ptr<Decompiler>> build(
 			const Compiler& compilerType,
 			std::unique_ptr<Logger> logger, 
 			std::unique_ptr<SymbolInfoFactory> symbolDatabase, 
-			std::unique_ptr<TypeInfoFactory> typeDatabase
+			std::unique_ptr<TypeInfoFactory> typeDatabase,
+			std::shared_ptr<EpochTracker> epochs,
+			std::shared_ptr<MainThread> mainThread,
+			std::shared_ptr<TraceRecorder> recorder = nullptr
 		) noexcept;
 	};
 }
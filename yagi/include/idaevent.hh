@@ -0,0 +1,95 @@
+#ifndef __YAGI_IDAEVENT__
+#define __YAGI_IDAEVENT__
+
+#include <idp.hpp>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "epoch.hh"
+
+namespace yagi 
+{
+	/*!
+	 * \brief	Listen IDB events and report changes
+	 *			into the epoch tracker shared by all Yagi caches
+	 */
+	class IdaEventListener
+	{
+	protected:
+		/*!
+		 * \brief	tracker updated on each event
+		 */
+		std::shared_ptr<EpochTracker> m_epochs;
+
+		/*!
+		 * \brief	snapshot of serialized local types indexed by ordinal
+		 *			IDA before 8.3 doesn't tell which local type changed, so we diff
+		 */
+		std::map<uint32_t, std::pair<std::string, std::string>> m_localTypes;
+
+		/*!
+		 * \brief	Capture the current state of local types
+		 * \param	snapshot	output snapshot (ordinal -> (name, serialized type))
+		 */
+		static void snapshotLocalTypes(std::map<uint32_t, std::pair<std::string, std::string>>& snapshot);
+
+		/*!
+		 * \brief	Capture the current state of a local type
+		 * \param	ordinal	ordinal of the local type
+		 * \return	name and serialized type, nothing if the ordinal is free
+		 */
+		static std::optional<std::pair<std::string, std::string>> snapshotLocalType(uint32_t ordinal);
+
+		/*!
+		 * \brief	Diff local types with the last snapshot
+		 *			and touch every changed type
+		 */
+		void onLocalTypesChanged();
+
+		/*!
+		 * \brief	Diff a single local type with the last snapshot
+		 *			and touch it if it changed
+		 * \param	ordinal	ordinal of the changed local type
+		 */
+		void onLocalTypeChanged(uint32_t ordinal);
+
+		/*!
+		 * \brief	A structure changed, it may be a function frame
+		 * \param	id	structure id
+		 */
+		void onStructChanged(uint64_t id);
+
+		/*!
+		 * \brief	IDB notification callback
+		 */
+		static ssize_t idaapi onIdbEvent(void* userData, int code, va_list va);
+
+	public:
+		/*!
+		 * \brief	ctor, install the IDB hook
+		 * \param	epochs	tracker to update
+		 */
+		explicit IdaEventListener(std::shared_ptr<EpochTracker> epochs);
+
+		/*!
+		 * \brief	dtor, remove the IDB hook
+		 */
+		~IdaEventListener();
+
+		/*!
+		 * \brief	Copy is forbidden, hook is bound to this instance
+		 */
+		IdaEventListener(const IdaEventListener&) = delete;
+		IdaEventListener& operator=(const IdaEventListener&) = delete;
+
+		/*!
+		 * \brief	Move is forbidden, hook is bound to this instance
+		 */
+		IdaEventListener(IdaEventListener&&) noexcept = delete;
+		IdaEventListener& operator=(IdaEventListener&&) noexcept = delete;
+	};
+}
+
+#endif
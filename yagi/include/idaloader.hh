@@ -2,7 +2,12 @@
 #define __YAGI_IDALOADER__
 
 #include "loader.hh"
+#include "epoch.hh"
+#include "idasync.hh"
 #include <libdecomp.hh>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace yagi 
 {
@@ -11,11 +16,65 @@ namespace yagi
 	 */
 	class IdaLoader : public LoadImage
 	{
+	public:
+		/*!
+		 * \brief	pages read after a missing one, in the same request
+		 *			decompilation mostly reads code forward
+		 */
+		static const uint64_t LOADER_READ_AHEAD = 3;
+
+	protected:
+		/*!
+		 * \brief	A page of program bytes read from IDA
+		 */
+		struct Page
+		{
+			/*!
+			 * \brief	epoch when the page was read
+			 */
+			uint64_t epoch;
+
+			/*!
+			 * \brief	content of the page
+			 */
+			std::vector<uint1> bytes;
+		};
+
+		/*!
+		 * \brief	tracker use to know if a page was patched
+		 */
+		std::shared_ptr<EpochTracker> m_epochs;
+
+		/*!
+		 * \brief	IDA is only read from its main thread
+		 */
+		std::shared_ptr<MainThread> m_mainThread;
+
+		/*!
+		 * \brief	pages already read, indexed by page number
+		 */
+		std::map<uint64_t, Page> m_pages;
+
+		/*!
+		 * \brief	Is a page in cache and not patched since
+		 * \param	pageNumber	index of the page
+		 */
+		bool isPageValid(uint64_t pageNumber) const;
+
+		/*!
+		 * \brief	Read missing or patched pages from IDA in a single request
+		 * \param	firstPage	first page needed
+		 * \param	lastPage	last page needed, some more are read ahead
+		 */
+		void loadPages(uint64_t firstPage, uint64_t lastPage);
+
 	public:
 		/*!
 		 * \brief	constructor
+		 * \param	epochs	tracker use to invalidate patched pages
+		 * \param	mainThread	use to read IDA from any thread
 		 */
-		explicit IdaLoader();
+		explicit IdaLoader(std::shared_ptr<EpochTracker> epochs, std::shared_ptr<MainThread> mainThread);
 
 		/*!
 		 *	\brief	Copy is authorized because we only use copyable type
@@ -52,8 +111,34 @@ namespace yagi
 
 	/*!
 	 * \brief	The factory interface
+	 *			Share the epoch tracker with each built loader
 	 */
-	using IdaLoaderFactory = LoaderFactoryDefault<IdaLoader>;
+	class IdaLoaderFactory : public LoaderFactory
+	{
+	protected:
+		/*!
+		 * \brief	tracker given to each loader
+		 */
+		std::shared_ptr<EpochTracker> m_epochs;
+
+		/*!
+		 * \brief	gate to the main thread given to each loader
+		 */
+		std::shared_ptr<MainThread> m_mainThread;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	epochs	tracker use to invalidate loader cache
+		 * \param	mainThread	use to read IDA from any thread
+		 */
+		explicit IdaLoaderFactory(std::shared_ptr<EpochTracker> epochs, std::shared_ptr<MainThread> mainThread);
+
+		/*!
+		 * \brief	build an IDA loader
+		 */
+		LoadImage* build() override;
+	};
 }
 
 #endif
\ No newline at end of file
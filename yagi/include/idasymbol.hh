@@ -2,6 +2,9 @@
 #define __YAGI_IDASYMBOLFACTORY__
 
 #include "symbolinfo.hh"
+#include <map>
+#include <idp.hpp>
+#include <netnode.hpp>
 
 namespace yagi 
 {
@@ -71,9 +74,88 @@ namespace yagi
 		bool isReadOnly() const noexcept override;
 	};
 
+	/*!
+	 * \brief	Frame members of an IDA function indexed by stack offset
+	 *			The frame is decoded once and then reused for every lookup
+	 */
+	class IdaFrameMap
+	{
+	protected:
+		/*!
+		 * \brief	member name indexed by offset in the Ghidra stack space
+		 */
+		std::map<uint64_t, std::string> m_members;
+
+		/*!
+		 * \brief	member name indexed by the 32 bits truncated offset
+		 *			Ghidra handle 32 bits stack address even in 64 bits
+		 */
+		std::map<uint32_t, std::string> m_members32;
+
+		/*!
+		 * \brief	distance between the Ghidra stack offset and the IDA frame offset
+		 */
+		uint64_t m_frameDelta;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	functionAddress	any address of the function
+		 */
+		explicit IdaFrameMap(uint64_t functionAddress);
+
+		/*!
+		 * \brief	Find the name of the frame member at a stack offset
+		 * \param	offset		offset in the Ghidra stack space
+		 * \param	addrSize	size of address in stack space
+		 * \return	if found the name of the member
+		 */
+		std::optional<std::string> find(uint64_t offset, uint32_t addrSize) const;
+
+		/*!
+		 * \brief	Convert a Ghidra stack offset into an IDA frame offset
+		 * \param	offset		offset in the Ghidra stack space
+		 * \param	addrSize	size of address in stack space
+		 * \return	offset in the IDA frame
+		 */
+		uint64_t toFrameOffset(uint64_t offset, uint32_t addrSize) const;
+	};
+
 	class IdaFunctionSymbolInfo : public FunctionSymbolInfo
 	{
+	protected:
+		/*!
+		 * \brief	frame of the function, decoded on first stack lookup
+		 */
+		std::optional<IdaFrameMap> m_frame;
+
+		/*!
+		 * \brief	Netnode that stores local names and types of the function
+		 *			one hash entry per (kind, space, pc)
+		 *			Created if missing, only use it to write
+		 * \return	the storage netnode
+		 */
+		netnode getStorage();
+
+		/*!
+		 * \brief	Find the storage netnode without creating it
+		 *			Safe to use from a read only request
+		 * \return	nullopt if nothing was ever stored for the function
+		 */
+		std::optional<netnode> findStorage() const;
+
 	public:
+		/*!
+		 * \brief	Copy legacy storage (one netnode per use address)
+		 *			into the storage of each function
+		 *			Legacy netnodes are kept and still written on edits,
+		 *			so older builds don't lose saved locals
+		 *			Malformed legacy entries are skipped
+		 *			Writes the database, run it once from the main thread
+		 *			before any decompilation (done at plugin init)
+		 */
+		static void migrateStorage();
+
 		explicit IdaFunctionSymbolInfo(std::unique_ptr<SymbolInfo> symbol)
 			: FunctionSymbolInfo{std::move(symbol)}
 		{}
@@ -157,6 +239,18 @@ namespace yagi
 		 * \return	if found the offset into memory space and the linked type
 		 */
 		std::optional<std::unique_ptr<TypeInfo>> findType(uint64_t pc, const std::string& from, uint64_t& offset) override;
+
+		/*!
+		 * \brief	Load every stored local name of the function
+		 *			by walking the function storage once
+		 */
+		std::vector<LocalName> getLocalNames() override;
+
+		/*!
+		 * \brief	Load every stored local type of the function
+		 *			by walking the function storage once
+		 */
+		std::vector<LocalType> getLocalTypes() override;
 	};
 
 	/*!
@@ -0,0 +1,277 @@
+#ifndef __YAGI_IDASYNC__
+#define __YAGI_IDASYNC__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "epoch.hh"
+#include "symbolinfo.hh"
+#include "typeinfo.hh"
+#include "typedatabase.hh"
+#include "trace.hh"
+
+namespace yagi
+{
+	/*!
+	 * \brief	Gate to the main thread of IDA
+	 *			IDA API can only be called from its main thread,
+	 *			other threads send their requests through it
+	 */
+	class MainThread
+	{
+	protected:
+		/*!
+		 * \brief	set when the plugin is closed, requests are canceled
+		 */
+		std::atomic<bool> m_closed;
+
+		/*!
+		 * \brief	protect the pending requests
+		 */
+		mutable std::mutex m_mutex;
+
+		/*!
+		 * \brief	notified when a request is executed or when the gate is closed
+		 */
+		mutable std::condition_variable m_executed;
+
+		/*!
+		 * \brief	ids of the requests waiting for the main thread,
+		 *			they are canceled when the gate is closed
+		 */
+		mutable std::set<int> m_pending;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 */
+		MainThread();
+
+		/*!
+		 * \brief	Copy is forbidden, the gate is shared
+		 */
+		MainThread(const MainThread&) = delete;
+		MainThread& operator=(const MainThread&) = delete;
+
+		/*!
+		 * \brief	Run a function on the main thread and wait for it
+		 *			Run directly if already on the main thread
+		 *			Exceptions are raised again in the calling thread
+		 *			Closing the gate releases the waiting threads
+		 * \param	request	function to run
+		 * \param	write	true if the request modifies the database
+		 * \raise	MainThreadClosed
+		 */
+		void execute(const std::function<void()>& request, bool write = false) const;
+
+		/*!
+		 * \brief	Run a query on the main thread and get its answer
+		 */
+		template<typename T>
+		T query(const std::function<T()>& request) const
+		{
+			std::optional<T> result;
+			execute([&result, &request]() { result.emplace(request()); });
+			return std::move(result.value());
+		}
+
+		/*!
+		 * \brief	Cancel the pending and every next request,
+		 *			use when the plugin is closed
+		 *			Must be called from the main thread
+		 */
+		void close() noexcept;
+
+		/*!
+		 * \brief	true if the plugin is closed
+		 */
+		bool isClosed() const noexcept;
+	};
+
+	/*!
+	 * \brief	Take snapshots of backend types
+	 *			A snapshot is owned by its type informations,
+	 *			so it's released with the last cache entry that uses it
+	 */
+	class TypeSnapshots
+	{
+	public:
+		/*!
+		 * \brief	Take a snapshot of backend types
+		 *			Must be called from the main thread
+		 * \param	types	types to snapshot
+		 * \return	a type information for each type, readable from any thread
+		 */
+		std::vector<std::unique_ptr<TypeInfo>> add(const std::vector<const TypeInfo*>& types);
+	};
+
+	/*!
+	 * \brief	Snapshot of a function symbol and of its local names and types
+	 *			taken in a single request to the main thread
+	 */
+	struct FunctionSnapshot
+	{
+		uint64_t epoch;
+
+		/*!
+		 * \brief	symbol of the function, none if it's not a function
+		 */
+		std::optional<TraceSymbol> symbol;
+		std::vector<LocalName> names;
+
+		/*!
+		 * \brief	local types, as type snapshots
+		 */
+		std::vector<LocalType> types;
+	};
+
+	/*!
+	 * \brief	Send symbol queries to the main thread
+	 *			Symbols and functions are snapshots cached until their address changes
+	 *			The cache is not locked during a request, so the main thread
+	 *			can use the factory while a worker waits for it
+	 */
+	class MainThreadSymbolInfoFactory : public SymbolInfoFactory
+	{
+	protected:
+		struct CachedSymbol
+		{
+			uint64_t epoch;
+			std::optional<TraceSymbol> symbol;
+		};
+
+		std::unique_ptr<SymbolInfoFactory> m_inner;
+		std::shared_ptr<MainThread> m_mainThread;
+		std::shared_ptr<EpochTracker> m_epochs;
+		std::shared_ptr<TypeSnapshots> m_types;
+
+		std::mutex m_mutex;
+		std::map<uint64_t, CachedSymbol> m_symbols;
+		std::map<uint64_t, std::shared_ptr<const FunctionSnapshot>> m_functions;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	inner	IDA symbol factory
+		 * \param	mainThread	gate to the main thread
+		 * \param	epochs	tracker use to invalidate snapshots
+		 * \param	types	store of type snapshots
+		 */
+		explicit MainThreadSymbolInfoFactory(std::unique_ptr<SymbolInfoFactory> inner, std::shared_ptr<MainThread> mainThread, std::shared_ptr<EpochTracker> epochs, std::shared_ptr<TypeSnapshots> types);
+
+		std::optional<std::unique_ptr<SymbolInfo>> find(uint64_t ea) override;
+		std::optional<std::unique_ptr<FunctionSymbolInfo>> find_function(uint64_t ea) override;
+	};
+
+	/*!
+	 * \brief	Function symbol answered from a snapshot
+	 *			Stack variables and modifications are sent to the main thread
+	 */
+	class MainThreadFunctionSymbolInfo : public FunctionSymbolInfo
+	{
+	protected:
+		/*!
+		 * \brief	IDA symbol factory, only used from the main thread
+		 */
+		SymbolInfoFactory& m_factory;
+
+		/*!
+		 * \brief	IDA function symbol, built by the first request that needs it
+		 *			so the frame is decoded once
+		 */
+		std::unique_ptr<FunctionSymbolInfo> m_inner;
+
+		std::shared_ptr<const FunctionSnapshot> m_snapshot;
+		std::shared_ptr<MainThread> m_mainThread;
+		std::shared_ptr<EpochTracker> m_epochs;
+
+		/*!
+		 * \brief	Get the IDA function symbol
+		 *			Must be called from the main thread
+		 * \raise	UnableToFindFunction
+		 */
+		FunctionSymbolInfo& getInner();
+
+	public:
+		explicit MainThreadFunctionSymbolInfo(SymbolInfoFactory& factory, std::shared_ptr<const FunctionSnapshot> snapshot, std::shared_ptr<MainThread> mainThread, std::shared_ptr<EpochTracker> epochs);
+
+		std::optional<std::string> findStackVar(uint64_t offset, uint32_t addrSize) override;
+		std::optional<std::string> findName(uint64_t pc, const std::string& space, uint64_t& offset) override;
+		void saveName(const MemoryLocation& loc, const std::string& space) override;
+		void saveType(const MemoryLocation& loc, const TypeInfo& newType) override;
+		bool clearType(const MemoryLocation& loc) override;
+		std::optional<std::unique_ptr<TypeInfo>> findType(uint64_t pc, const std::string& from, uint64_t& offset) override;
+		std::vector<LocalName> getLocalNames() override;
+		std::vector<LocalType> getLocalTypes() override;
+	};
+
+	/*!
+	 * \brief	Send type queries to the main thread
+	 *			Types are snapshots cached until a type changes
+	 */
+	class MainThreadTypeInfoFactory : public TypeInfoFactory
+	{
+	protected:
+		struct CachedType
+		{
+			uint64_t epoch;
+
+			/*!
+			 * \brief	snapshot of the type, none if not found
+			 */
+			std::optional<FileTypeInfo> type;
+		};
+
+		std::unique_ptr<TypeInfoFactory> m_inner;
+		std::shared_ptr<MainThread> m_mainThread;
+		std::shared_ptr<EpochTracker> m_epochs;
+		std::shared_ptr<TypeSnapshots> m_types;
+
+		std::mutex m_mutex;
+		std::map<std::string, CachedType> m_names;
+		std::map<uint64_t, CachedType> m_addresses;
+
+		/*!
+		 * \brief	Build a type on the main thread and keep its snapshot
+		 * \param	build	query of the inner factory
+		 * \return	cache entry of the snapshot
+		 */
+		CachedType snapshot(const std::function<std::optional<std::unique_ptr<TypeInfo>>()>& build);
+
+		/*!
+		 * \brief	Find a type in a cache, or snapshot it if it's outdated
+		 *			The cache is not locked during the request, so the main thread
+		 *			can use the factory while a worker waits for it
+		 * \param	cache	cache of names or addresses
+		 * \param	key	name or address
+		 * \param	epoch	entries older than this epoch are outdated
+		 * \param	build	query of the inner factory
+		 */
+		template<typename Key>
+		std::optional<std::unique_ptr<TypeInfo>> find(std::map<Key, CachedType>& cache, const Key& key, uint64_t epoch, const std::function<std::optional<std::unique_ptr<TypeInfo>>()>& build);
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	inner	IDA type factory
+		 * \param	mainThread	gate to the main thread
+		 * \param	epochs	tracker use to invalidate snapshots
+		 * \param	types	store of type snapshots
+		 */
+		explicit MainThreadTypeInfoFactory(std::unique_ptr<TypeInfoFactory> inner, std::shared_ptr<MainThread> mainThread, std::shared_ptr<EpochTracker> epochs, std::shared_ptr<TypeSnapshots> types);
+
+		std::optional<std::unique_ptr<TypeInfo>> build(const std::string& name) override;
+		std::optional<std::unique_ptr<TypeInfo>> build(uint64_t ea) override;
+		std::vector<std::string> getTypeNames() override;
+	};
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <idp.hpp>
 
 #include "typeinfo.hh"
+#include "typedatabase.hh"
 #include "exception.hh"
 
 
@@ -68,6 +69,12 @@ namespace yagi
 		 */
 		std::string getName() const override;
 
+		/*!
+		 * \brief	Identity of the type in IDA
+		 *			local type ordinal if any, or serialized type
+		 * \return	canonical key of the type
+		 */
+		std::string getKey() const override;
 
 		/*!
 		 * \brief	Is the type is linked to an integer
@@ -146,6 +153,34 @@ namespace yagi
 		 *			If it's not, the nullopt
 		 */
 		std::optional<std::unique_ptr<ArrayInfo>> toArray() const override;
+
+		/*!
+		 * \brief	Visit the pointed object without heap allocation
+		 * \param	visitor	called with the pointed type
+		 * \return	false if it's not a pointer
+		 */
+		bool visitPointedObject(FunctionRef<void(const TypeInfo&)> visitor) const override;
+
+		/*!
+		 * \brief	Visit the element type without heap allocation
+		 * \param	visitor	called with the element type
+		 * \return	false if it's not an array
+		 */
+		bool visitArrayElement(FunctionRef<void(const TypeInfo&)> visitor) const override;
+
+		/*!
+		 * \brief	Visit the function view without heap allocation
+		 * \param	visitor	called with the function view
+		 * \return	false if it's not a function
+		 */
+		bool visitFunc(FunctionRef<void(const FuncInfo&)> visitor) const override;
+
+		/*!
+		 * \brief	Visit the structure view without heap allocation
+		 * \param	visitor	called with the structure view
+		 * \return	false if it's not a structure
+		 */
+		bool visitStruct(FunctionRef<void(const StructInfo&)> visitor) const override;
 	};
 
 	/*!
@@ -213,6 +248,13 @@ namespace yagi
 		 * \brief	Return name of the function
 		 */
 		std::string getName() const override;
+
+		/*!
+		 * \brief	Compute the whole signature
+		 *			with a single query of function details
+		 * \return	signature of the function
+		 */
+		FunctionSignature getSignature() const override;
 	};
 
 	/*!
@@ -251,6 +293,12 @@ namespace yagi
 		 * \brief	Return the list of structure fields 
 		 */
 		std::vector<TypeStructField> getFields() const override;
+
+		/*!
+		 * \brief	Visit structure fields without heap allocation
+		 * \param	visitor	called with offset, name and type of each field
+		 */
+		void visitFields(FunctionRef<void(uint64_t, std::string_view, const TypeInfo&)> visitor) const override;
 	};
 
 	/*!
@@ -367,6 +415,20 @@ namespace yagi
 
 		std::optional<std::unique_ptr<TypeInfo>> build(tinfo_t info);
 		std::optional<std::unique_ptr<TypeInfo>> build_decl(const std::string& name);
+
+		/*!
+		 * \brief	List local types of the IDB by ordinal
+		 * \return	names of all local types
+		 */
+		std::vector<std::string> getTypeNames() override;
+
+		/*!
+		 * \brief	Export local types, function and named address types
+		 *			to decompile later without IDA
+		 * \param	writer	type database writer
+		 * \return	number of exported entries
+		 */
+		size_t exportTypes(TypeDatabaseWriter& writer);
 	};
 }
 
@@ -0,0 +1,61 @@
+#ifndef __YAGI_IDAVIEW__
+#define __YAGI_IDAVIEW__
+
+#include <idp.hpp>
+#include <kernwin.hpp>
+#include "codeview.hh"
+
+namespace yagi 
+{
+	/*!
+	 * \brief	IDA place of a decompiler view, a line of a CodeView
+	 *			Lines are generated on demand from the CodeView
+	 *			given as user data of the custom viewer,
+	 *			so display cost depends on the screen, not on the code size
+	 */
+	class IdaViewPlace : public place_t
+	{
+	protected:
+		/*!
+		 * \brief	index of the line in the CodeView
+		 */
+		uval_t m_line;
+
+		/*!
+		 * \brief	id given by IDA when the class is registered
+		 */
+		static int s_id;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	line	index of the line
+		 */
+		explicit IdaViewPlace(uval_t line = 0);
+
+		/*!
+		 * \brief	Register the place class into IDA, once per session
+		 */
+		static void registerClass();
+
+		void idaapi print(qstring* out_buf, void* ud) const override;
+		uval_t idaapi touval(void* ud) const override;
+		place_t* idaapi clone() const override;
+		void idaapi copyfrom(const place_t* from) override;
+		place_t* idaapi makeplace(void* ud, uval_t x, int lnnum) const override;
+		int idaapi compare(const place_t* t2) const override;
+		int idaapi compare2(const place_t* t2, void* ud) const override;
+		void idaapi adjust(void* ud) override;
+		bool idaapi prev(void* ud) override;
+		bool idaapi next(void* ud) override;
+		bool idaapi beginning(void* ud) const override;
+		bool idaapi ending(void* ud) const override;
+		int idaapi generate(qstrvec_t* out, int* out_deflnnum, color_t* out_pfx_color, bgcolor_t* out_bgcolor, void* ud, int maxsize) const override;
+		void idaapi serialize(bytevec_t* out) const override;
+		bool idaapi deserialize(const uchar** pptr, const uchar* end) override;
+		int idaapi id() const override;
+		const char* idaapi name() const override;
+	};
+}
+
+#endif
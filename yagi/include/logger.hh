@@ -2,29 +2,76 @@
 #define __YAGI_ILOGGER__
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <ostream>
 
+/*!
+ * \brief	Lowest level compiled in, calls of lower levels are removed
+ *			0 for debug, 1 for info, 2 for error
+ */
+#ifndef YAGI_LOG_MIN_LEVEL
+#define YAGI_LOG_MIN_LEVEL 0
+#endif
+
+/*!
+ * \brief	Log a debug message, parameters are only evaluated
+ *			if the debug level is enabled
+ */
+#define YAGI_DEBUG(logger, ...) YAGI_LOG(logger, ::yagi::Logger::Level::Debug, debug, __VA_ARGS__)
+
+/*!
+ * \brief	Log an info message, parameters are only evaluated
+ *			if the info level is enabled
+ */
+#define YAGI_INFO(logger, ...) YAGI_LOG(logger, ::yagi::Logger::Level::Info, info, __VA_ARGS__)
+
+#define YAGI_LOG(logger, level, method, ...) \
+	do \
+	{ \
+		if constexpr (::yagi::Logger::isCompiled(level)) \
+		{ \
+			auto& _yagiLogger = (logger); \
+			if (_yagiLogger.isEnabled(level)) \
+			{ \
+				_yagiLogger.method(__VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+
 namespace yagi
 {
 	/*!
-	 * \brief	A base class for every logger 
+	 * \brief	A base class for every logger
 	 */
 	class Logger
 	{
+	public:
+		/*!
+		 * \brief	level of a message, by increasing severity
+		 */
+		enum class Level
+		{
+			Debug = 0,
+			Info = 1,
+			Error = 2
+		};
+
 	private:
 		/*!
-		 * \brief	Format any message from logger implementation 
+		 * \brief	messages below this level are dropped
+		 */
+		Level m_level;
+
+		/*!
+		 * \brief	Format any message from logger implementation
 		 */
 		template<typename... Params>
-		void format(const std::string& level, const std::string& message, Params... parameters)
+		void format(const char* level, std::string_view message, const Params&... parameters)
 		{
 			std::stringstream ss;
-			ss << "[Yagi] " << level << " : ";
-			for (auto& val : { message, parameters ... })
-			{
-				ss << " " << val;
-			}
+			ss << "[Yagi] " << level << " : " << " " << message;
+			((ss << " " << parameters), ...);
 
 			ss << std::endl;
 			print(ss.str());
@@ -37,7 +84,45 @@ namespace yagi
 		virtual void print(const std::string& message) = 0;
 
 	public:
-		
+		/*!
+		 * \brief	ctor, debug messages are dropped by default
+		 */
+		Logger() noexcept
+			: m_level{ Level::Info }
+		{}
+
+		virtual ~Logger() = default;
+
+		/*!
+		 * \brief	Check if a level is compiled in (see YAGI_LOG_MIN_LEVEL)
+		 */
+		static constexpr bool isCompiled(Level level) noexcept
+		{
+			return static_cast<int>(level) >= YAGI_LOG_MIN_LEVEL;
+		}
+
+		/*!
+		 * \brief	Check if a message of a level is printed
+		 *			Use it before computing expensive parameters
+		 */
+		bool isEnabled(Level level) const noexcept
+		{
+			return isCompiled(level) && level >= m_level;
+		}
+
+		/*!
+		 * \brief	Set the lowest printed level
+		 */
+		void setLevel(Level level) noexcept
+		{
+			m_level = level;
+		}
+
+		Level getLevel() const noexcept
+		{
+			return m_level;
+		}
+
 		/*!
 		 *	\brief	An error message
 		 *			This will be prefixed with the ERROR keyword
@@ -45,17 +130,35 @@ namespace yagi
 		 *  \param	parameters	convenient format parameters
 		 */
 		template<typename... Params>
-		void error(const std::string& message, Params... parameters) {
-			this->format("ERROR", message, parameters...);
+		void error(std::string_view message, const Params&... parameters) {
+			if (isEnabled(Level::Error))
+			{
+				this->format("ERROR", message, parameters...);
+			}
 		}
 
 		/*!
 		 * \brief	Write an informations log
-		 *			This will prefix all message with the INFI prefix
+		 *			This will prefix all message with the INFO prefix
+		 */
+		template<typename... Params>
+		void info(std::string_view message, const Params&... parameters) {
+			if (isEnabled(Level::Info))
+			{
+				this->format("INFO", message, parameters...);
+			}
+		}
+
+		/*!
+		 * \brief	Write a debug log, for messages of hot paths
+		 *			This will prefix all message with the DEBUG prefix
 		 */
 		template<typename... Params>
-		void info(const std::string& message, Params... parameters) {
-			this->format("INFO", message, parameters...);
+		void debug(std::string_view message, const Params&... parameters) {
+			if (isEnabled(Level::Debug))
+			{
+				this->format("DEBUG", message, parameters...);
+			}
 		}
 	};
 }
@@ -2,32 +2,122 @@
 #define __YAGI_PLUGIN__
 
 #include <idp.hpp>
+#include <kernwin.hpp>
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <thread>
+#include "codeview.hh"
 #include "decompiler.hh"
+#include "epoch.hh"
+#include "idaevent.hh"
 
 namespace yagi {
 
+	struct ViewerContext;
+	class TraceRecorder;
+	class MainThread;
+
 	/*!
 	 * \brief	IdaPlugin definition
 	 */
 	class Plugin : public plugmod_t {
 	protected:
 		/*!
-		 * \brief	the Ghidra decompiler
+		 * \brief	the Ghidra decompiler, shared with the decompilation worker
+		 */
+		std::shared_ptr<Decompiler> m_decompiler;
+
+		/*!
+		 * \brief	changes made in the IDB, shared with decompiler caches
+		 */
+		std::shared_ptr<EpochTracker> m_epochs;
+
+		/*!
+		 * \brief	gate used by the worker to query IDA
+		 */
+		std::shared_ptr<MainThread> m_mainThread;
+
+		/*!
+		 * \brief	recorder of backend answers, if enabled
+		 */
+		std::shared_ptr<TraceRecorder> m_recorder;
+
+		/*!
+		 * \brief	thread of the last decompilation
+		 */
+		std::thread m_worker;
+
+		/*!
+		 * \brief	true while a decompilation is running,
+		 *			the decompiler is not reentrant
+		 */
+		std::shared_ptr<std::atomic<bool>> m_busy;
+
+		/*!
+		 * \brief	IDB hook that feeds the epoch tracker
+		 */
+		IdaEventListener m_listener;
+
+		/*!
+		 * \brief	timer of the background type import, if running
+		 */
+		qtimer_t m_importTimer;
+
+		/*!
+		 * \brief	last reported step of the type import (in tenth)
+		 */
+		size_t m_importStep;
+
+		/*!
+		 * \brief	timer that refreshes opened views after IDB changes
+		 */
+		qtimer_t m_refreshTimer;
+
+		/*!
+		 * \brief	epoch of the last refresh of opened views
 		 */
-		std::unique_ptr<Decompiler> m_decompiler;
+		uint64_t m_refreshEpoch;
+
+		/*!
+		 * \brief	opened decompiler views by name, refreshed in place
+		 */
+		ViewRegistry<ViewerContext> m_views;
+
+		/*!
+		 * \brief	Run a task with the decompiler in the worker thread
+		 *			the task must not use the plugin outside of the main thread
+		 * \param	task	task to run
+		 * \return	false if a decompilation is already running
+		 */
+		bool startWorker(std::function<void(Decompiler&)> task);
 
 	public:
 		/*!
 		 * \brief	Plugin ctor
+		 * \param	decompiler	the decompiler backend
+		 * \param	epochs	tracker shared with the decompiler
+		 * \param	mainThread	gate used by the decompiler to query IDA
+		 * \param	recorder	recorder of backend answers, null if disabled
 		 */
-		explicit Plugin(std::unique_ptr<Decompiler> decompiler);
+		explicit Plugin(std::unique_ptr<Decompiler> decompiler, std::shared_ptr<EpochTracker> epochs, std::shared_ptr<MainThread> mainThread, std::shared_ptr<TraceRecorder> recorder = nullptr);
+
+		/*!
+		 * \brief	Check if an option is set on the command line
+		 *			using -Oyagi:option1:option2
+		 * \param	option	name of the option
+		 * \return	true if the option is present
+		 */
+		static bool hasOption(const std::string& option);
 
 		/*!
 		 * \brief	destructor
+		 *			cancel a running decompilation and wait for it
 		 */
-		virtual ~Plugin() = default;
+		virtual ~Plugin();
 
 		/*!
 		 * \brief	copy id disable
@@ -43,13 +133,63 @@ namespace yagi {
 
 		/*!
 		 * \brief	Run the plugin API
+		 *			decompile current function, export types if arg is 1,
+		 *			export the profiling report if arg is 2,
+		 *			decompile with the preview profile if arg is 3,
+		 *			export the backend trace if arg is 4,
+		 *			decompile every function if arg is 5
+		 *			Decompilation runs in a worker thread,
+		 *			the view is displayed when it's done
 		 */
 		virtual bool idaapi run(size_t) override;
 
 		/*!
 		 * \brief	View decompilation
+		 *			lines are rendered on demand, only when visible
+		 *			an opened view of the same function is updated in place
+		 * \param	code	decompilation, shared with the viewer
+		 */
+		void view(std::shared_ptr<const Decompiler::Result> code);
+
+		/*!
+		 * \brief	Import a slice of types and report progress
+		 * \return	true if there are still types to import
+		 */
+		bool importTypes();
+
+		/*!
+		 * \brief	Decompile again, in the worker, the opened views
+		 *			whose dependencies changed since the last check
+		 */
+		void refreshViews();
+
+		/*!
+		 * \brief	Update the opened view of a function in place
+		 *			nothing is done if the function is not opened
+		 * \param	code	new decompilation
+		 */
+		void refreshView(std::shared_ptr<const Decompiler::Result> code);
+
+		/*!
+		 * \brief	Decompile every function of the IDB, callees first,
+		 *			so callers use the prototypes recovered from their callees
+		 */
+		void decompileAll();
+
+		/*!
+		 * \brief	Ask a file and export the type database of the IDB
+		 */
+		void exportTypes() const;
+
+		/*!
+		 * \brief	Ask a file and export the profiling report of the session
+		 */
+		void exportProfile() const;
+
+		/*!
+		 * \brief	Ask a file and export the backend trace of the session
 		 */
-		void view(const std::string& name, const Decompiler::Result& code) const;
+		void exportTrace() const;
 	};
 }
 
@@ -0,0 +1,191 @@
+#ifndef __YAGI_PROFILER__
+#define __YAGI_PROFILER__
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Measures of a decompilation stage, an action or a rule
+	 */
+	struct ProfileEntry
+	{
+		/*!
+		 * \brief	stage name, followed by the action or rule name
+		 */
+		std::string name;
+
+		/*!
+		 * \brief	number of measures merged into this entry
+		 */
+		uint64_t calls;
+
+		/*!
+		 * \brief	wall time, only measured for stages
+		 */
+		std::chrono::nanoseconds time;
+
+		/*!
+		 * \brief	number of times the action or rule was tried
+		 */
+		uint64_t tests;
+
+		/*!
+		 * \brief	number of times the action or rule applied
+		 */
+		uint64_t applies;
+
+		/*!
+		 * \brief	number of changes made by a stage
+		 */
+		uint64_t changes;
+	};
+
+	/*!
+	 * \brief	Aggregated measures, for a function or a whole session
+	 */
+	class ProfileReport
+	{
+	protected:
+		/*!
+		 * \brief	entries by name
+		 */
+		std::map<std::string, ProfileEntry> m_entries;
+
+		/*!
+		 * \brief	number of decompiled functions
+		 */
+		size_t m_functions;
+
+	public:
+		explicit ProfileReport();
+
+		/*!
+		 * \brief	Add an entry, summed with the entry of the same name
+		 */
+		void add(const ProfileEntry& entry);
+
+		/*!
+		 * \brief	Add every entries of another report
+		 */
+		void merge(const ProfileReport& other);
+
+		/*!
+		 * \brief	Remove all entries
+		 */
+		void clear();
+
+		/*!
+		 * \brief	Entries sorted by time, then by applies and tests
+		 *			the most expensive first
+		 */
+		std::vector<ProfileEntry> getSorted() const;
+
+		/*!
+		 * \brief	number of decompiled functions in the report
+		 */
+		size_t getFunctionCount() const;
+
+		/*!
+		 * \brief	Write the report as a table
+		 */
+		void toText(std::ostream& out) const;
+
+		/*!
+		 * \brief	Write the report as a JSON object
+		 */
+		void toJson(std::ostream& out) const;
+	};
+
+	/*!
+	 * \brief	Collect measures of YagiArchitecture::performActions
+	 *			Stages are timed, actions and rules are counted
+	 *			from ghidra statistics
+	 */
+	class Profiler
+	{
+	protected:
+		/*!
+		 * \brief	name of the function being profiled
+		 */
+		std::string m_function;
+
+		/*!
+		 * \brief	measures of the function being profiled
+		 */
+		ProfileReport m_current;
+
+		/*!
+		 * \brief	measures of the last profiled function
+		 */
+		ProfileReport m_last;
+
+		/*!
+		 * \brief	measures of all profiled functions
+		 */
+		ProfileReport m_session;
+
+	public:
+		explicit Profiler() = default;
+
+		/*!
+		 * \brief	Start to profile a function
+		 * \param	function	name of the function
+		 */
+		void begin(const std::string& function);
+
+		/*!
+		 * \brief	End to profile the current function
+		 *			and aggregate it into the session
+		 */
+		void end();
+
+		/*!
+		 * \brief	Add the wall time of a stage
+		 * \param	stage	name of the stage
+		 * \param	time	wall time
+		 * \param	changes	number of changes made by the stage
+		 */
+		void addStage(const std::string& stage, std::chrono::nanoseconds time, int64_t changes);
+
+		/*!
+		 * \brief	Add counters
+		 * \param	name	name of the counter
+		 * \param	tests	number of tries
+		 * \param	applies	number of applies
+		 */
+		void addCounter(const std::string& name, uint64_t tests, uint64_t applies);
+
+		/*!
+		 * \brief	Parse the output of ghidra Action::printStatistics
+		 *			one line per action : "name Tested=x Apply=y"
+		 *			or per rule : "name Tested=x Applied=y"
+		 * \param	stage	stage of the actions
+		 * \param	statistics	printed statistics
+		 */
+		void addStatistics(const std::string& stage, std::istream& statistics);
+
+		/*!
+		 * \brief	name of the last profiled function
+		 */
+		const std::string& getLastFunction() const;
+
+		/*!
+		 * \brief	report of the last profiled function
+		 */
+		const ProfileReport& getLastReport() const;
+
+		/*!
+		 * \brief	report of all profiled functions
+		 */
+		const ProfileReport& getSessionReport() const;
+	};
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef __YAGI_PROTOTYPESTORE__
+#define __YAGI_PROTOTYPESTORE__
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Prototype of a function recovered by a decompilation
+	 *			Types are saved as Ghidra XML to be restored
+	 *			by any architecture of the same language
+	 */
+	struct RecoveredPrototype
+	{
+		/*!
+		 * \brief	confidence needed to lock a prototype inferred from call sites,
+		 *			a single call site is only a hint
+		 */
+		static constexpr uint32_t LOCK_CONFIDENCE = 2;
+
+		/*!
+		 * \brief	where the prototype was recovered, by increasing reliability
+		 */
+		enum class Source
+		{
+			/*!
+			 * \brief	inferred from a call while decompiling a caller
+			 */
+			CallSite,
+
+			/*!
+			 * \brief	recovered by the decompilation of the function itself
+			 */
+			Decompilation
+		};
+
+		/*!
+		 * \brief	name of the prototype model (calling convention)
+		 */
+		std::string model;
+
+		/*!
+		 * \brief	return type
+		 */
+		std::string output;
+
+		/*!
+		 * \brief	type of each parameter
+		 */
+		std::vector<std::string> inputs;
+
+		/*!
+		 * \brief	name of each parameter
+		 */
+		std::vector<std::string> names;
+
+		bool isDotDotDot;
+
+		Source source;
+
+		/*!
+		 * \brief	number of recoveries that agree with this one,
+		 *			call sites count once per caller
+		 */
+		uint32_t confidence;
+
+		/*!
+		 * \brief	entry points of the callers that agree with a call site prototype
+		 */
+		std::set<uint64_t> callers;
+
+		/*!
+		 * \brief	entry points of the callers that guessed another prototype
+		 */
+		std::set<uint64_t> dissenters;
+
+		/*!
+		 * \brief	epoch of the recovery, the prototype is stale
+		 *			once the function or a type changes in the backend
+		 */
+		uint64_t epoch;
+
+		/*!
+		 * \brief	true if the prototype is reliable enough to be locked,
+		 *			a guess of too few callers is only a hint
+		 */
+		bool isLocked() const noexcept
+		{
+			return source == Source::Decompilation || confidence >= LOCK_CONFIDENCE;
+		}
+	};
+
+	/*!
+	 * \brief	Prototypes recovered by decompilations, shared by decompilers
+	 *			Callees are decompiled first, so their callers
+	 *			use the recovered prototypes instead of guessing them
+	 */
+	class PrototypeStore
+	{
+	protected:
+		mutable std::shared_mutex m_mutex;
+		std::map<uint64_t, RecoveredPrototype> m_prototypes;
+
+		/*!
+		 * \brief	version of the retained prototype of each function,
+		 *			increased each time the prototype applied to the function changes
+		 */
+		std::map<uint64_t, uint64_t> m_versions;
+
+	public:
+		/*!
+		 * \brief	Publish the prototype of a function
+		 *			A stale prototype is replaced, otherwise the most reliable source wins
+		 *			Callers that agree on the number of parameters
+		 *			raise the confidence, the others lower it until replaced
+		 *			A caller votes once, whatever its number of calls or decompilations
+		 * \param	ea	entry point of the function
+		 * \param	prototype	recovered prototype
+		 * \param	validSince	prototypes older than this epoch are stale
+		 */
+		void publish(uint64_t ea, RecoveredPrototype prototype, uint64_t validSince);
+
+		/*!
+		 * \brief	Find the prototype of a function
+		 * \param	ea	entry point of the function
+		 * \param	validSince	prototypes older than this epoch are stale
+		 * \return	the retained prototype, if any and not stale
+		 */
+		std::optional<RecoveredPrototype> find(uint64_t ea, uint64_t validSince) const;
+
+		/*!
+		 * \brief	Version of the prototype of a function
+		 *			Decompilations that consulted an older version are stale
+		 * \param	ea	entry point of the function
+		 * \return	0 if nothing was ever published for the function
+		 */
+		uint64_t getVersion(uint64_t ea) const;
+
+		/*!
+		 * \brief	number of published prototypes
+		 */
+		size_t size() const;
+	};
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef __YAGI_SCHEDULER__
+#define __YAGI_SCHEDULER__
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "callgraph.hh"
+
+namespace yagi
+{
+	/*!
+	 * \brief	Run a job on every function of a call graph, callees first
+	 *			A strongly connected component is a task, it is ready
+	 *			when all components it calls are done
+	 *			Each worker owns a queue of ready tasks, an idle worker
+	 *			steals the oldest task of another worker
+	 */
+	class CallGraphScheduler
+	{
+	public:
+		/*!
+		 * \brief	job done on a component, functions of a component
+		 *			call each other and are given together
+		 */
+		using Job = std::function<void(const std::vector<uint64_t>& component)>;
+
+	protected:
+		/*!
+		 * \brief	number of workers, the calling thread included
+		 */
+		size_t m_workers;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	workers	number of workers, the calling thread is one of them
+		 */
+		explicit CallGraphScheduler(size_t workers);
+
+		/*!
+		 * \brief	Run a job on every component of the graph
+		 *			A job is never run before the jobs of its callees
+		 *			Jobs must be thread safe if there are many workers
+		 * \param	graph	call graph of the functions
+		 * \param	job	job run on each component
+		 * \raise	the first exception raised by a job, remaining jobs are canceled
+		 */
+		void run(const CallGraph& graph, const Job& job) const;
+	};
+}
+
+#endif
@@ -6,6 +6,8 @@
 #include <libdecomp.hh>
 #include "yagiarchitecture.hh"
 
+#include <set>
+
 namespace yagi 
 {
 	class YagiScope : public Scope
@@ -17,6 +19,12 @@ namespace yagi
 		 */
 		ScopeInternal m_proxy;
 
+		/*!
+		 * \brief	symbols that don't come from the backend
+		 *			like eBPF helpers, kept when the proxy is cleared
+		 */
+		ScopeInternal m_persistent;
+
 		/*!
 		 * \brief	Unimplemented 
 		 */
@@ -79,6 +87,26 @@ namespace yagi
 		 * \brief	return the proxy object for proxy pattern
 		 */
 		ScopeInternal* getProxy();
+
+		/*!
+		 * \brief	return the persistent layer, searched after the proxy
+		 */
+		ScopeInternal* getPersistent();
+
+		/*!
+		 * \brief	clear the persistent layer
+		 *			must be done when types used by its symbols are destroyed
+		 */
+		void clearPersistent();
+
+		/*!
+		 * \brief	Drop the cached symbols built from changed backend data
+		 *			Functions are dropped on any type change,
+		 *			their prototype and local scope may use a stale type
+		 * \param	addresses	addresses changed in the backend
+		 * \param	types	types that will be destroyed
+		 */
+		void invalidate(const std::set<uint64_t>& addresses, const std::set<Datatype*>& types);
 		
 		/*!
 		 * \param	addr	address of the symbol
@@ -132,6 +160,7 @@ namespace yagi
 		 * \brief	clear the cache
 		 *			Actually we used a global scope for only one function
 		 *			because we serve as proxy for IDA
+		 *			The persistent layer is kept
 		 */
 		void clear(void) override;
 
@@ -0,0 +1,49 @@
+#ifndef __YAGI_SYMBOLCOLLECTOR__
+#define __YAGI_SYMBOLCOLLECTOR__
+
+#include <map>
+#include <string>
+#include "decompiler.hh"
+
+class Funcdata;
+
+namespace yagi 
+{
+	/*!
+	 * \brief	Find symbols of a decompiled function and where they are used
+	 *			Symbols are used to navigate from the decompiled code
+	 */
+	class SymbolCollector
+	{
+	public:
+		/*!
+		 * \brief	Find all symbols of a decompiled function
+		 * \param	data	the source function
+		 * \return	symbols indexed by name
+		 */
+		static std::map<std::string, MemoryLocation> collect(const Funcdata& data);
+
+		/*!
+		 * \brief	Find high level variable and defined address
+		 * \param	data	the source function
+		 * \param	symbols	the output list of symbols
+		 */
+		static void findVarSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols);
+
+		/*!
+		 * \brief	Find calling function and populate the sylbol map
+		 * \param	data	the source function
+		 * \param	symbols	the output map populate by algo
+		 */
+		static void findFunctionSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols);
+
+		/*!
+		 * \param	Trying to find Constant symbols
+		 * \param	data	the source function
+		 * \param	symbols	the output symbol maps
+		 */
+		static void findConstantSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols);
+	};
+}
+
+#endif
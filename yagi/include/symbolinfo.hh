@@ -5,6 +5,7 @@
 #include <tuple>
 #include <string>
 #include <memory>
+#include <vector>
 #include "decompiler.hh"
 
 namespace yagi 
@@ -116,6 +117,58 @@ namespace yagi
 		virtual bool isReadOnly() const noexcept = 0;
 	};
 
+	/*!
+	 * \brief	A name stored for a local variable of a function
+	 */
+	struct LocalName
+	{
+		/*!
+		 * \brief	name of the memory space (register, stack, unique, const)
+		 */
+		std::string space;
+
+		/*!
+		 * \brief	use address of the variable
+		 */
+		uint64_t pc;
+
+		/*!
+		 * \brief	offset in the memory space
+		 */
+		uint64_t offset;
+
+		/*!
+		 * \brief	the stored name
+		 */
+		std::string name;
+	};
+
+	/*!
+	 * \brief	A type stored for a local variable of a function
+	 */
+	struct LocalType
+	{
+		/*!
+		 * \brief	name of the memory space (register, stack, unique, const)
+		 */
+		std::string space;
+
+		/*!
+		 * \brief	use address of the variable
+		 */
+		uint64_t pc;
+
+		/*!
+		 * \brief	offset in the memory space
+		 */
+		uint64_t offset;
+
+		/*!
+		 * \brief	the stored type
+		 */
+		std::unique_ptr<TypeInfo> type;
+	};
+
 	class FunctionSymbolInfo
 	{
 	protected:
@@ -201,6 +254,20 @@ namespace yagi
 		 * \return	if found the offset into memory space and the linked type
 		 */
 		virtual std::optional<std::unique_ptr<TypeInfo>> findType(uint64_t pc, const std::string& from, uint64_t& offset) = 0;
+
+		/*!
+		 * \brief	Load every stored local name of the function at once
+		 *			Use to resolve all spaces in a single pass over pcode
+		 * \return	all stored names, in any space
+		 */
+		virtual std::vector<LocalName> getLocalNames() = 0;
+
+		/*!
+		 * \brief	Load every stored local type of the function at once
+		 *			Use to resolve all spaces in a single pass over pcode
+		 * \return	all stored types, in any space
+		 */
+		virtual std::vector<LocalType> getLocalTypes() = 0;
 	};
 
 	/*!
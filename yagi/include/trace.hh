@@ -0,0 +1,395 @@
+#ifndef __YAGI_TRACE__
+#define __YAGI_TRACE__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "loader.hh"
+#include "symbolinfo.hh"
+#include "typeinfo.hh"
+#include "typedatabase.hh"
+
+namespace yagi
+{
+	/*!
+	 * \brief	On disk layout of a backend trace
+	 *			A trace is a type database followed by the trace section
+	 *			and a footer giving the offset of the section
+	 */
+	namespace trace
+	{
+		/*!
+		 * \brief	signature of the footer
+		 */
+		static const char MAGIC[8] = { 'Y', 'A', 'G', 'I', 'T', 'R', 'C', '\0' };
+
+		/*!
+		 * \brief	current version of the trace section
+		 */
+		static const uint32_t VERSION = 1;
+	}
+
+	/*!
+	 * \brief	A symbol as answered by the backend
+	 */
+	struct TraceSymbol
+	{
+		uint64_t ea;
+		std::string name;
+
+		/*!
+		 * \brief	size of the function, none if the symbol is not a function
+		 */
+		std::optional<uint64_t> functionSize;
+
+		bool isFunction;
+		bool isLabel;
+		bool isImport;
+		bool isReadOnly;
+
+		/*!
+		 * \brief	Capture every answer of a symbol at once
+		 */
+		static TraceSymbol capture(const SymbolInfo& symbol);
+	};
+
+	/*!
+	 * \brief	A local type answered by a function
+	 */
+	struct TraceLocalType
+	{
+		std::string space;
+		uint64_t pc;
+		uint64_t offset;
+
+		/*!
+		 * \brief	index of the type in the type database
+		 */
+		uint32_t type;
+	};
+
+	/*!
+	 * \brief	Answers of a function symbol
+	 */
+	struct TraceFunction
+	{
+		TraceSymbol symbol;
+
+		/*!
+		 * \brief	stack variable names by offset and address size
+		 */
+		std::map<std::tuple<uint64_t, uint32_t>, std::optional<std::string>> stackVars;
+
+		/*!
+		 * \brief	local names and their offset by use address and space
+		 */
+		std::map<std::tuple<uint64_t, std::string>, std::optional<std::tuple<std::string, uint64_t>>> names;
+
+		/*!
+		 * \brief	local type indexes and their offset by use address and space
+		 */
+		std::map<std::tuple<uint64_t, std::string>, std::optional<std::tuple<uint32_t, uint64_t>>> types;
+
+		/*!
+		 * \brief	all local names, if they were asked
+		 */
+		std::optional<std::vector<LocalName>> localNames;
+
+		/*!
+		 * \brief	all local types, if they were asked
+		 */
+		std::optional<std::vector<TraceLocalType>> localTypes;
+	};
+
+	/*!
+	 * \brief	Every answer of a backend during a session
+	 *			except types, kept in a type database
+	 */
+	struct TraceContent
+	{
+		/*!
+		 * \brief	architecture of the session
+		 */
+		std::string sleighId;
+		std::string defaultCC;
+
+		/*!
+		 * \brief	loaded bytes by space name then offset
+		 *			contiguous reads are merged in one chunk
+		 */
+		std::map<std::string, std::map<uint64_t, std::vector<uint8_t>>> memory;
+
+		/*!
+		 * \brief	symbols by address, none if the backend found nothing
+		 */
+		std::map<uint64_t, std::optional<TraceSymbol>> symbols;
+
+		/*!
+		 * \brief	address of the function containing an address
+		 */
+		std::map<uint64_t, std::optional<uint64_t>> functionLookups;
+
+		/*!
+		 * \brief	functions by address
+		 */
+		std::map<uint64_t, TraceFunction> functions;
+
+		/*!
+		 * \brief	type names, if they were asked
+		 */
+		std::optional<std::vector<std::string>> typeNames;
+
+		/*!
+		 * \brief	Add loaded bytes, merged with overlapping or adjacent chunks
+		 */
+		void addMemory(const std::string& space, uint64_t offset, const uint8_t* bytes, size_t size);
+
+		/*!
+		 * \brief	Read loaded bytes
+		 * \return	false if bytes were not all loaded during the session
+		 */
+		bool readMemory(const std::string& space, uint64_t offset, uint8_t* bytes, size_t size) const;
+
+		/*!
+		 * \brief	Build the trace section
+		 */
+		std::vector<uint8_t> serialize() const;
+
+		/*!
+		 * \brief	Parse a trace section
+		 * \param	path	use for error message
+		 * \raise	InvalidTrace
+		 */
+		static TraceContent deserialize(const uint8_t* data, size_t size, const std::string& path);
+	};
+
+	/*!
+	 * \brief	Collect answers of the recording decorators
+	 */
+	class TraceRecorder
+	{
+	protected:
+		TraceContent m_content;
+		TypeDatabaseWriter m_types;
+
+	public:
+		/*!
+		 * \brief	Set the architecture replay will use
+		 */
+		void setArchitecture(const std::string& sleighId, const std::string& defaultCC);
+
+		/*!
+		 * \brief	content recorded so far
+		 */
+		TraceContent& getContent();
+
+		/*!
+		 * \brief	Add a type answered by the backend
+		 * \return	index of the type in the type database
+		 */
+		uint32_t addType(const TypeInfo& type);
+
+		/*!
+		 * \brief	Add a type answered for a name
+		 */
+		void addNamedType(const std::string& name, const TypeInfo& type);
+
+		/*!
+		 * \brief	Add a type answered for an address
+		 */
+		void addAddressType(uint64_t ea, const TypeInfo& type);
+
+		/*!
+		 * \brief	Write the trace into a file
+		 * \param	path	path of the file
+		 * \raise	InvalidTrace	if the file can't be written
+		 */
+		void save(const std::string& path) const;
+	};
+
+	/*!
+	 * \brief	A trace loaded for replay
+	 */
+	class TraceReplay
+	{
+	protected:
+		TraceContent m_content;
+		std::shared_ptr<const TypeDatabase> m_types;
+
+		TraceReplay(TraceContent content, std::unique_ptr<TypeDatabase> types);
+
+	public:
+		/*!
+		 * \brief	Load a trace file
+		 * \param	path	path of the file
+		 * \raise	InvalidTrace, InvalidTypeDatabase
+		 */
+		static std::shared_ptr<const TraceReplay> load(const std::string& path);
+
+		const TraceContent& getContent() const;
+		const std::shared_ptr<const TypeDatabase>& getTypes() const;
+	};
+
+	/*!
+	 * \brief	Record every byte loaded by another loader
+	 */
+	class RecordingLoaderFactory : public LoaderFactory
+	{
+	protected:
+		std::unique_ptr<LoaderFactory> m_inner;
+		std::shared_ptr<TraceRecorder> m_recorder;
+
+	public:
+		explicit RecordingLoaderFactory(std::unique_ptr<LoaderFactory> inner, std::shared_ptr<TraceRecorder> recorder);
+		LoadImage* build() override;
+	};
+
+	/*!
+	 * \brief	Record every symbol found by another factory
+	 */
+	class RecordingSymbolInfoFactory : public SymbolInfoFactory
+	{
+	protected:
+		std::unique_ptr<SymbolInfoFactory> m_inner;
+		std::shared_ptr<TraceRecorder> m_recorder;
+
+	public:
+		explicit RecordingSymbolInfoFactory(std::unique_ptr<SymbolInfoFactory> inner, std::shared_ptr<TraceRecorder> recorder);
+		std::optional<std::unique_ptr<SymbolInfo>> find(uint64_t ea) override;
+		std::optional<std::unique_ptr<FunctionSymbolInfo>> find_function(uint64_t ea) override;
+	};
+
+	/*!
+	 * \brief	Record every answer of a function symbol
+	 *			Edits are forwarded, the next answers are recorded
+	 */
+	class RecordingFunctionSymbolInfo : public FunctionSymbolInfo
+	{
+	protected:
+		std::unique_ptr<FunctionSymbolInfo> m_inner;
+		std::shared_ptr<TraceRecorder> m_recorder;
+
+		/*!
+		 * \brief	recorded function, owned by the recorder
+		 */
+		TraceFunction* m_function;
+
+	public:
+		explicit RecordingFunctionSymbolInfo(std::unique_ptr<FunctionSymbolInfo> inner, std::shared_ptr<TraceRecorder> recorder, TraceFunction* function);
+
+		std::optional<std::string> findStackVar(uint64_t offset, uint32_t addrSize) override;
+		std::optional<std::string> findName(uint64_t pc, const std::string& space, uint64_t& offset) override;
+		void saveName(const MemoryLocation& loc, const std::string& space) override;
+		void saveType(const MemoryLocation& loc, const TypeInfo& newType) override;
+		bool clearType(const MemoryLocation& loc) override;
+		std::optional<std::unique_ptr<TypeInfo>> findType(uint64_t pc, const std::string& from, uint64_t& offset) override;
+		std::vector<LocalName> getLocalNames() override;
+		std::vector<LocalType> getLocalTypes() override;
+	};
+
+	/*!
+	 * \brief	Record every type built by another factory
+	 */
+	class RecordingTypeInfoFactory : public TypeInfoFactory
+	{
+	protected:
+		std::unique_ptr<TypeInfoFactory> m_inner;
+		std::shared_ptr<TraceRecorder> m_recorder;
+
+	public:
+		explicit RecordingTypeInfoFactory(std::unique_ptr<TypeInfoFactory> inner, std::shared_ptr<TraceRecorder> recorder);
+		std::optional<std::unique_ptr<TypeInfo>> build(const std::string& name) override;
+		std::optional<std::unique_ptr<TypeInfo>> build(uint64_t ea) override;
+		std::vector<std::string> getTypeNames() override;
+	};
+
+	/*!
+	 * \brief	Serve loaded bytes from a trace
+	 */
+	class ReplayLoaderFactory : public LoaderFactory
+	{
+	protected:
+		std::shared_ptr<const TraceReplay> m_replay;
+
+	public:
+		explicit ReplayLoaderFactory(std::shared_ptr<const TraceReplay> replay);
+		LoadImage* build() override;
+	};
+
+	/*!
+	 * \brief	A symbol read from a trace
+	 */
+	class ReplaySymbolInfo : public SymbolInfo
+	{
+	protected:
+		TraceSymbol m_symbol;
+
+	public:
+		explicit ReplaySymbolInfo(TraceSymbol symbol);
+
+		uint64_t getFunctionSize() const override;
+		bool isFunction() const noexcept override;
+		bool isLabel() const noexcept override;
+		bool isImport() const noexcept override;
+		bool isReadOnly() const noexcept override;
+	};
+
+	/*!
+	 * \brief	A function symbol read from a trace
+	 *			Replay is read only, edits are ignored
+	 */
+	class ReplayFunctionSymbolInfo : public FunctionSymbolInfo
+	{
+	protected:
+		std::shared_ptr<const TraceReplay> m_replay;
+		const TraceFunction& m_function;
+
+	public:
+		explicit ReplayFunctionSymbolInfo(std::shared_ptr<const TraceReplay> replay, const TraceFunction& function);
+
+		std::optional<std::string> findStackVar(uint64_t offset, uint32_t addrSize) override;
+		std::optional<std::string> findName(uint64_t pc, const std::string& space, uint64_t& offset) override;
+		void saveName(const MemoryLocation& loc, const std::string& space) override;
+		void saveType(const MemoryLocation& loc, const TypeInfo& newType) override;
+		bool clearType(const MemoryLocation& loc) override;
+		std::optional<std::unique_ptr<TypeInfo>> findType(uint64_t pc, const std::string& from, uint64_t& offset) override;
+		std::vector<LocalName> getLocalNames() override;
+		std::vector<LocalType> getLocalTypes() override;
+	};
+
+	/*!
+	 * \brief	Serve symbols from a trace
+	 */
+	class ReplaySymbolInfoFactory : public SymbolInfoFactory
+	{
+	protected:
+		std::shared_ptr<const TraceReplay> m_replay;
+
+	public:
+		explicit ReplaySymbolInfoFactory(std::shared_ptr<const TraceReplay> replay);
+		std::optional<std::unique_ptr<SymbolInfo>> find(uint64_t ea) override;
+		std::optional<std::unique_ptr<FunctionSymbolInfo>> find_function(uint64_t ea) override;
+	};
+
+	/*!
+	 * \brief	Serve types from a trace
+	 */
+	class ReplayTypeInfoFactory : public TypeInfoFactory
+	{
+	protected:
+		std::shared_ptr<const TraceReplay> m_replay;
+
+	public:
+		explicit ReplayTypeInfoFactory(std::shared_ptr<const TraceReplay> replay);
+		std::optional<std::unique_ptr<TypeInfo>> build(const std::string& name) override;
+		std::optional<std::unique_ptr<TypeInfo>> build(uint64_t ea) override;
+		std::vector<std::string> getTypeNames() override;
+	};
+}
+
+#endif
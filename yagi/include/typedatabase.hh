@@ -0,0 +1,487 @@
+#ifndef __YAGI_TYPEDATABASE__
+#define __YAGI_TYPEDATABASE__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "typeinfo.hh"
+
+namespace yagi
+{
+	/*!
+	 * \brief	On disk layout of a type database
+	 *			All records are fixed size, packed and stored in host byte order
+	 *			so a database is only portable between hosts of the same endianness
+	 *			Strings are stored in a pool as a 32 bits length followed by bytes
+	 */
+	namespace typedb
+	{
+		/*!
+		 * \brief	file signature
+		 */
+		static const char MAGIC[8] = { 'Y', 'A', 'G', 'I', 'T', 'D', 'B', '\0' };
+
+		/*!
+		 * \brief	current version of the format
+		 */
+		static const uint32_t VERSION = 1;
+
+		/*!
+		 * \brief	value of an absent index or string
+		 */
+		static const uint32_t NONE = 0xffffffff;
+
+		/*!
+		 * \brief	Kind of a type, checked in the same order as TypeManager
+		 */
+		enum class Kind : uint32_t
+		{
+			Unknown,
+			Pointer,
+			Bool,
+			Unicode,
+			Char,
+			Int,
+			Float,
+			Struct,
+			Void,
+			Function,
+			Array
+		};
+
+		/*!
+		 * \brief	type flags
+		 */
+		enum Flags : uint32_t
+		{
+			FLAG_CONST = 1,
+			FLAG_DOTDOTDOT = 2
+		};
+
+#pragma pack(push, 1)
+		struct Header
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t typeCount;
+			uint32_t memberCount;
+			uint32_t nameCount;
+			uint32_t addressCount;
+			uint32_t reserved;
+			uint64_t typesOffset;
+			uint64_t membersOffset;
+			uint64_t namesOffset;
+			uint64_t addressesOffset;
+			uint64_t stringsOffset;
+			uint64_t stringsSize;
+		};
+
+		/*!
+		 * \brief	A type
+		 *			target is the pointed type, the array element or the return type
+		 *			members are struct fields or function parameters
+		 */
+		struct TypeRecord
+		{
+			uint32_t name;
+			uint32_t kind;
+			uint64_t size;
+			uint32_t target;
+			uint32_t flags;
+			uint64_t count;
+			uint32_t firstMember;
+			uint32_t memberCount;
+			uint32_t callingConv;
+			uint32_t reserved;
+		};
+
+		/*!
+		 * \brief	A struct field or a function parameter
+		 */
+		struct MemberRecord
+		{
+			uint32_t name;
+			uint32_t type;
+			uint64_t offset;
+		};
+
+		/*!
+		 * \brief	Named type, sorted by name
+		 */
+		struct NameRecord
+		{
+			uint32_t name;
+			uint32_t type;
+		};
+
+		/*!
+		 * \brief	Type of an address, sorted by address
+		 */
+		struct AddressRecord
+		{
+			uint64_t ea;
+			uint32_t type;
+			uint32_t reserved;
+		};
+#pragma pack(pop)
+	}
+
+	class TypeDatabaseWriter;
+
+	/*!
+	 * \brief	Read only view of a type database file
+	 *			The file is mapped in memory, nothing is copied
+	 */
+	class TypeDatabase
+	{
+	protected:
+		/*!
+		 * \brief	start of the mapped file
+		 */
+		const uint8_t* m_data;
+
+		/*!
+		 * \brief	size of the mapped file
+		 */
+		size_t m_size;
+
+		/*!
+		 * \brief	platform handle of the mapping
+		 */
+		void* m_mapping;
+
+		const typedb::Header* m_header;
+		const typedb::TypeRecord* m_types;
+		const typedb::MemberRecord* m_members;
+		const typedb::NameRecord* m_names;
+		const typedb::AddressRecord* m_addresses;
+
+		/*!
+		 * \brief	content of a snapshot, empty if the file is mapped
+		 */
+		std::vector<uint8_t> m_buffer;
+
+		/*!
+		 * \brief	backend key of each type of a snapshot
+		 */
+		std::vector<std::string> m_keys;
+
+		/*!
+		 * \brief	ctor use by load
+		 */
+		TypeDatabase(const uint8_t* data, size_t size, void* mapping);
+
+		/*!
+		 * \brief	Check header and bounds of every table
+		 * \param	path	use for error message
+		 * \raise	InvalidTypeDatabase
+		 */
+		void check(const std::string& path);
+
+	public:
+		/*!
+		 * \brief	Map a type database file in memory
+		 * \param	path	path of the file
+		 * \return	the database
+		 * \raise	InvalidTypeDatabase
+		 */
+		static std::unique_ptr<TypeDatabase> load(const std::string& path);
+
+		/*!
+		 * \brief	Build a database in memory from types added to a writer
+		 *			Types keep the key of their backend, so a snapshot
+		 *			translates into the same ghidra types as the backend
+		 * \param	writer	types of the snapshot
+		 * \return	the database
+		 */
+		static std::unique_ptr<TypeDatabase> snapshot(const TypeDatabaseWriter& writer);
+
+		/*!
+		 * \brief	dtor, unmap the file
+		 */
+		~TypeDatabase();
+
+		/*!
+		 * \brief	Copy is forbidden, mapping is owned
+		 */
+		TypeDatabase(const TypeDatabase&) = delete;
+		TypeDatabase& operator=(const TypeDatabase&) = delete;
+
+		/*!
+		 * \brief	Move is forbidden, type informations keep a pointer on it
+		 */
+		TypeDatabase(TypeDatabase&&) noexcept = delete;
+		TypeDatabase& operator=(TypeDatabase&&) noexcept = delete;
+
+		/*!
+		 * \brief	get a type record
+		 */
+		const typedb::TypeRecord& getType(uint32_t index) const;
+
+		/*!
+		 * \brief	get a member record
+		 */
+		const typedb::MemberRecord& getMember(uint32_t index) const;
+
+		/*!
+		 * \brief	identity of a type
+		 * \return	backend key for a snapshot, index otherwise
+		 */
+		std::string getKey(uint32_t index) const;
+
+		/*!
+		 * \brief	get a string from the pool, without copy
+		 * \param	offset	offset of the string in the pool
+		 * \return	the string, empty if offset is NONE
+		 */
+		std::string_view getString(uint32_t offset) const;
+
+		/*!
+		 * \brief	number of named types
+		 */
+		uint32_t getNameCount() const;
+
+		/*!
+		 * \brief	get a named type record, sorted by name
+		 */
+		const typedb::NameRecord& getName(uint32_t index) const;
+
+		/*!
+		 * \brief	Find a type by its name
+		 * \param	name	name of the type
+		 * \return	index of the type if found
+		 */
+		std::optional<uint32_t> findName(std::string_view name) const;
+
+		/*!
+		 * \brief	Find the type of an address
+		 * \param	ea	address
+		 * \return	index of the type if found
+		 */
+		std::optional<uint32_t> findAddress(uint64_t ea) const;
+	};
+
+	/*!
+	 * \brief	Serialize type informations from any backend
+	 *			into the type database format
+	 */
+	class TypeDatabaseWriter
+	{
+	protected:
+		std::vector<typedb::TypeRecord> m_types;
+		std::vector<typedb::MemberRecord> m_members;
+		std::map<std::string, uint32_t, std::less<>> m_names;
+		std::map<uint64_t, uint32_t> m_addresses;
+
+		/*!
+		 * \brief	index of already written types by type key
+		 */
+		std::map<std::string, uint32_t> m_indexes;
+
+		/*!
+		 * \brief	string pool and offset of already written strings
+		 */
+		std::vector<uint8_t> m_strings;
+		std::map<std::string, uint32_t, std::less<>> m_stringOffsets;
+
+		/*!
+		 * \brief	Add a string in the pool
+		 * \return	offset of the string
+		 */
+		uint32_t addString(std::string_view value);
+
+	public:
+		/*!
+		 * \brief	Add a type and every type it use
+		 * \param	type	backend type information
+		 * \return	index of the type
+		 */
+		uint32_t add(const TypeInfo& type);
+
+		/*!
+		 * \brief	Add a named type, found by FileTypeInfoFactory::build(name)
+		 * \param	name	name of the type
+		 * \param	type	backend type information
+		 */
+		void addName(const std::string& name, const TypeInfo& type);
+
+		/*!
+		 * \brief	Add the type of an address, found by FileTypeInfoFactory::build(ea)
+		 * \param	ea	address
+		 * \param	type	backend type information
+		 */
+		void addAddress(uint64_t ea, const TypeInfo& type);
+
+		/*!
+		 * \brief	Build the database file content
+		 * \return	content of the file
+		 */
+		std::vector<uint8_t> serialize() const;
+
+		/*!
+		 * \brief	keys of added types, by index
+		 */
+		std::vector<std::string> getKeys() const;
+
+		/*!
+		 * \brief	Write the database into a file
+		 * \param	path	path of the file
+		 * \raise	InvalidTypeDatabase	if the file can't be written
+		 */
+		void save(const std::string& path) const;
+	};
+
+	/*!
+	 * \brief	Type information read from a type database
+	 *			it's an index that shares the ownership of its database,
+	 *			so the database lives as long as one of its types
+	 */
+	class FileTypeInfo : public TypeInfo
+	{
+		friend class FileFuncInfo;
+		friend class FileStructInfo;
+		friend class FilePtrInfo;
+		friend class FileArrayInfo;
+
+	protected:
+		std::shared_ptr<const TypeDatabase> m_database;
+		uint32_t m_index;
+
+		/*!
+		 * \brief	record of the type
+		 */
+		const typedb::TypeRecord& getRecord() const;
+
+		/*!
+		 * \brief	kind of the type
+		 */
+		typedb::Kind getKind() const;
+
+	public:
+		explicit FileTypeInfo(std::shared_ptr<const TypeDatabase> database, uint32_t index);
+
+		size_t getSize() const override;
+		std::string getName() const override;
+
+		/*!
+		 * \brief	index in the database, or backend key of a snapshot,
+		 *			identifies the type
+		 */
+		std::string getKey() const override;
+
+		bool isInt() const override;
+		bool isBool() const override;
+		bool isFloat() const override;
+		bool isVoid() const override;
+		bool isConst() const override;
+		bool isChar() const override;
+		bool isUnicode() const override;
+
+		std::optional<std::unique_ptr<FuncInfo>> toFunc() const override;
+		std::optional<std::unique_ptr<StructInfo>> toStruct() const override;
+		std::optional<std::unique_ptr<PtrInfo>> toPtr() const override;
+		std::optional<std::unique_ptr<ArrayInfo>> toArray() const override;
+
+		bool visitPointedObject(FunctionRef<void(const TypeInfo&)> visitor) const override;
+		bool visitArrayElement(FunctionRef<void(const TypeInfo&)> visitor) const override;
+		bool visitFunc(FunctionRef<void(const FuncInfo&)> visitor) const override;
+		bool visitStruct(FunctionRef<void(const StructInfo&)> visitor) const override;
+	};
+
+	/*!
+	 * \brief	Function type read from a type database
+	 */
+	class FileFuncInfo : public FuncInfo
+	{
+	protected:
+		FileTypeInfo m_info;
+
+	public:
+		explicit FileFuncInfo(FileTypeInfo info);
+
+		bool isDotDotDot() const override;
+		std::vector<std::unique_ptr<TypeInfo>> getFuncPrototype() const override;
+		std::vector<std::string> getFuncParamName() const override;
+		std::string getCallingConv() const override;
+		std::string getName() const override;
+		FunctionSignature getSignature() const override;
+
+		/*!
+		 * \brief	Visit return type then parameter types
+		 *			Types are only valid during the call of the visitor
+		 */
+		void visitPrototype(FunctionRef<void(const TypeInfo&)> visitor) const;
+	};
+
+	/*!
+	 * \brief	Structure type read from a type database
+	 */
+	class FileStructInfo : public StructInfo
+	{
+	protected:
+		FileTypeInfo m_info;
+
+	public:
+		explicit FileStructInfo(FileTypeInfo info);
+
+		std::vector<TypeStructField> getFields() const override;
+		void visitFields(FunctionRef<void(uint64_t, std::string_view, const TypeInfo&)> visitor) const override;
+	};
+
+	/*!
+	 * \brief	Pointer type read from a type database
+	 */
+	class FilePtrInfo : public PtrInfo
+	{
+	protected:
+		FileTypeInfo m_info;
+
+	public:
+		explicit FilePtrInfo(FileTypeInfo info);
+
+		std::unique_ptr<TypeInfo> getPointedObject() const override;
+	};
+
+	/*!
+	 * \brief	Array type read from a type database
+	 */
+	class FileArrayInfo : public ArrayInfo
+	{
+	protected:
+		FileTypeInfo m_info;
+
+	public:
+		explicit FileArrayInfo(FileTypeInfo info);
+
+		std::unique_ptr<TypeInfo> getPointedObject() const override;
+		uint64_t getSize() const override;
+	};
+
+	/*!
+	 * \brief	Type factory backed by a type database file
+	 *			Use for decompilation without IDA
+	 */
+	class FileTypeInfoFactory : public TypeInfoFactory
+	{
+	protected:
+		std::shared_ptr<const TypeDatabase> m_database;
+
+	public:
+		/*!
+		 * \brief	ctor
+		 * \param	database	loaded type database
+		 */
+		explicit FileTypeInfoFactory(std::unique_ptr<TypeDatabase> database);
+
+		std::optional<std::unique_ptr<TypeInfo>> build(const std::string& name) override;
+		std::optional<std::unique_ptr<TypeInfo>> build(uint64_t ea) override;
+		std::vector<std::string> getTypeNames() override;
+	};
+}
+
+#endif
@@ -2,9 +2,16 @@
 #define __YAGI_TYPEFACTORY__
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <memory>
 #include <vector>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+
+#include "exception.hh"
+#include "functionref.hh"
 
 namespace yagi 
 {
@@ -32,6 +39,13 @@ namespace yagi
 		 * \return	all type members with meta information of type declaration
 		 */
 		virtual std::vector<TypeStructField> getFields() const = 0;
+
+		/*!
+		 * \brief	Visit fields without building the whole list
+		 *			Type and name are only valid during the call of the visitor
+		 * \param	visitor	called with offset, name and type of each field
+		 */
+		virtual void visitFields(FunctionRef<void(uint64_t, std::string_view, const TypeInfo&)> visitor) const;
 	};
 
 	/*!
@@ -70,6 +84,37 @@ namespace yagi
 		virtual uint64_t getSize() const = 0;
 	};
 
+	/*!
+	 * \brief	Everything needed to build a function prototype
+	 */
+	struct FunctionSignature
+	{
+		/*!
+		 * \brief	return type, null if unknown
+		 */
+		std::unique_ptr<TypeInfo> returnType;
+
+		/*!
+		 * \brief	type of each parameter
+		 */
+		std::vector<std::unique_ptr<TypeInfo>> paramTypes;
+
+		/*!
+		 * \brief	name of each parameter
+		 */
+		std::vector<std::string> paramNames;
+
+		/*!
+		 * \brief	calling convention, if known
+		 */
+		std::optional<std::string> callingConv;
+
+		/*!
+		 * \brief	is it a varargs function
+		 */
+		bool isDotDotDot;
+	};
+
 	/*!
 	 * \brief	Function Type information interface 
 	 */
@@ -109,6 +154,13 @@ namespace yagi
 		 * \brief	Return the name of the function
 		 */
 		virtual std::string getName() const = 0;
+
+		/*!
+		 * \brief	Compute the whole signature at once
+		 *			Backends should override it to query the function type once
+		 * \return	signature of the function
+		 */
+		virtual FunctionSignature getSignature() const;
 	};
 
 	/*!
@@ -117,6 +169,8 @@ namespace yagi
 	class TypeInfo
 	{
 	public:
+		virtual ~TypeInfo() = default;
+
 		/*!
 		 * \brief	get the size of the the type in bytes 
 		 */
@@ -127,6 +181,17 @@ namespace yagi
 		 */
 		virtual std::string getName() const = 0;
 
+		/*!
+		 * \brief	canonical identity of the type in the backend
+		 *			Two type informations with the same key translate
+		 *			into the same ghidra type
+		 * \return	by default the name of the type
+		 */
+		virtual std::string getKey() const
+		{
+			return getName();
+		}
+
 		/*!
 		 * \brief	Is the type is linked to an integer
 		 * \warning	Any interger type, uint16 uin8 etc..., are integer
@@ -204,9 +269,105 @@ namespace yagi
 		 *			If it's not, the nullopt
 		 */
 		virtual std::optional<std::unique_ptr<ArrayInfo>> toArray() const = 0;
-	
+
+		/*!
+		 * \brief	If it's a pointer, visit the pointed object
+		 *			Pointed type is only valid during the call of the visitor
+		 * \param	visitor	called with the pointed type
+		 * \return	false if it's not a pointer
+		 */
+		virtual bool visitPointedObject(FunctionRef<void(const TypeInfo&)> visitor) const
+		{
+			auto ptrType = toPtr();
+			if (!ptrType.has_value())
+			{
+				return false;
+			}
+			visitor(*ptrType.value()->getPointedObject());
+			return true;
+		}
+
+		/*!
+		 * \brief	If it's an array, visit the type of its elements
+		 *			Element type is only valid during the call of the visitor
+		 * \param	visitor	called with the element type
+		 * \return	false if it's not an array
+		 */
+		virtual bool visitArrayElement(FunctionRef<void(const TypeInfo&)> visitor) const
+		{
+			auto arrayType = toArray();
+			if (!arrayType.has_value())
+			{
+				return false;
+			}
+			visitor(*arrayType.value()->getPointedObject());
+			return true;
+		}
+
+		/*!
+		 * \brief	If it's a function, visit its function view
+		 *			Function view is only valid during the call of the visitor
+		 * \param	visitor	called with the function view
+		 * \return	false if it's not a function
+		 */
+		virtual bool visitFunc(FunctionRef<void(const FuncInfo&)> visitor) const
+		{
+			auto funcType = toFunc();
+			if (!funcType.has_value())
+			{
+				return false;
+			}
+			visitor(*funcType.value());
+			return true;
+		}
+
+		/*!
+		 * \brief	If it's a structure, visit its structure view
+		 *			Structure view is only valid during the call of the visitor
+		 * \param	visitor	called with the structure view
+		 * \return	false if it's not a structure
+		 */
+		virtual bool visitStruct(FunctionRef<void(const StructInfo&)> visitor) const
+		{
+			auto structType = toStruct();
+			if (!structType.has_value())
+			{
+				return false;
+			}
+			visitor(*structType.value());
+			return true;
+		}
 	};
 
+	/**********************************************************************/
+	inline void StructInfo::visitFields(FunctionRef<void(uint64_t, std::string_view, const TypeInfo&)> visitor) const
+	{
+		for (auto& field : getFields())
+		{
+			visitor(field.offset, field.name, *field.type);
+		}
+	}
+
+	/**********************************************************************/
+	inline FunctionSignature FuncInfo::getSignature() const
+	{
+		FunctionSignature signature{ nullptr, {}, getFuncParamName(), std::nullopt, isDotDotDot() };
+		auto prototype = getFuncPrototype();
+		if (!prototype.empty())
+		{
+			signature.returnType = std::move(prototype.front());
+			std::move(prototype.begin() + 1, prototype.end(), std::back_inserter(signature.paramTypes));
+		}
+
+		try
+		{
+			signature.callingConv = getCallingConv();
+		}
+		catch (UnknownCallingConvention&) {}
+
+		return signature;
+	}
+
 	class TypeInfoFactory
 	{
 	public:
@@ -214,6 +375,16 @@ namespace yagi
 
 		virtual std::optional<std::unique_ptr<TypeInfo>> build(const std::string& name) = 0;
 		virtual std::optional<std::unique_ptr<TypeInfo>> build(uint64_t ea) = 0;
+
+		/*!
+		 * \brief	List every named type of the backend
+		 *			Use to import types before decompilation
+		 * \return	type names, empty if the backend can't enumerate its types
+		 */
+		virtual std::vector<std::string> getTypeNames()
+		{
+			return {};
+		}
 	};
 }
 
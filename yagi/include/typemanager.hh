@@ -5,7 +5,10 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <deque>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 
 #include "yagiarchitecture.hh"
@@ -17,7 +20,135 @@ namespace yagi
 	 */
 	class TypeManager : public TypeFactory
 	{
+	public:
+		/*!
+		 * \brief	Usage statistics of the type cache
+		 */
+		struct CacheStats
+		{
+			uint64_t hits;
+			uint64_t misses;
+		};
+
+		/*!
+		 * \brief	Type changes of the backend since the last synchronization
+		 */
+		struct TypeChanges
+		{
+			/*!
+			 * \brief	the whole type library changed, every type is dropped
+			 */
+			bool flush;
+
+			/*!
+			 * \brief	translated types to drop, with the types built on top of them
+			 */
+			std::set<Datatype*> stale;
+
+			/*!
+			 * \brief	epoch of the collection
+			 */
+			uint64_t epoch;
+		};
+
 	protected:
+		/*!
+		 * \brief	A translated type and the epoch of its translation
+		 */
+		struct CachedType
+		{
+			Datatype* type;
+			std::string name;
+			uint64_t epoch;
+		};
+
+		/*!
+		 * \brief	translated types indexed by backend type key
+		 */
+		std::map<std::string, CachedType> m_typeCache;
+
+		/*!
+		 * \brief	hit and miss counters of m_typeCache
+		 */
+		CacheStats m_stats;
+
+		/*!
+		 * \brief	epoch of the last synchronization with the backend
+		 */
+		uint64_t m_syncEpoch;
+
+		/*!
+		 * \brief	number of flushes, non core types built before are gone
+		 */
+		uint64_t m_flushCount;
+
+		/*!
+		 * \brief	A function signature and the epoch of its extraction
+		 */
+		struct CachedSignature
+		{
+			/*!
+			 * \brief	null if there is no function type
+			 */
+			std::shared_ptr<const FunctionSignature> signature;
+			std::string name;
+			uint64_t epoch;
+		};
+
+		/*!
+		 * \brief	signatures indexed by function type key
+		 */
+		std::map<std::string, CachedSignature> m_signatures;
+
+		/*!
+		 * \brief	signatures of functions indexed by address
+		 */
+		std::map<uint64_t, CachedSignature> m_functionSignatures;
+
+		/*!
+		 * \brief	structures created without their fields yet
+		 *			fields are set when the outermost translation ends
+		 */
+		std::map<Datatype*, std::unique_ptr<StructInfo>> m_pendingStructs;
+
+		/*!
+		 * \brief	creation order of pending structures
+		 */
+		std::deque<Datatype*> m_pendingOrder;
+
+		/*!
+		 * \brief	number of nested findByTypeInfo calls
+		 */
+		uint32_t m_translateDepth;
+
+		/*!
+		 * \brief	Set fields of a pending structure
+		 *			Fields used by value are completed first
+		 *			The structure stays pending if a field can't be translated
+		 * \param	type	the structure, nothing is done if not pending
+		 */
+		void completeStruct(Datatype* type);
+
+		/*!
+		 * \brief	Find translated types of backend types, and every type built on top of them
+		 * \param	names	name of backend types
+		 * \return	translated types, core types excluded
+		 */
+		std::set<Datatype*> findStale(const std::vector<std::string>& names) const;
+
+		/*!
+		 * \brief	Destroy translated types and forget them in caches
+		 * \param	stale	types returned by findStale
+		 */
+		void destroyStale(const std::set<Datatype*>& stale);
+
+		/*!
+		 * \brief	Check if a type directly use one of the types of a set
+		 * \param	type	type to check
+		 * \param	types	set of types
+		 * \return	true if type refers to a type of the set
+		 */
+		static bool dependsOn(const Datatype* type, const std::set<Datatype*>& types);
 
 		/*!
 		 * \brief	pointer the global architecture
@@ -32,6 +163,47 @@ namespace yagi
 		 */
 		Datatype* findById(const string& n, uint8 id, int4 sz) override;
 
+		/*!
+		 * \brief	Restore a type saved in a recovered prototype
+		 * \param	xml	Ghidra XML of the type
+		 * \return	ghidra type
+		 */
+		Datatype* restoreRecoveredType(const std::string& xml);
+
+		/*!
+		 * \brief	Epoch since which a recovered prototype of a function is valid
+		 *			the function or any type may have changed in the backend
+		 * \param	ea	entry point of the function
+		 */
+		uint64_t getValidSince(uint64_t ea) const;
+
+		/*!
+		 * \brief	Find the recovered prototype of a function
+		 *			and record it in the dependencies of the running decompilation
+		 * \param	prototypes	store of recovered prototypes
+		 * \param	ea	entry point of the function
+		 */
+		std::optional<RecoveredPrototype> findRecovered(const PrototypeStore& prototypes, uint64_t ea) const;
+
+		/*!
+		 * \brief	Apply the prototype published for a function
+		 *			A prototype inferred from too few call sites is applied unlocked
+		 * \param	func	function to update
+		 * \return	true if a prototype was applied and locked
+		 */
+		bool applyRecovered(Funcdata& func);
+
+		/*!
+		 * \brief	Publish a recovered prototype
+		 * \param	ea	entry point of the function
+		 * \param	proto	recovered prototype
+		 * \param	source	where the prototype was recovered
+		 * \param	callers	entry point of the caller for a call site prototype
+		 * \param	epoch	epoch of the backend state used by the decompilation
+		 * \return	true if the prototype was published
+		 */
+		bool publish(uint64_t ea, const FuncProto& proto, RecoveredPrototype::Source source, const std::set<uint64_t>& callers, uint64_t epoch);
+
 	public:
 		/*!
 		 * \brief	ctor
@@ -54,11 +226,21 @@ namespace yagi
 		TypeManager& operator=(TypeManager&&) noexcept = default;
 
 		/*!
-		 * \brief	Parse a function information type interface
+		 * \brief	Parse a function signature
 		 *			Try to create a Ghidra type code
+		 * \param	name	name of the function type
+		 * \param	signature	backend function signature
+		 */
+		TypeCode* parseFunc(const std::string& name, const FunctionSignature& signature);
+
+		/*!
+		 * \brief	Get the signature of a function type
+		 *			Signatures are cached per type key and type epoch
 		 * \param	typeInfo	backend type information
+		 * \param	funcInfo	function view of typeInfo
+		 * \return	signature of the function type
 		 */
-		TypeCode* parseFunc(const FuncInfo& typeInfo);
+		std::shared_ptr<const FunctionSignature> findSignature(const TypeInfo& typeInfo, const FuncInfo& funcInfo);
 
 		/*!
 		 * \brief	parse a type information generic interface
@@ -75,10 +257,94 @@ namespace yagi
 		 */
 		Datatype* findByTypeInfo(const TypeInfo& typeInfo);
 
+		/*!
+		 * \brief	Record a type, and the types it is built from,
+		 *			as dependencies of the running decompilation
+		 * \param	type	ghidra type
+		 */
+		void addDependencies(const Datatype* type);
+
+		/*!
+		 * \brief	Record the types of a prototype
+		 *			as dependencies of the running decompilation
+		 * \param	proto	prototype of a function
+		 */
+		void addDependencies(const FuncProto& proto);
+
+		/*!
+		 * \brief	Drop every non core type and the type cache
+		 */
+		void flush();
+
+		/*!
+		 * \brief	Drop translated types, and every type built on top of them
+		 * \param	names	name of backend types that changed
+		 */
+		void invalidate(const std::vector<std::string>& names);
+
+		/*!
+		 * \brief	Collect the types changed in the backend since the last synchronization
+		 *			A change of the whole type library leads to a flush
+		 * \return	types to drop by synchronize
+		 */
+		TypeChanges collectChanges() const;
+
+		/*!
+		 * \brief	Drop the collected types
+		 * \param	changes	result of collectChanges
+		 * \warning	Symbols using a dropped type must be cleared before
+		 */
+		void synchronize(const TypeChanges& changes);
+
+		/*!
+		 * \brief	Invalidate types changed in the backend since the last call
+		 * \warning	Symbols using an invalidated type must be cleared before
+		 */
+		void synchronize();
+
+		/*!
+		 * \brief	Usage of the type cache since the start
+		 * \return	hit and miss counters
+		 */
+		const CacheStats& getCacheStats() const noexcept;
+
+		/*!
+		 * \brief	Number of flushes since the start
+		 *			Symbols built with non core types must be rebuilt
+		 *			when it changes
+		 */
+		uint64_t getFlushCount() const noexcept;
+
 		/*!
 		 * \brief	update function information data
+		 *			from the prototype recovered by a previous decompilation,
+		 *			or from the backend type
 		 */
 		void update(Funcdata& func);
+
+		/*!
+		 * \brief	Check if the prototype of a function is recovered by its decompilation
+		 *			A prototype inferred from call sites is unlocked to be recovered again
+		 * \param	func	function to decompile
+		 * \return	false if the prototype comes from the backend or a previous decompilation
+		 */
+		bool prepareRecovery(Funcdata& func);
+
+		/*!
+		 * \brief	Publish the prototype recovered by the decompilation of a function
+		 *			The prototype is locked, so callers already built use it too
+		 * \param	func	decompiled function
+		 * \param	epoch	epoch of the backend state used by the decompilation
+		 */
+		void publish(Funcdata& func, uint64_t epoch);
+
+		/*!
+		 * \brief	Publish prototypes inferred for the callees of a decompiled function
+		 *			they are lost when the scope is cleared otherwise
+		 * \param	func	decompiled function
+		 * \param	epoch	epoch of the backend state used by the decompilation
+		 */
+		void publishCallSites(Funcdata& func, uint64_t epoch);
 	};
 }
 
@@ -2,6 +2,8 @@
 #define __YAGI_ACTION__
 
 #include "action.hh"
+#include "ebpfhelper.hh"
+#include <optional>
 #include <vector>
 
 namespace yagi 
@@ -29,41 +31,44 @@ namespace yagi
 	/*!
 	 * \brief	This action will try to synchronize name
 	 *			with an IDA netnode
+	 *			All stored names of the function are loaded once,
+	 *			and all spaces are resolved in a single pass over pcode
 	 */
 	class ActionRenameVar : public Action
 	{
-	protected:
-		std::string m_space;
 	public:
-		ActionRenameVar(const string& g, const string& space) 
-			: Action(Action::ruleflags::rule_onceperfunc, "renamevar", g), m_space{ space }
+		ActionRenameVar(const string& g) 
+			: Action(Action::ruleflags::rule_onceperfunc, "renamevar", g)
 		{}
 		virtual Action* clone(const ActionGroupList& grouplist) const {
 			if (!grouplist.contains(getGroup())) return (Action*)0;
-			return new ActionRenameVar(getGroup(), m_space);
+			return new ActionRenameVar(getGroup());
 		}
 		/*!
-		 * \brief	Will apply the stack rename
+		 * \brief	Will apply the local rename
 		 */
 		int4 apply(Funcdata& data) override;
 	};
 
 	/**********************************************************************/
+	/*!
+	 * \brief	This action will add typed symbols stored for the function
+	 *			All stored types of the function are loaded once,
+	 *			and all spaces are resolved in a single pass over pcode
+	 */
 	class ActionLoadLocalScope : public Action
 	{
-	protected:
-		std::string m_space;
 	public:
-		ActionLoadLocalScope(const string& g, const string& space) 
-			: Action(Action::ruleflags::rule_onceperfunc, "load", g), m_space { space } 
+		ActionLoadLocalScope(const string& g) 
+			: Action(Action::ruleflags::rule_onceperfunc, "load", g)
 		{}
 
 		virtual Action* clone(const ActionGroupList& grouplist) const {
 			if (!grouplist.contains(getGroup())) return (Action*)0;
-			return new ActionSyncStackVar(getGroup());
+			return new ActionLoadLocalScope(getGroup());
 		}
 		/*!
-		 * \brief	Will apply the stack rename
+		 * \brief	Will apply the local retype
 		 */
 		int4 apply(Funcdata& data) override;
 	};
@@ -88,18 +93,29 @@ namespace yagi
 
 	/**********************************************************************/
 	class YagiArchitecture;
+
+	/*!
+	 * \brief	This action installs eBPF helpers as functions of the syscall space
+	 *			Helpers are installed once into the persistent layer of the scope,
+	 *			and again only when the type manager flushed their types
+	 */
 	class ActionAddeBPFSyscall : public Action
 	{
 	protected:
-		using Parameters = std::vector<std::tuple<std::string, Datatype*>>;
-		static void addSyscall(
-			YagiArchitecture* arch, 
-			const std::string& name, 
-			uint32_t syscall, 
-			Datatype* return_type, 
-			Parameters params,
-			bool dotdotdot
-		);
+		/*!
+		 * \brief	flush count of the type manager at the last install
+		 */
+		std::optional<uint64_t> m_installed;
+
+		/*!
+		 * \brief	Ghidra type of an eBPF helper type
+		 */
+		static Datatype* getType(YagiArchitecture* arch, EbpfType type);
+
+		/*!
+		 * \brief	Add a helper into the persistent scope
+		 */
+		static void addSyscall(YagiArchitecture* arch, const EbpfHelper& helper);
 
 	public:
 		ActionAddeBPFSyscall(const string& g)
@@ -111,7 +127,9 @@ namespace yagi
 			return new ActionAddeBPFSyscall(getGroup());
 		}
 		/*!
-		 * \brief	
+		 * \brief	Install the helper table if needed
+		 *			built-in helpers are extended by ebpf_helpers.txt
+		 *			when it is found in ghidra spec paths
 		 */
 		int4 apply(Funcdata& data) override;
 	};
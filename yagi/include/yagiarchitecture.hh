@@ -5,8 +5,14 @@
 #include "typeinfo.hh"
 #include "logger.hh"
 #include "loader.hh"
+#include "epoch.hh"
+#include "profiler.hh"
+#include "prototypestore.hh"
+#include "dependency.hh"
 
 #include <libdecomp.hh>
+#include <atomic>
+#include <memory>
 
 namespace yagi 
 {
@@ -82,6 +88,46 @@ namespace yagi
 		 */
 		std::map<std::string, std::string> m_injectionMap;
 
+		/*!
+		 * \brief	changes made in the backend since the start
+		 *			use to invalidate caches
+		 */
+		std::shared_ptr<EpochTracker> m_epochs;
+
+		/*!
+		 * \brief	Collect measures of performActions
+		 *			nullptr when profiling is disabled
+		 */
+		std::unique_ptr<Profiler> m_profiler;
+
+		/*!
+		 * \brief	Prototypes recovered by decompilations
+		 *			nullptr when prototypes are not shared
+		 */
+		std::shared_ptr<PrototypeStore> m_prototypes;
+
+		/*!
+		 * \brief	Dependencies of the running decompilation
+		 *			nullptr when nothing is recorded
+		 */
+		DependencySet* m_dependencies;
+
+		/*!
+		 * \brief	set by cancel from any thread, checked between stages
+		 */
+		std::atomic<bool> m_canceled;
+
+		/*!
+		 * \brief	Perform an action, timed if profiling is enabled
+		 *			Raise if the decompilation is canceled
+		 * \param	stage	name of the stage in the profile
+		 * \param	action	action to perform
+		 * \param	data	function
+		 * \return	result of the action
+		 * \raise	DecompilationCanceled
+		 */
+		int4 performStage(const std::string& stage, Action& action, Funcdata& data);
+
 		/*!
 		 *	\brief	Factory function override to build our internal scope
 		 *			Scopes are used to reselve symbols
@@ -121,6 +167,7 @@ namespace yagi
 		 *	\param	symbols	symbol factory backend, use to find symbol
 		 *	\param	type	type factory backend, use to find type informations
 		 *  \param	defaultCC	default calling convention
+		 *	\param	epochs	tracker of changes made in the backend
 		 */
 		explicit YagiArchitecture(
 			const std::string& name,
@@ -129,7 +176,8 @@ namespace yagi
 			std::unique_ptr<Logger> logger,
 			std::unique_ptr<SymbolInfoFactory> symbols,
 			std::unique_ptr<TypeInfoFactory> type,
-			std::string defaultCC
+			std::string defaultCC,
+			std::shared_ptr<EpochTracker> epochs = std::make_shared<EpochTracker>()
 		);
 
 		virtual ~YagiArchitecture() = default;
@@ -166,6 +214,12 @@ namespace yagi
 		 */
 		Logger& getLogger() const;
 
+		/*!
+		 *	\brief	Access to the tracker of backend changes
+		 *	\return	the epoch tracker shared with the backend
+		 */
+		EpochTracker& getEpochs() const;
+
 		/*!
 		 * \brief	return the default calling convention for this arch
 		 */
@@ -201,6 +255,66 @@ namespace yagi
 		 * \param	action	new action
 		 */
 		void addInitAction(Action * action);
+
+		/*!
+		 * \brief	Select the root action used by performActions
+		 *			Preview uses a copy of the ghidra decompile group list
+		 *			without the expensive groups
+		 * \param	profile	full or preview
+		 */
+		void setActionProfile(Decompiler::Profile profile);
+
+		/*!
+		 * \brief	Enable or disable the profiling of performActions
+		 *			Profiling reset and read ghidra action statistics
+		 * \param	enable	true to enable
+		 */
+		void setProfiling(bool enable);
+
+		/*!
+		 * \brief	Stop the running decompilation at its next stage
+		 *			and every next one, can be called from any thread
+		 */
+		void cancel() noexcept;
+
+		/*!
+		 * \brief	Raise if cancel was called
+		 * \raise	DecompilationCanceled
+		 */
+		void checkCanceled() const;
+
+		/*!
+		 * \brief	Access to the profiler
+		 * \return	the profiler, nullptr if profiling is disabled
+		 */
+		Profiler* getProfiler() const;
+
+		/*!
+		 * \brief	Share recovered prototypes through a store
+		 *			Prototypes of decompiled functions are published,
+		 *			functions without backend type use them
+		 * \param	prototypes	the store, nullptr to stop sharing
+		 */
+		void setPrototypeStore(std::shared_ptr<PrototypeStore> prototypes);
+
+		/*!
+		 * \brief	Access to the store of recovered prototypes
+		 * \return	the store, nullptr if prototypes are not shared
+		 */
+		PrototypeStore* getPrototypeStore() const;
+
+		/*!
+		 * \brief	Record what the next decompilations consult in the backend
+		 *			Symbols lookups, translated types and loaded bytes are recorded
+		 * \param	dependencies	set to fill, nullptr to stop recording
+		 */
+		void setDependencies(DependencySet* dependencies);
+
+		/*!
+		 * \brief	Access to the recorded dependencies
+		 * \return	the set being filled, nullptr if nothing is recorded
+		 */
+		DependencySet* getDependencies() const;
 	};
 }
 
@@ -2,6 +2,9 @@
 #define __YAGI_RULE__
 
 #include "action.hh"
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace yagi 
 {
@@ -11,24 +14,60 @@ namespace yagi
 	 *			address of indirect call
 	 */
 	class RuleWindowsControlFlowGuard : public Rule {
+	public:
+		/*!
+		 * \brief	Result of the symbol lookup of an indirect call target
+		 *			and the epoch of the lookup
+		 */
+		struct CacheEntry
+		{
+			bool isWrapper;
+			uint64_t epoch;
+		};
+
+		/*!
+		 * \brief	Lookups by address, shared by all clones of the rule
+		 */
+		using Cache = std::map<uint64_t, CacheEntry>;
+
 	protected:
 		/*!
-		 *	\brief	Name of the CFG wrapper name that will be patched
+		 *	\brief	Names of the CFG wrappers that will be patched
+		 */
+		std::vector<string> m_cfgWrapperNames;
+
+		/*!
+		 * \brief	lookups done by any clone of the rule
+		 *			valid while the address is not changed in the backend
 		 */
-		string m_cfgWrapperName;
+		std::shared_ptr<Cache> m_cache;
+
+		RuleWindowsControlFlowGuard(const string& g, const std::vector<string>& cfgWrapperNames, std::shared_ptr<Cache> cache)
+			: Rule(g, 0, "cfg_visual"), m_cfgWrapperNames{ cfgWrapperNames }, m_cache{ cache }
+		{}
+
+		/*!
+		 * \brief	Check if the target of an indirect call is a CFG wrapper
+		 *			The global scope is only queried on a cache miss
+		 */
+		bool isWrapper(PcodeOp* op, Funcdata& data);
 
 	public:
 		RuleWindowsControlFlowGuard(const string& g, const string& cfgWrapperName)
-			: Rule(g, 0, "cfg_visual"), m_cfgWrapperName{ cfgWrapperName }
+			: RuleWindowsControlFlowGuard(g, std::vector<string>{ cfgWrapperName })
+		{}
+
+		RuleWindowsControlFlowGuard(const string& g, const std::vector<string>& cfgWrapperNames)
+			: RuleWindowsControlFlowGuard(g, cfgWrapperNames, std::make_shared<Cache>())
 		{}
 
 		virtual Rule* clone(const ActionGroupList& grouplist) const {
 			if (!grouplist.contains(getGroup())) return (Rule*)0;
-			return new RuleWindowsControlFlowGuard(getGroup(), m_cfgWrapperName);
+			return new RuleWindowsControlFlowGuard(getGroup(), m_cfgWrapperNames, m_cache);
 		};
 		void getOpList(vector<uint4>& oplist) const override;
 		int4 applyOp(PcodeOp* op, Funcdata& data) override;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,122 @@
+#include "callgraph.hh"
+
+#include <algorithm>
+
+namespace yagi
+{
+	/*!
+	 * \brief	State of a function during the search of components
+	 */
+	struct _TarjanNode
+	{
+		size_t index;
+		size_t lowlink;
+		bool onStack;
+	};
+
+	/**********************************************************************/
+	void CallGraph::addFunction(uint64_t ea)
+	{
+		m_callees[ea];
+	}
+
+	/**********************************************************************/
+	void CallGraph::addCall(uint64_t caller, uint64_t callee)
+	{
+		m_callees[caller].insert(callee);
+		m_callees[callee];
+	}
+
+	/**********************************************************************/
+	const std::set<uint64_t>& CallGraph::getCallees(uint64_t ea) const
+	{
+		static const std::set<uint64_t> none;
+		auto found = m_callees.find(ea);
+		return found == m_callees.end() ? none : found->second;
+	}
+
+	/**********************************************************************/
+	size_t CallGraph::size() const noexcept
+	{
+		return m_callees.size();
+	}
+
+	/**********************************************************************/
+	std::vector<std::vector<uint64_t>> CallGraph::getComponents() const
+	{
+		std::vector<std::vector<uint64_t>> components;
+		std::map<uint64_t, _TarjanNode> nodes;
+		std::vector<uint64_t> stack;
+
+		// depth first search without recursion, call chains can be long
+		std::vector<std::pair<uint64_t, std::set<uint64_t>::const_iterator>> path;
+		size_t index = 0;
+
+		for (auto& [root, rootCallees] : m_callees)
+		{
+			if (nodes.find(root) != nodes.end())
+			{
+				continue;
+			}
+
+			nodes.emplace(root, _TarjanNode{ index, index, true });
+			index++;
+			stack.push_back(root);
+			path.emplace_back(root, rootCallees.begin());
+
+			while (!path.empty())
+			{
+				auto ea = path.back().first;
+				auto& next = path.back().second;
+				if (next != m_callees.at(ea).end())
+				{
+					auto callee = *next++;
+					auto found = nodes.find(callee);
+					if (found == nodes.end())
+					{
+						nodes.emplace(callee, _TarjanNode{ index, index, true });
+						index++;
+						stack.push_back(callee);
+						path.emplace_back(callee, m_callees.at(callee).begin());
+					}
+					else if (found->second.onStack)
+					{
+						auto& node = nodes.at(ea);
+						node.lowlink = std::min(node.lowlink, found->second.index);
+					}
+					continue;
+				}
+
+				// every callee is done
+				path.pop_back();
+				auto node = nodes.at(ea);
+				if (!path.empty())
+				{
+					auto& parent = nodes.at(path.back().first);
+					parent.lowlink = std::min(parent.lowlink, node.lowlink);
+				}
+
+				if (node.lowlink != node.index)
+				{
+					continue;
+				}
+
+				// ea is the root of a component
+				std::vector<uint64_t> component;
+				uint64_t member;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					nodes.at(member).onStack = false;
+					component.push_back(member);
+				} while (member != ea);
+
+				std::sort(component.begin(), component.end());
+				components.push_back(std::move(component));
+			}
+		}
+
+		return components;
+	}
+} // end of namespace yagi
@@ -0,0 +1,103 @@
+#include "codeview.hh"
+
+#include <algorithm>
+
+namespace yagi 
+{
+	/**********************************************************************/
+	size_t LineDiff::getChangedLines() const noexcept
+	{
+		return newSize - prefix - suffix;
+	}
+
+	/**********************************************************************/
+	size_t LineDiff::remap(size_t line) const noexcept
+	{
+		if (newSize == 0)
+		{
+			return 0;
+		}
+
+		size_t result;
+		if (line < prefix)
+		{
+			result = line;
+		}
+		else if (line >= oldSize - suffix)
+		{
+			result = line - oldSize + newSize;
+		}
+		else if (getChangedLines() == 0)
+		{
+			// the block was removed, go to the first line after it
+			result = prefix;
+		}
+		else
+		{
+			result = prefix + std::min(line - prefix, getChangedLines() - 1);
+		}
+		return std::min(result, newSize - 1);
+	}
+
+	/**********************************************************************/
+	CodeView::CodeView(std::shared_ptr<const Decompiler::Result> result)
+		: m_result{ result }
+	{
+		auto& code = m_result->cCode;
+		for (size_t start = 0; start < code.size(); )
+		{
+			m_lines.push_back(start);
+			auto end = code.find('\n', start);
+			if (end == std::string::npos)
+			{
+				break;
+			}
+			start = end + 1;
+		}
+	}
+
+	/**********************************************************************/
+	size_t CodeView::size() const noexcept
+	{
+		return m_lines.size();
+	}
+
+	/**********************************************************************/
+	std::string_view CodeView::getLine(size_t index) const
+	{
+		if (index >= m_lines.size())
+		{
+			return std::string_view();
+		}
+
+		std::string_view code(m_result->cCode);
+		auto start = m_lines[index];
+		auto end = index + 1 < m_lines.size() ? m_lines[index + 1] - 1 : code.find('\n', start);
+		return code.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+	}
+
+	/**********************************************************************/
+	const Decompiler::Result& CodeView::getResult() const noexcept
+	{
+		return *m_result;
+	}
+
+	/**********************************************************************/
+	LineDiff CodeView::diff(const CodeView& from, const CodeView& to)
+	{
+		LineDiff result{ 0, 0, from.size(), to.size() };
+		auto common = std::min(from.size(), to.size());
+
+		while (result.prefix < common && from.getLine(result.prefix) == to.getLine(result.prefix))
+		{
+			result.prefix++;
+		}
+
+		while (result.suffix < common - result.prefix && 
+			from.getLine(from.size() - result.suffix - 1) == to.getLine(to.size() - result.suffix - 1))
+		{
+			result.suffix++;
+		}
+		return result;
+	}
+} // end of namespace yagi
@@ -0,0 +1,117 @@
+#include "dependency.hh"
+
+namespace yagi
+{
+	/**********************************************************************/
+	void DependencySet::addAddress(uint64_t ea)
+	{
+		m_addresses.insert(ea);
+	}
+
+	/**********************************************************************/
+	void DependencySet::addBytes(uint64_t ea, uint64_t size)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		auto last = (ea + size - 1) / EpochTracker::LOADER_PAGE_SIZE;
+		for (auto page = ea / EpochTracker::LOADER_PAGE_SIZE; page <= last; page++)
+		{
+			m_pages.insert(page);
+		}
+	}
+
+	/**********************************************************************/
+	bool DependencySet::addType(const std::string& name)
+	{
+		return m_types.insert(name).second;
+	}
+
+	/**********************************************************************/
+	void DependencySet::addPrototype(uint64_t ea, uint64_t version)
+	{
+		m_prototypes.insert_or_assign(ea, version);
+	}
+
+	/**********************************************************************/
+	void DependencySet::updatePrototypes(const PrototypeStore& prototypes)
+	{
+		for (auto& [ea, version] : m_prototypes)
+		{
+			version = prototypes.getVersion(ea);
+		}
+	}
+
+	/**********************************************************************/
+	const std::set<uint64_t>& DependencySet::getAddresses() const noexcept
+	{
+		return m_addresses;
+	}
+
+	/**********************************************************************/
+	const std::set<uint64_t>& DependencySet::getPages() const noexcept
+	{
+		return m_pages;
+	}
+
+	/**********************************************************************/
+	const std::set<std::string>& DependencySet::getTypes() const noexcept
+	{
+		return m_types;
+	}
+
+	/**********************************************************************/
+	const std::map<uint64_t, uint64_t>& DependencySet::getPrototypes() const noexcept
+	{
+		return m_prototypes;
+	}
+
+	/**********************************************************************/
+	bool DependencySet::isStale(const EpochTracker& epochs, uint64_t epoch, const PrototypeStore* prototypes) const
+	{
+		// a new type may be found by a name that previously missed
+		if (epochs.getTypeLibraryEpoch() > epoch)
+		{
+			return true;
+		}
+
+		for (auto ea : m_addresses)
+		{
+			if (epochs.getAddressEpoch(ea) > epoch)
+			{
+				return true;
+			}
+		}
+
+		for (auto page : m_pages)
+		{
+			if (epochs.getPageEpoch(page * EpochTracker::LOADER_PAGE_SIZE) > epoch)
+			{
+				return true;
+			}
+		}
+
+		for (auto& name : m_types)
+		{
+			if (epochs.getTypeEpoch(name) > epoch)
+			{
+				return true;
+			}
+		}
+
+		// a callee recovered after its caller improves the caller
+		if (prototypes != nullptr)
+		{
+			for (auto& [ea, version] : m_prototypes)
+			{
+				if (prototypes->getVersion(ea) != version)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+} // end of namespace yagi
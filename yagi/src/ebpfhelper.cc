@@ -0,0 +1,456 @@
+#include "ebpfhelper.hh"
+#include "exception.hh"
+
+#include <sstream>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Built-in helpers, from the linux uapi bpf.h
+	 */
+	static const EbpfHelper BUILTIN_HELPERS[] = {
+		// void bpf_unspec()
+		{ 0x0, "bpf_unspec", EbpfType::Void, {}, false },
+		// void *bpf_map_lookup_elem(struct bpf_map *map, const void *key)
+		{ 0x1, "bpf_map_lookup_elem", EbpfType::Ptr, { { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr } }, false },
+		// int bpf_map_update_elem(struct bpf_map *map, const void *key, const void *value, u64 flags)
+		{ 0x3, "bpf_map_update_elem", EbpfType::Int, { { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "value", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_probe_read(void *dst, u32 size, const void *src)
+		{ 0x4, "bpf_probe_read", EbpfType::Int, { { "dst", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "src", EbpfType::Ptr } }, false },
+		// u64 bpf_ktime_get_ns(void)
+		{ 0x5, "bpf_ktime_get_ns", EbpfType::U64, {}, false },
+		// int bpf_trace_printk(const char *fmt, u32 fmt_size, ...)
+		{ 0x6, "bpf_trace_printk", EbpfType::Int, { { "fmt", EbpfType::Ptr }, { "fmt_size", EbpfType::U32 } }, true },
+		// u32 bpf_get_prandom_u32(void)
+		{ 0x7, "bpf_get_prandom_u32", EbpfType::U32, {}, false },
+		// u32 bpf_get_smp_processor_id(void)
+		{ 0x8, "bpf_get_smp_processor_id", EbpfType::U32, {}, false },
+		// int bpf_skb_store_bytes(struct sk_buff *skb, u32 offset, const void *from, u32 len, u64 flags)
+		{ 0x9, "bpf_skb_store_bytes", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "from", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_l3_csum_replace(struct sk_buff *skb, u32 offset, u64 from, u64 to, u64 size)
+		{ 0xa, "bpf_l3_csum_replace", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "from", EbpfType::U64 }, { "to", EbpfType::U64 }, { "size", EbpfType::U64 } }, false },
+		// int bpf_l4_csum_replace(struct sk_buff *skb, u32 offset, u64 from, u64 to, u64 flags)
+		{ 0xb, "bpf_l4_csum_replace", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "from", EbpfType::U64 }, { "to", EbpfType::U64 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_tail_call(void *ctx, struct bpf_map *prog_array_map, u32 index)
+		{ 0xc, "bpf_tail_call", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "prog_array_map", EbpfType::Ptr }, { "index", EbpfType::U32 } }, false },
+		// int bpf_clone_redirect(struct sk_buff *skb, u32 ifindex, u64 flags)
+		{ 0xd, "bpf_clone_redirect", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "ifindex", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// u64 bpf_get_current_pid_tgid(void)
+		{ 0xe, "bpf_get_current_pid_tgid", EbpfType::U64, {}, false },
+		// u64 bpf_get_current_uid_gid(void)
+		{ 0xf, "bpf_get_current_uid_gid", EbpfType::U64, {}, false },
+		// int bpf_get_current_comm(char *buf, u32 size_of_buf)
+		{ 0x10, "bpf_get_current_comm", EbpfType::Int, { { "buf", EbpfType::Str }, { "size_of_buf", EbpfType::U32 } }, false },
+		// u32 bpf_get_cgroup_classid(struct sk_buff *skb)
+		{ 0x11, "bpf_get_cgroup_classid", EbpfType::U32, { { "skb", EbpfType::Ptr } }, false },
+		// int bpf_skb_vlan_push(struct sk_buff *skb, __be16 vlan_proto, u16 vlan_tci)
+		{ 0x12, "bpf_skb_vlan_push", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "vlan_proto", EbpfType::U16 }, { "vlan_tci", EbpfType::U16 } }, false },
+		// int bpf_skb_vlan_pop(struct sk_buff *skb)
+		{ 0x13, "bpf_skb_vlan_pop", EbpfType::Int, { { "skb", EbpfType::Str } }, false },
+		// int bpf_skb_get_tunnel_key(struct sk_buff *skb, struct bpf_tunnel_key *key, u32 size, u64 flags)
+		{ 0x14, "bpf_skb_get_tunnel_key", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_skb_set_tunnel_key(struct sk_buff *skb, struct bpf_tunnel_key *key, u32 size, u64 flags)
+		{ 0x15, "bpf_skb_set_tunnel_key", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// u64 bpf_perf_event_read(struct bpf_map *map, u64 flags)
+		{ 0x16, "bpf_perf_event_read", EbpfType::U64, { { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_redirect(u32 ifindex, u64 flags)
+		{ 0x17, "bpf_redirect", EbpfType::Int, { { "ifindex", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// u32 bpf_get_route_realm(struct sk_buff *skb)
+		{ 0x18, "bpf_get_route_realm", EbpfType::Int, { { "skb", EbpfType::Ptr } }, false },
+		// int bpf_perf_event_output(struct pt_reg *ctx, struct bpf_map *map, u64 flags, void *data, u64 size)
+		{ 0x19, "bpf_perf_event_output", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 }, { "data", EbpfType::Ptr }, { "size", EbpfType::U64 } }, false },
+		// int bpf_skb_load_bytes(const struct sk_buff *skb, u32 offset, void *to, u32 len)
+		{ 0x1a, "bpf_skb_load_bytes", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "to", EbpfType::Ptr }, { "len", EbpfType::U32 } }, false },
+		// int bpf_get_stackid(struct pt_reg *ctx, struct bpf_map *map, u64 flags)
+		{ 0x1b, "bpf_get_stackid", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// s64 bpf_csum_diff(__be32 *from, u32 from_size, __be32 *to, u32 to_size, __wsum seed)
+		{ 0x1c, "bpf_csum_diff", EbpfType::S64, { { "from", EbpfType::Ptr }, { "from_size", EbpfType::U32 }, { "to", EbpfType::Ptr }, { "to_size", EbpfType::U32 }, { "seed", EbpfType::U32 } }, false },
+		// int bpf_skb_get_tunnel_opt(struct sk_buff *skb, u8 *opt, u32 size)
+		{ 0x1d, "bpf_skb_get_tunnel_opt", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "opt", EbpfType::Ptr }, { "size", EbpfType::U32 } }, false },
+		// int bpf_skb_set_tunnel_opt(struct sk_buff *skb, u8 *opt, u32 size)
+		{ 0x1e, "bpf_skb_set_tunnel_opt", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "opt", EbpfType::Ptr }, { "size", EbpfType::U32 } }, false },
+		// int bpf_skb_change_proto(struct sk_buff *skb, __be16 proto, u64 flags)
+		{ 0x1f, "bpf_skb_change_proto", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "proto", EbpfType::U16 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_skb_change_type(struct sk_buff *skb, u32 type)
+		{ 0x20, "bpf_skb_change_type", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "type", EbpfType::U32 } }, false },
+		// int bpf_skb_under_cgroup(struct sk_buff *skb, struct bpf_map *map, u32 index)
+		{ 0x21, "bpf_skb_under_cgroup", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "index", EbpfType::U32 } }, false },
+		// u32 bpf_get_hash_recalc(struct sk_buff *skb)
+		{ 0x22, "bpf_get_hash_recalc", EbpfType::U32, { { "skb", EbpfType::Ptr } }, false },
+		// u64 bpf_get_current_task(void)
+		{ 0x23, "bpf_get_current_task", EbpfType::U64, {}, false },
+		// int bpf_probe_write_user(void *dst, const void *src, u32 len)
+		{ 0x24, "bpf_probe_write_user", EbpfType::Int, { { "dst", EbpfType::Ptr }, { "src", EbpfType::Ptr }, { "len", EbpfType::U32 } }, false },
+		// int bpf_current_task_under_cgroup(struct bpf_map *map, u32 index)
+		{ 0x25, "bpf_current_task_under_cgroup", EbpfType::Int, { { "map", EbpfType::Ptr }, { "index", EbpfType::U32 } }, false },
+		// int bpf_skb_change_tail(struct sk_buff *skb, u32 len, u64 flags)
+		{ 0x26, "bpf_skb_change_tail", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_skb_pull_data(struct sk_buff *skb, u32 len)
+		{ 0x27, "bpf_skb_pull_data", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "len", EbpfType::U32 } }, false },
+		// s64 bpf_csum_update(struct sk_buff *skb, __wsum csum)
+		{ 0x28, "bpf_csum_update", EbpfType::S64, { { "skb", EbpfType::Ptr }, { "csum", EbpfType::U32 } }, false },
+		// void bpf_set_hash_invalid(struct sk_buff *skb)
+		{ 0x29, "bpf_set_hash_invalid", EbpfType::Void, { { "skb", EbpfType::Ptr } }, false },
+		// int bpf_get_numa_node_id(void)
+		{ 0x2a, "bpf_get_numa_node_id", EbpfType::Int, {}, false },
+		// int bpf_skb_change_head(struct sk_buff *skb, u32 len, u64 flags)
+		{ 0x2b, "bpf_skb_change_head", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_xdp_adjust_head(struct xdp_buff *xdp_md, int delta)
+		{ 0x2c, "bpf_xdp_adjust_head", EbpfType::Int, { { "xdp_md", EbpfType::Ptr }, { "delta", EbpfType::Int } }, false },
+		// int bpf_probe_read_str(void *dst, u32 size, const void *unsafe_ptr)
+		{ 0x2d, "bpf_probe_read_str", EbpfType::Int, { { "dst", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "unsafe_ptr", EbpfType::Ptr } }, false },
+		// u64 bpf_get_socket_cookie(void *ctx), ctx is a sk_buff, a bpf_sock_addr or a bpf_sock_ops
+		{ 0x2e, "bpf_get_socket_cookie", EbpfType::U64, { { "ctx", EbpfType::Ptr } }, false },
+		// u32 bpf_get_socket_uid(struct sk_buff *skb)
+		{ 0x2f, "bpf_get_socket_uid", EbpfType::U32, { { "skb", EbpfType::Ptr } }, false },
+		// int bpf_set_hash(struct sk_buff *skb, u32 hash)
+		{ 0x30, "bpf_set_hash", EbpfType::U32, { { "skb", EbpfType::Ptr }, { "hash", EbpfType::U32 } }, false },
+		// int bpf_setsockopt(void *bpf_socket, int level, int optname, void *optval, int optlen)
+		{ 0x31, "bpf_setsockopt", EbpfType::Int, { { "bpf_socket", EbpfType::Ptr }, { "level", EbpfType::Int }, { "optname", EbpfType::Int }, { "optval", EbpfType::Ptr }, { "optlen", EbpfType::Int } }, false },
+		// int bpf_skb_adjust_room(struct sk_buff *skb, s32 len_diff, u32 mode, u64 flags)
+		{ 0x32, "bpf_skb_adjust_room", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "len_diff", EbpfType::S32 }, { "mode", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_redirect_map(struct bpf_map *map, u32 key, u64 flags)
+		{ 0x33, "bpf_redirect_map", EbpfType::Int, { { "map", EbpfType::Ptr }, { "key", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_sk_redirect_map(struct sk_buff *skb, struct bpf_map *map, u32 key, u64 flags)
+		{ 0x34, "bpf_sk_redirect_map", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_sock_map_update(struct bpf_sock_ops *skops, struct bpf_map *map, void *key, u64 flags)
+		{ 0x35, "bpf_sock_map_update", EbpfType::Int, { { "skops", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_xdp_adjust_meta(struct xdp_buff *xdp_md, int delta)
+		{ 0x36, "bpf_xdp_adjust_meta", EbpfType::Int, { { "xdp_md", EbpfType::Ptr }, { "delta", EbpfType::Int } }, false },
+		// int bpf_perf_event_read_value(struct bpf_map *map, u64 flags, struct bpf_perf_event_value *buf, u32 buf_size)
+		{ 0x37, "bpf_perf_event_read_value", EbpfType::Int, { { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 }, { "buf", EbpfType::Ptr }, { "buf_size", EbpfType::U32 } }, false },
+		// int bpf_perf_prog_read_value(struct bpf_perf_event_data *ctx, struct bpf_perf_event_value *buf, u32 buf_size)
+		{ 0x38, "bpf_perf_prog_read_value", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Ptr }, { "buf_size", EbpfType::U32 } }, false },
+		// int bpf_getsockopt(void *bpf_socket, int level, int optname, void *optval, int optlen)
+		{ 0x39, "bpf_getsockopt", EbpfType::Int, { { "bpf_socket", EbpfType::Ptr }, { "level", EbpfType::Int }, { "optname", EbpfType::Int }, { "optval", EbpfType::Ptr }, { "optlen", EbpfType::Int } }, false },
+		// int bpf_override_return(struct pt_regs *regs, u64 rc)
+		{ 0x3a, "bpf_override_return", EbpfType::Int, { { "regs", EbpfType::Ptr }, { "rc", EbpfType::U64 } }, false },
+		// int bpf_sock_ops_cb_flags_set(struct bpf_sock_ops *bpf_sock, int argval)
+		{ 0x3b, "bpf_sock_ops_cb_flags_set", EbpfType::Int, { { "bpf_sock", EbpfType::Ptr }, { "argval", EbpfType::Int } }, false },
+		// int bpf_msg_redirect_map(struct sk_msg_buff *msg, struct bpf_map *map, u32 key, u64 flags)
+		{ 0x3c, "bpf_msg_redirect_map", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_msg_apply_bytes(struct sk_msg_buff *msg, u32 bytes)
+		{ 0x3d, "bpf_msg_apply_bytes", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "bytes", EbpfType::U32 } }, false },
+		// long bpf_msg_cork_bytes(struct sk_msg_md *msg, __u32 bytes)
+		{ 0x3e, "bpf_msg_cork_bytes", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "bytes", EbpfType::U32 } }, false },
+		// long bpf_msg_pull_data(struct sk_msg_md *msg, __u32 start, __u32 end, __u64 flags)
+		{ 0x3f, "bpf_msg_pull_data", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "start", EbpfType::U32 }, { "end", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_bind(struct bpf_sock_addr *ctx, struct sockaddr *addr, int addr_len)
+		{ 0x40, "bpf_bind", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "addr", EbpfType::U32 }, { "addr_len", EbpfType::Int } }, false },
+		// long bpf_xdp_adjust_tail(struct xdp_md *xdp_md, int delta)
+		{ 0x41, "bpf_xdp_adjust_tail", EbpfType::Int, { { "xdp_md", EbpfType::Ptr }, { "delta", EbpfType::Int } }, false },
+		// long bpf_skb_get_xfrm_state(struct __sk_buff *skb, __u32 index, struct bpf_xfrm_state *xfrm_state, __u32 size, __u64 flags)
+		{ 0x42, "bpf_skb_get_xfrm_state", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "index", EbpfType::Int }, { "xfrm_state", EbpfType::Int }, { "size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_get_stack(void *ctx, void *buf, __u32 size, __u64 flags)
+		{ 0x43, "bpf_get_stack", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_skb_load_bytes_relative(const void *skb, __u32 offset, void *to, __u32 len, __u32 start_header)
+		{ 0x44, "bpf_skb_load_bytes_relative", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "to", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "start_header", EbpfType::U32 } }, false },
+		// long bpf_fib_lookup(void *ctx, struct bpf_fib_lookup *params, int plen, __u32 flags)
+		{ 0x45, "bpf_fib_lookup", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "params", EbpfType::Ptr }, { "plen", EbpfType::Int }, { "flags", EbpfType::U32 } }, false },
+		// long bpf_sock_hash_update(struct bpf_sock_ops *skops, void *map, void *key, __u64 flags)
+		{ 0x46, "bpf_sock_hash_update", EbpfType::Int, { { "skops", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_msg_redirect_hash(struct sk_msg_md *msg, void *map, void *key, __u64 flags)
+		{ 0x47, "bpf_msg_redirect_hash", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_sk_redirect_hash(struct __sk_buff *skb, void *map, void *key, __u64 flags)
+		{ 0x48, "bpf_sk_redirect_hash", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_lwt_push_encap(struct __sk_buff *skb, __u32 type, void *hdr, __u32 len)
+		{ 0x49, "bpf_lwt_push_encap", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "type", EbpfType::U32 }, { "hdr", EbpfType::Ptr }, { "len", EbpfType::U32 } }, false },
+		// long bpf_lwt_seg6_store_bytes(struct __sk_buff *skb, __u32 offset, const void *from, __u32 len)
+		{ 0x4a, "bpf_lwt_seg6_store_bytes", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "from", EbpfType::Ptr }, { "len", EbpfType::U32 } }, false },
+		// long bpf_lwt_seg6_adjust_srh(struct __sk_buff *skb, __u32 offset, __s32 delta)
+		{ 0x4b, "bpf_lwt_seg6_adjust_srh", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "offset", EbpfType::U32 }, { "delta", EbpfType::S32 } }, false },
+		// long bpf_lwt_seg6_action(struct __sk_buff *skb, __u32 action, void *param, __u32 param_len)
+		{ 0x4c, "bpf_lwt_seg6_action", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "action", EbpfType::U32 }, { "param", EbpfType::Ptr }, { "param_len", EbpfType::U32 } }, false },
+		// long bpf_rc_repeat(void *ctx)
+		{ 0x4d, "bpf_rc_repeat", EbpfType::Int, { { "ctx", EbpfType::Ptr } }, false },
+		// long bpf_rc_keydown(void *ctx, __u32 protocol, __u64 scancode, __u32 toggle)
+		{ 0x4e, "bpf_rc_keydown", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "protocol", EbpfType::U32 }, { "scancode", EbpfType::U64 }, { "toggle", EbpfType::U32 } }, false },
+		// __u64 bpf_skb_cgroup_id(struct __sk_buff *skb)
+		{ 0x4f, "bpf_skb_cgroup_id", EbpfType::U64, { { "skb", EbpfType::Ptr } }, false },
+		// __u64 bpf_get_current_cgroup_id(void)
+		{ 0x50, "bpf_get_current_cgroup_id", EbpfType::U64, {}, false },
+		// void *bpf_get_local_storage(void *map, __u64 flags)
+		{ 0x51, "bpf_get_local_storage", EbpfType::Ptr, { { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_sk_select_reuseport(struct sk_reuseport_md *reuse, void *map, void *key, __u64 flags)
+		{ 0x52, "bpf_sk_select_reuseport", EbpfType::Int, { { "reuse", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "key", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// __u64 bpf_skb_ancestor_cgroup_id(struct __sk_buff *skb, int ancestor_level)
+		{ 0x53, "bpf_skb_ancestor_cgroup_id", EbpfType::U64, { { "skb", EbpfType::Ptr }, { "ancestor_level", EbpfType::Int } }, false },
+		// struct bpf_sock *bpf_sk_lookup_tcp(void *ctx, struct bpf_sock_tuple *tuple, __u32 tuple_size, __u64 netns, __u64 flags)
+		{ 0x54, "bpf_sk_lookup_tcp", EbpfType::Ptr, { { "ctx", EbpfType::Ptr }, { "tuple", EbpfType::Ptr }, { "tuple_size", EbpfType::U32 }, { "netns", EbpfType::U64 }, { "flags", EbpfType::U64 } }, false },
+		// struct bpf_sock *bpf_sk_lookup_udp(void *ctx, struct bpf_sock_tuple *tuple, __u32 tuple_size, __u64 netns, __u64 flags)
+		{ 0x55, "bpf_sk_lookup_udp", EbpfType::Ptr, { { "ctx", EbpfType::Ptr }, { "tuple", EbpfType::Ptr }, { "tuple_size", EbpfType::U32 }, { "netns", EbpfType::U64 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_sk_release(void *sock)
+		{ 0x56, "bpf_sk_release", EbpfType::Int, { { "sock", EbpfType::Ptr } }, false },
+		// long bpf_map_push_elem(void *map, const void *value, __u64 flags)
+		{ 0x57, "bpf_map_push_elem", EbpfType::Int, { { "map", EbpfType::Ptr }, { "value", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_map_pop_elem(void *map, void *value)
+		{ 0x58, "bpf_map_pop_elem", EbpfType::Int, { { "map", EbpfType::Ptr }, { "value", EbpfType::Ptr } }, false },
+		// long bpf_map_peek_elem(void *map, void *value)
+		{ 0x59, "bpf_map_peek_elem", EbpfType::Int, { { "map", EbpfType::Ptr }, { "value", EbpfType::Ptr } }, false },
+		// long bpf_msg_push_data(struct sk_msg_md *msg, __u32 start, __u32 len, __u64 flags)
+		{ 0x5a, "bpf_msg_push_data", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "start", EbpfType::U32 }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_msg_pop_data(struct sk_msg_md *msg, __u32 start, __u32 len, __u64 flags)
+		{ 0x5b, "bpf_msg_pop_data", EbpfType::Int, { { "msg", EbpfType::Ptr }, { "start", EbpfType::U32 }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_rc_pointer_rel(void *ctx, __s32 rel_x, __s32 rel_y)
+		{ 0x5c, "bpf_rc_pointer_rel", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "rel_x", EbpfType::S32 }, { "rel_y", EbpfType::S32 } }, false },
+		// long bpf_spin_lock(struct bpf_spin_lock *lock)
+		{ 0x5d, "bpf_spin_lock", EbpfType::Int, { { "lock", EbpfType::Ptr } }, false },
+		// long bpf_spin_unlock(struct bpf_spin_lock *lock)
+		{ 0x5e, "bpf_spin_unlock", EbpfType::Int, { { "lock", EbpfType::Ptr } }, false },
+		// struct bpf_sock *bpf_sk_fullsock(struct bpf_sock *sk)
+		{ 0x5f, "bpf_sk_fullsock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// struct bpf_tcp_sock *bpf_tcp_sock(struct bpf_sock *sk)
+		{ 0x60, "bpf_tcp_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// long bpf_skb_ecn_set_ce(struct __sk_buff *skb)
+		{ 0x61, "bpf_skb_ecn_set_ce", EbpfType::Int, { { "skb", EbpfType::Ptr } }, false },
+		// struct bpf_sock *bpf_get_listener_sock(struct bpf_sock *sk)
+		{ 0x62, "bpf_get_listener_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// struct bpf_sock *bpf_skc_lookup_tcp(void *ctx, struct bpf_sock_tuple *tuple, __u32 tuple_size, __u64 netns, __u64 flags)
+		{ 0x63, "bpf_skc_lookup_tcp", EbpfType::Ptr, { { "ctx", EbpfType::Ptr }, { "tuple", EbpfType::Ptr }, { "tuple_size", EbpfType::Ptr }, { "netns", EbpfType::U64 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_tcp_check_syncookie(void *sk, void *iph, __u32 iph_len, struct tcphdr *th, __u32 th_len)
+		{ 0x64, "bpf_tcp_check_syncookie", EbpfType::Int, { { "sk", EbpfType::Ptr }, { "iph", EbpfType::Ptr }, { "iph_len", EbpfType::U32 }, { "th", EbpfType::Ptr }, { "th_len", EbpfType::U32 } }, false },
+		// long bpf_sysctl_get_name(struct bpf_sysctl *ctx, char *buf, unsigned long buf_len, __u64 flags)
+		{ 0x65, "bpf_sysctl_get_name", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Str }, { "buf_len", EbpfType::U64 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_sysctl_get_current_value(struct bpf_sysctl *ctx, char *buf, unsigned long buf_len)'
+		{ 0x66, "bpf_sysctl_get_current_value", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Str }, { "buf_len", EbpfType::U64 } }, false },
+		// long bpf_sysctl_get_new_value(struct bpf_sysctl *ctx, char *buf, unsigned long buf_len)
+		{ 0x67, "bpf_sysctl_get_new_value", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Str }, { "buf_len", EbpfType::U64 } }, false },
+		// long bpf_sysctl_set_new_value(struct bpf_sysctl *ctx, const char *buf, unsigned long buf_len)
+		{ 0x68, "bpf_sysctl_set_new_value", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Str }, { "buf_len", EbpfType::U64 } }, false },
+		// long bpf_strtol(const char *buf, unsigned long buf_len, __u64 flags, long *res)
+		{ 0x69, "bpf_strtol", EbpfType::Int, { { "buf", EbpfType::Str }, { "buf_len", EbpfType::U64 }, { "flags", EbpfType::U64 }, { "res", EbpfType::Ptr } }, false },
+		// long bpf_strtoul(const char *buf, unsigned long buf_len, __u64 flags, unsigned long *res)
+		{ 0x6a, "bpf_strtoul", EbpfType::Int, { { "buf", EbpfType::Str }, { "buf_len", EbpfType::U64 }, { "flags", EbpfType::U64 }, { "res", EbpfType::Ptr } }, false },
+		// void *bpf_sk_storage_get(void *map, void *sk, void *value, __u64 flags)
+		{ 0x6b, "bpf_sk_storage_get", EbpfType::Ptr, { { "map", EbpfType::Ptr }, { "sk", EbpfType::Ptr }, { "value", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_sk_storage_delete(void *map, void *sk)
+		{ 0x6c, "bpf_sk_storage_delete", EbpfType::Int, { { "map", EbpfType::Ptr }, { "sk", EbpfType::Ptr } }, false },
+		// long bpf_send_signal(__u32 sig)
+		{ 0x6d, "bpf_send_signal", EbpfType::Int, { { "sig", EbpfType::U32 } }, false },
+		// __s64 bpf_tcp_gen_syncookie(void *sk, void *iph, __u32 iph_len, struct tcphdr *th, __u32 th_len)
+		{ 0x6e, "bpf_tcp_gen_syncookie", EbpfType::Int, { { "sk", EbpfType::Ptr }, { "iph", EbpfType::Ptr }, { "iph_len", EbpfType::U32 }, { "th", EbpfType::Ptr }, { "th_len", EbpfType::U32 } }, false },
+		// long bpf_skb_output(void *ctx, void *map, __u64 flags, void *data, __u64 size)
+		{ 0x6f, "bpf_skb_output", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 }, { "data", EbpfType::Ptr }, { "size", EbpfType::U64 } }, false },
+		// long bpf_probe_read_user(void *dst, __u32 size, const void *unsafe_ptr)
+		{ 0x70, "bpf_probe_read_user", EbpfType::Int, { { "dst", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "unsafe_ptr", EbpfType::Ptr } }, false },
+		// long bpf_probe_read_kernel(void *dst, __u32 size, const void *unsafe_ptr)
+		{ 0x71, "bpf_probe_read_kernel", EbpfType::Int, { { "dst", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "unsafe_ptr", EbpfType::Ptr } }, false },
+		// long bpf_probe_read_user_str(void *dst, __u32 size, const void *unsafe_ptr)
+		{ 0x72, "bpf_probe_read_user_str", EbpfType::Int, { { "dst", EbpfType::Str }, { "size", EbpfType::U32 }, { "unsafe_ptr", EbpfType::Ptr } }, false },
+		// long bpf_probe_read_kernel_str(void *dst, __u32 size, const void *unsafe_ptr)
+		{ 0x73, "bpf_probe_read_kernel_str", EbpfType::Int, { { "dst", EbpfType::Str }, { "size", EbpfType::U32 }, { "unsafe_ptr", EbpfType::Ptr } }, false },
+		// long bpf_tcp_send_ack(void *tp, __u32 rcv_nxt)
+		{ 0x74, "bpf_tcp_send_ack", EbpfType::Int, { { "tp", EbpfType::Str }, { "rcv_nxt", EbpfType::U32 } }, false },
+		// long bpf_send_signal_thread(__u32 sig)
+		{ 0x75, "bpf_send_signal_thread", EbpfType::Int, { { "sig", EbpfType::U32 } }, false },
+		// __u64 bpf_jiffies64(void)
+		{ 0x76, "bpf_jiffies64", EbpfType::U64, {}, false },
+		// long bpf_read_branch_records(struct bpf_perf_event_data *ctx, void *buf, __u32 size, __u64 flags)
+		{ 0x77, "bpf_read_branch_records", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "buf", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_get_ns_current_pid_tgid(__u64 dev, __u64 ino, struct bpf_pidns_info *nsdata, __u32 size)
+		{ 0x78, "bpf_get_ns_current_pid_tgid", EbpfType::Int, { { "dev", EbpfType::U64 }, { "ino", EbpfType::U64 }, { "nsdata", EbpfType::Ptr }, { "size", EbpfType::U32 } }, false },
+		// long bpf_xdp_output(void *ctx, void *map, __u64 flags, void *data, __u64 size)
+		{ 0x79, "bpf_xdp_output", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "map", EbpfType::Ptr }, { "flags", EbpfType::U64 }, { "data", EbpfType::Ptr }, { "size", EbpfType::U64 } }, false },
+		// __u64 bpf_get_netns_cookie(void *ctx)
+		{ 0x7a, "bpf_get_netns_cookie", EbpfType::Int, { { "ctx", EbpfType::Ptr } }, false },
+		// __u64 bpf_get_current_ancestor_cgroup_id(int ancestor_level)
+		{ 0x7b, "bpf_get_current_ancestor_cgroup_id", EbpfType::U64, { { "ancestor_level", EbpfType::Int } }, false },
+		// long bpf_sk_assign(void *ctx, void *sk, __u64 flags)
+		{ 0x7c, "bpf_sk_assign", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "sk", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// __u64 bpf_ktime_get_boot_ns(void)
+		{ 0x7d, "bpf_ktime_get_boot_ns", EbpfType::U64, {}, false },
+		// long bpf_seq_printf(struct seq_file *m, const char *fmt, __u32 fmt_size, const void *data, __u32 data_len)
+		{ 0x7e, "bpf_seq_printf", EbpfType::Int, { { "m", EbpfType::Ptr }, { "fmt", EbpfType::Str }, { "fmt_size", EbpfType::U32 }, { "data", EbpfType::Ptr }, { "data_len", EbpfType::U32 } }, false },
+		// long bpf_seq_write(struct seq_file *m, const void *data, __u32 len)
+		{ 0x7f, "bpf_seq_write", EbpfType::Int, { { "m", EbpfType::Ptr }, { "data", EbpfType::Ptr }, { "len", EbpfType::U32 } }, false },
+		// __u64 bpf_sk_cgroup_id(void *sk)
+		{ 0x80, "bpf_sk_cgroup_id", EbpfType::U64, { { "sk", EbpfType::Ptr } }, false },
+		// __u64 bpf_sk_ancestor_cgroup_id(void *sk, int ancestor_level)
+		{ 0x81, "bpf_sk_ancestor_cgroup_id", EbpfType::U64, { { "sk", EbpfType::Ptr }, { "ancestor_level", EbpfType::Int } }, false },
+		// long bpf_ringbuf_output(void *ringbuf, void *data, __u64 size, __u64 flags)
+		{ 0x82, "bpf_ringbuf_output", EbpfType::U64, { { "ringbuf", EbpfType::Ptr }, { "data", EbpfType::Ptr }, { "size", EbpfType::U64 }, { "flags", EbpfType::U64 } }, false },
+		// void *bpf_ringbuf_reserve(void *ringbuf, __u64 size, __u64 flags)
+		{ 0x83, "bpf_ringbuf_reserve", EbpfType::Ptr, { { "ringbuf", EbpfType::Ptr }, { "data", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// void bpf_ringbuf_submit(void *data, __u64 flags)
+		{ 0x84, "bpf_ringbuf_submit", EbpfType::Void, { { "ringbuf", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// void bpf_ringbuf_discard(void *data, __u64 flags)
+		{ 0x85, "bpf_ringbuf_discard", EbpfType::Void, { { "data", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// __u64 bpf_ringbuf_query(void *ringbuf, __u64 flags)
+		{ 0x86, "bpf_ringbuf_query", EbpfType::U64, { { "ringbuf", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_csum_level(struct __sk_buff *skb, __u64 level)
+		{ 0x87, "bpf_csum_level", EbpfType::Int, { { "skb", EbpfType::Ptr }, { "level", EbpfType::U64 } }, false },
+		// struct tcp6_sock *bpf_skc_to_tcp6_sock(void *sk)
+		{ 0x88, "bpf_skc_to_tcp6_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// struct tcp_sock *bpf_skc_to_tcp_sock(void *sk)
+		{ 0x89, "bpf_skc_to_tcp_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// struct tcp_timewait_sock *bpf_skc_to_tcp_timewait_sock(void *sk)
+		{ 0x8a, "bpf_skc_to_tcp_timewait_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// struct tcp_request_sock *bpf_skc_to_tcp_request_sock(void *sk)
+		{ 0x8b, "bpf_skc_to_tcp_request_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// struct udp6_sock *bpf_skc_to_udp6_sock(void *sk)
+		{ 0x8c, "bpf_skc_to_udp6_sock", EbpfType::Ptr, { { "sk", EbpfType::Ptr } }, false },
+		// long bpf_get_task_stack(struct task_struct *task, void *buf, __u32 size, __u64 flags)
+		{ 0x8d, "bpf_get_task_stack", EbpfType::Int, { { "task", EbpfType::Ptr }, { "buf", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_load_hdr_opt(struct bpf_sock_ops *skops, void *searchby_res, __u32 len, __u64 flags)
+		{ 0x8e, "bpf_load_hdr_opt", EbpfType::Int, { { "skops", EbpfType::Ptr }, { "searchby_res", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_store_hdr_opt(struct bpf_sock_ops *skops, const void *from, __u32 len, __u64 flags)
+		{ 0x8f, "bpf_store_hdr_opt", EbpfType::Int, { { "skops", EbpfType::Ptr }, { "searchby_res", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_reserve_hdr_opt(struct bpf_sock_ops *skops, __u32 len, __u64 flags)
+		{ 0x90, "bpf_reserve_hdr_opt", EbpfType::Int, { { "skops", EbpfType::Ptr }, { "len", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// void *bpf_inode_storage_get(void *map, void *inode, void *value, __u64 flags)
+		{ 0x91, "bpf_inode_storage_get", EbpfType::Ptr, { { "map", EbpfType::Ptr }, { "inode", EbpfType::Ptr }, { "value", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// int bpf_inode_storage_delete(void *map, void *inode)
+		{ 0x92, "bpf_inode_storage_delete", EbpfType::Int, { { "map", EbpfType::Ptr }, { "inode", EbpfType::Ptr } }, false },
+		// long bpf_d_path(struct path *path, char *buf, __u32 sz)
+		{ 0x93, "bpf_d_path", EbpfType::Int, { { "path", EbpfType::Ptr }, { "buf", EbpfType::Ptr }, { "sz", EbpfType::U32 } }, false },
+		// long bpf_copy_from_user(void *dst, __u32 size, const void *user_ptr)
+		{ 0x94, "bpf_copy_from_user", EbpfType::Int, { { "dst", EbpfType::Ptr }, { "size", EbpfType::U32 }, { "user_ptr", EbpfType::Ptr } }, false },
+		// long bpf_snprintf_btf(char *str, __u32 str_size, struct btf_ptr *ptr, __u32 btf_ptr_size, __u64 flags)
+		{ 0x95, "bpf_snprintf_btf", EbpfType::Int, { { "str", EbpfType::Ptr }, { "str_size", EbpfType::U32 }, { "ptr", EbpfType::Ptr }, { "ptr_size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_seq_printf_btf(struct seq_file *m, struct btf_ptr *ptr, __u32 ptr_size, __u64 flags)
+		{ 0x96, "bpf_seq_printf_btf", EbpfType::Int, { { "m", EbpfType::Ptr }, { "ptr", EbpfType::U32 }, { "ptr_size", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// __u64 bpf_skb_cgroup_classid(struct __sk_buff *skb)
+		{ 0x97, "bpf_skb_cgroup_classid", EbpfType::Int, { { "skb", EbpfType::Ptr } }, false },
+		// long bpf_redirect_neigh(__u32 ifindex, struct bpf_redir_neigh *params, int plen, __u64 flags)
+		{ 0x98, "bpf_redirect_neigh", EbpfType::Int, { { "ifindex", EbpfType::U32 }, { "params", EbpfType::Ptr }, { "plen", EbpfType::Int }, { "flags", EbpfType::U64 } }, false },
+		// void *bpf_per_cpu_ptr(const void *percpu_ptr, __u32 cpu)
+		{ 0x99, "bpf_per_cpu_ptr", EbpfType::Ptr, { { "percpu_ptr", EbpfType::Ptr }, { "cpu", EbpfType::U32 } }, false },
+		// void *bpf_this_cpu_ptr(const void *percpu_ptr)
+		{ 0x9a, "bpf_this_cpu_ptr", EbpfType::Ptr, { { "percpu_ptr", EbpfType::Ptr } }, false },
+		// long bpf_redirect_peer(__u32 ifindex, __u64 flags)
+		{ 0x9b, "bpf_redirect_peer", EbpfType::Int, { { "ifindex", EbpfType::U32 }, { "flags", EbpfType::U64 } }, false },
+		// void *bpf_task_storage_get(void *map, struct task_struct *task, void *value, __u64 flags)
+		{ 0x9c, "bpf_task_storage_get", EbpfType::Ptr, { { "map", EbpfType::Ptr }, { "task", EbpfType::Ptr }, { "value", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_task_storage_delete(void *map, struct task_struct *task)
+		{ 0x9d, "bpf_task_storage_delete", EbpfType::Int, { { "map", EbpfType::Ptr }, { "task", EbpfType::Ptr } }, false },
+		// struct task_struct *bpf_get_current_task_btf(void)
+		{ 0x9e, "bpf_get_current_task_btf", EbpfType::Ptr, {}, false },
+		// long bpf_bprm_opts_set(struct linux_binprm *bprm, __u64 flags)
+		{ 0x9f, "bpf_bprm_opts_set", EbpfType::Int, { { "bprm", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// __u64 bpf_ktime_get_coarse_ns(void)
+		{ 0xa0, "bpf_ktime_get_coarse_ns", EbpfType::U64, {}, false },
+		// long bpf_ima_inode_hash(struct inode *inode, void *dst, __u32 size)
+		{ 0xa1, "bpf_ima_inode_hash", EbpfType::Int, { { "inode", EbpfType::Ptr }, { "dst", EbpfType::Ptr }, { "size", EbpfType::U32 } }, false },
+		// struct socket *bpf_sock_from_file(struct file *file)
+		{ 0xa2, "bpf_sock_from_file", EbpfType::Ptr, { { "file", EbpfType::Ptr } }, false },
+		// long bpf_check_mtu(void *ctx, __u32 ifindex, __u32 *mtu_len, __s32 len_diff, __u64 flags)
+		{ 0xa3, "bpf_check_mtu", EbpfType::Int, { { "ctx", EbpfType::Ptr }, { "ifindex", EbpfType::U32 }, { "mtu_len", EbpfType::Ptr }, { "len_diff", EbpfType::S32 }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_for_each_map_elem(void *map, void *callback_fn, void *callback_ctx, __u64 flags)
+		{ 0xa4, "bpf_for_each_map_elem", EbpfType::Int, { { "map", EbpfType::Ptr }, { "callback_fn", EbpfType::Ptr }, { "callback_ctx", EbpfType::Ptr }, { "flags", EbpfType::U64 } }, false },
+		// long bpf_snprintf(char *str, __u32 str_size, const char *fmt, __u64 *data, __u32 data_len)
+		{ 0xa5, "bpf_snprintf", EbpfType::Int, { { "str", EbpfType::Str }, { "str_size", EbpfType::U32 }, { "fmt", EbpfType::Str }, { "data", EbpfType::Ptr }, { "data_len", EbpfType::U32 } }, false }
+	};
+
+	/*!
+	 * \brief	names of types in data files
+	 */
+	static const std::map<std::string, EbpfType> TYPE_NAMES = {
+		{ "void", EbpfType::Void },
+		{ "int", EbpfType::Int },
+		{ "ptr", EbpfType::Ptr },
+		{ "str", EbpfType::Str },
+		{ "u16", EbpfType::U16 },
+		{ "u32", EbpfType::U32 },
+		{ "u64", EbpfType::U64 },
+		{ "s32", EbpfType::S32 },
+		{ "s64", EbpfType::S64 }
+	};
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Parse a type name of a data file
+	 */
+	static EbpfType _ParseType(const std::string& name, const std::string& source, size_t line)
+	{
+		auto found = TYPE_NAMES.find(name);
+		if (found == TYPE_NAMES.end())
+		{
+			throw InvalidEbpfHelper(source, line, "unknown type " + name);
+		}
+		return found->second;
+	}
+
+	/**********************************************************************/
+	EbpfHelperTable::EbpfHelperTable()
+	{
+		for (auto& helper : BUILTIN_HELPERS)
+		{
+			m_helpers.insert_or_assign(helper.id, helper);
+		}
+	}
+
+	/**********************************************************************/
+	void EbpfHelperTable::load(std::istream& input, const std::string& source)
+	{
+		std::vector<EbpfHelper> helpers;
+		size_t lineNumber = 0;
+		for (std::string line; std::getline(input, line); )
+		{
+			lineNumber++;
+			std::istringstream tokens(line);
+			std::string id, returnType;
+			if (!(tokens >> id) || id[0] == '#')
+			{
+				continue;
+			}
+
+			EbpfHelper helper{ 0, "", EbpfType::Void, {}, false };
+			try
+			{
+				size_t end = 0;
+				auto value = std::stoul(id, &end, 0);
+				if (end != id.size() || value > UINT32_MAX)
+				{
+					throw std::out_of_range(id);
+				}
+				helper.id = static_cast<uint32_t>(value);
+			}
+			catch (std::exception&)
+			{
+				throw InvalidEbpfHelper(source, lineNumber, "invalid id " + id);
+			}
+
+			if (!(tokens >> returnType >> helper.name))
+			{
+				throw InvalidEbpfHelper(source, lineNumber, "missing return type or name");
+			}
+			helper.returnType = _ParseType(returnType, source, lineNumber);
+
+			for (std::string param; tokens >> param; )
+			{
+				if (helper.dotdotdot)
+				{
+					throw InvalidEbpfHelper(source, lineNumber, "parameter after ...");
+				}
+
+				if (param == "...")
+				{
+					helper.dotdotdot = true;
+					continue;
+				}
+
+				auto separator = param.find(':');
+				if (separator == std::string::npos || separator + 1 == param.size())
+				{
+					throw InvalidEbpfHelper(source, lineNumber, "invalid parameter " + param);
+				}
+				helper.params.push_back(EbpfParameter{ 
+					param.substr(separator + 1), 
+					_ParseType(param.substr(0, separator), source, lineNumber) 
+				});
+			}
+			helpers.push_back(std::move(helper));
+		}
+
+		for (auto& helper : helpers)
+		{
+			m_helpers.insert_or_assign(helper.id, std::move(helper));
+		}
+	}
+
+	/**********************************************************************/
+	const std::map<uint32_t, EbpfHelper>& EbpfHelperTable::getHelpers() const
+	{
+		return m_helpers;
+	}
+} // end of namespace yagi
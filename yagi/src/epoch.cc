@@ -0,0 +1,144 @@
+#include "epoch.hh"
+#include <algorithm>
+
+namespace yagi 
+{
+	/**********************************************************************/
+	EpochTracker::EpochTracker()
+		: m_current{ 0 }, m_allPages{ 0 }, m_allTypes{ 0 }, m_lastType{ 0 }
+	{}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getCurrent() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_current;
+	}
+
+	/**********************************************************************/
+	void EpochTracker::touchAddress(uint64_t ea)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_addresses[ea] = ++m_current;
+	}
+
+	/**********************************************************************/
+	void EpochTracker::touchBytes(uint64_t ea, uint64_t size)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_current;
+		auto last = ea + (size == 0 ? 0 : size - 1);
+		for (auto page = ea / LOADER_PAGE_SIZE; page <= last / LOADER_PAGE_SIZE; page++)
+		{
+			m_pages[page] = m_current;
+		}
+	}
+
+	/**********************************************************************/
+	void EpochTracker::touchMemory()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_allPages = ++m_current;
+	}
+
+	/**********************************************************************/
+	void EpochTracker::touchType(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_types[name] = m_lastType = ++m_current;
+	}
+
+	/**********************************************************************/
+	void EpochTracker::touchTypeLibrary()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_allTypes = m_lastType = ++m_current;
+	}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getAddressEpoch(uint64_t ea) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto iter = m_addresses.find(ea);
+		if (iter == m_addresses.end())
+		{
+			return 0;
+		}
+		return iter->second;
+	}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getPageEpoch(uint64_t ea) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto iter = m_pages.find(ea / LOADER_PAGE_SIZE);
+		if (iter == m_pages.end())
+		{
+			return m_allPages;
+		}
+		return std::max(iter->second, m_allPages);
+	}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getTypeEpoch(const std::string& name) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto iter = m_types.find(name);
+		if (iter == m_types.end())
+		{
+			return m_allTypes;
+		}
+		return std::max(iter->second, m_allTypes);
+	}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getTypeLibraryEpoch() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_allTypes;
+	}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getLastTypeEpoch() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_lastType;
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> EpochTracker::getTypesChangedSince(uint64_t epoch) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::vector<std::string> result;
+		for (auto& [name, typeEpoch] : m_types)
+		{
+			if (typeEpoch > epoch)
+			{
+				result.push_back(name);
+			}
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	uint64_t EpochTracker::getMemoryEpoch() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_allPages;
+	}
+
+	/**********************************************************************/
+	std::set<uint64_t> EpochTracker::getAddressesChangedSince(uint64_t epoch) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::set<uint64_t> result;
+		for (auto& [ea, addressEpoch] : m_addresses)
+		{
+			if (addressEpoch > epoch)
+			{
+				result.insert(ea);
+			}
+		}
+		return result;
+	}
+} // end of namespace yagi
@@ -115,4 +115,49 @@ namespace yagi
 		ss << "Ghidra folder missing. Yagi was not correctly installed.";
 		m_reason = ss.str();
 	}
+
+	/**********************************************************************/
+	InvalidTypeDatabase::InvalidTypeDatabase(const std::string& path, const std::string& reason)
+		: Error("")
+	{
+		std::stringstream ss(m_reason);
+		ss << "Invalid type database " << path << " : " << reason;
+		m_reason = ss.str();
+	}
+
+	/**********************************************************************/
+	InvalidEbpfHelper::InvalidEbpfHelper(const std::string& source, size_t line, const std::string& reason)
+		: Error("")
+	{
+		std::stringstream ss(m_reason);
+		ss << "Invalid eBPF helper " << source << ":" << line << " : " << reason;
+		m_reason = ss.str();
+	}
+
+	/**********************************************************************/
+	InvalidTrace::InvalidTrace(const std::string& path, const std::string& reason)
+		: Error("")
+	{
+		std::stringstream ss(m_reason);
+		ss << "Invalid trace " << path << " : " << reason;
+		m_reason = ss.str();
+	}
+
+	/**********************************************************************/
+	MainThreadClosed::MainThreadClosed()
+		: Error("")
+	{
+		std::stringstream ss(m_reason);
+		ss << "Plugin is closed, backend query is canceled";
+		m_reason = ss.str();
+	}
+
+	/**********************************************************************/
+	DecompilationCanceled::DecompilationCanceled()
+		: Error("")
+	{
+		std::stringstream ss(m_reason);
+		ss << "Plugin is closed, decompilation is canceled";
+		m_reason = ss.str();
+	}
 } // end of namespace yagi
@@ -9,163 +9,87 @@
 #include "base.hh"
 #include "yagiaction.hh"
 #include "yagirule.hh"
+#include "typemanager.hh"
+#include "symbolcollector.hh"
+#include "trace.hh"
+#include "scheduler.hh"
+
+#include <algorithm>
 
 namespace yagi 
 {
-	/**********************************************************************/
-	GhidraDecompiler::GhidraDecompiler(std::unique_ptr<YagiArchitecture> architecture)
-		: m_architecture(std::move(architecture))
+	/*!
+	 * \brief	Record the dependencies of a decompilation while in scope
+	 */
+	class DependencyRecording
 	{
+	protected:
+		YagiArchitecture& m_architecture;
 
-	}
-
-	/**********************************************************************/
-	void GhidraDecompiler::findVarSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols) const
-	{
-		auto iter = data.beginDef();
-		while (iter != data.endDef())
+	public:
+		explicit DependencyRecording(YagiArchitecture& architecture, DependencySet& dependencies)
+			: m_architecture{ architecture }
 		{
-			auto varnode = *iter;
-			try
-			{
-				if (
-					varnode->getHigh() != nullptr &&
-					varnode->getHigh()->getSymbol() != nullptr &&
-					varnode->getHigh()->getNameRepresentative() != nullptr 
-					)
-				{
-					auto high = varnode->getHigh();
-					auto nameRepr = high->getNameRepresentative();
-					auto sym = high->getSymbol();
-
-					if (nameRepr->getDef() != nullptr)
-					{
-						auto def = nameRepr->getDef();
-						MemoryLocation loc(
-							nameRepr->getAddr().getSpace()->getName(),
-							nameRepr->getAddr().getOffset(),
-							nameRepr->getAddr().getAddrSize()
-						);
-						loc.pc.push_back(def->getAddr().getOffset());
-						symbols.emplace(sym->getName(),
-							loc
-						);
-					}
-					else {
-						MemoryLocation loc(
-							nameRepr->getAddr().getSpace()->getName(),
-							nameRepr->getAddr().getOffset(),
-							nameRepr->getAddr().getAddrSize()
-						);
-
-						// no name representative, so const (merge multiple variable)
-						auto itOp = data.beginOp(data.getAddress());
-						while (itOp != data.endOp(data.getAddress() + data.getSize()))
-						{
-							auto op = itOp->second;
-							for (auto i = 0; i < op->numInput(); i++)
-							{
-								auto tmpVn = op->getIn(i);
-								if (varnode->getAddr() == tmpVn->getAddr())
-								{
-									loc.pc.push_back(op->getAddr().getOffset());
-								}
-							}
-							++itOp;
-						}
-						symbols.emplace(sym->getName(),
-							loc
-						);
-					}
-				}
-			}
-			catch (LowlevelError&) {}
-			iter++;
+			m_architecture.setDependencies(&dependencies);
 		}
-	}
 
-	/**********************************************************************/
-	void GhidraDecompiler::findFunctionSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols) const
-	{
-		// first we add the local function symbol
-		symbols.emplace(data.getName(),
-			MemoryLocation(
-				"ram",
-				data.getAddress().getOffset(),
-				data.getAddress().getSpace()->getAddrSize()
-			)
-		);
-
-		for (auto i = 0; i < data.numCalls(); i++)
+		~DependencyRecording()
 		{
-			auto call = data.getCallSpecs(i);
-			if(call->getEntryAddress().getSpace() == nullptr)
-			{
-				continue;
-			}
+			m_architecture.setDependencies(nullptr);
+		}
 
-			auto name = call->getName();
+		DependencyRecording(const DependencyRecording&) = delete;
+		DependencyRecording& operator=(const DependencyRecording&) = delete;
+	};
 
-			if (name.substr(0, SymbolInfo::IMPORT_PREFIX.length()) == SymbolInfo::IMPORT_PREFIX)
-			{
-				name = name.substr(SymbolInfo::IMPORT_PREFIX.length(), name.length() - SymbolInfo::IMPORT_PREFIX.length());
-			}
+	/**********************************************************************/
+	GhidraDecompiler::GhidraDecompiler(std::unique_ptr<YagiArchitecture> architecture)
+		: m_architecture(std::move(architecture)), m_typesImported{ 0 }
+	{
 
-			symbols.emplace(name,
-				MemoryLocation(
-					"ram", 
-					call->getEntryAddress().getOffset(), 
-					call->getEntryAddress().getSpace()->getAddrSize()
-				)
-			);
-		}
 	}
 
 	/**********************************************************************/
-	void GhidraDecompiler::findConstantSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols) const
+	std::optional<Decompiler::Result> GhidraDecompiler::decompile(uint64_t funcAddress)
 	{
-		auto iter = data.beginOp(data.getAddress());
-		while (iter != data.endOp(data.getAddress() + data.getSize()))
-		{
-			auto op = iter->second;
-			for (auto i = 0; i < op->numInput(); i++)
-			{
-				auto varnode = op->getIn(i);
-				if (varnode->isConstant())
-				{
-					MemoryLocation loc(
-						varnode->getAddr().getSpace()->getName(),
-						varnode->getAddr().getOffset(),
-						varnode->getAddr().getSpace()->getAddrSize()
-					);
-					loc.pc.push_back(op->getAddr().getOffset());
-					
-				}
-			}
-			iter++;
-		}
+		return decompile(funcAddress, Profile::Full);
 	}
 
 	/**********************************************************************/
-	std::optional<Decompiler::Result> GhidraDecompiler::decompile(uint64_t funcAddress)
+	std::optional<Decompiler::Result> GhidraDecompiler::decompile(uint64_t funcAddress, Profile profile)
 	{
 		try
 		{
+			m_architecture->checkCanceled();
+
+			// backend state used by this decompilation
+			auto& epochs = m_architecture->getEpochs();
+			auto epoch = epochs.getCurrent();
+
+			DependencySet dependencies;
+			dependencies.addAddress(funcAddress);
+			DependencyRecording recording(*m_architecture, dependencies);
+
 			auto funcSym = m_architecture->getSymbolDatabase().find_function(funcAddress);
 
 			if (!funcSym.has_value())
 			{
-				m_architecture->getLogger().info("Unable to find a function at ", to_hex(funcAddress));
+				YAGI_INFO(m_architecture->getLogger(), "Unable to find a function at ", to_hex(funcAddress));
 				return nullopt;
 			}
 
-			auto scope = m_architecture->symboltab->getGlobalScope();
-			// clear scope to update all symbols
-			scope->clear();
+			auto cached = m_results.find(funcSym.value()->getSymbol().getAddress());
+			// a full result is also a valid preview
+			if (cached != m_results.end() && !cached->second.dependencies.isStale(epochs, cached->second.epoch, m_architecture->getPrototypeStore()) &&
+				(cached->second.profile == Profile::Full || cached->second.profile == profile))
+			{
+				m_recent.splice(m_recent.begin(), m_recent, cached->second.recent);
+				return cached->second.result;
+			}
 
-			// clear type factory
-			m_architecture->types->clearNoncore();
+			synchronize();
 
+			auto scope = m_architecture->symboltab->getGlobalScope();
 			auto func = scope->findFunction(
 				Address(
 					m_architecture->getDefaultCodeSpace(), 
@@ -173,14 +97,30 @@ namespace yagi
 				)
 			);
 
+			auto typeManager = static_cast<TypeManager*>(m_architecture->types);
+			auto recovered = typeManager->prepareRecovery(*func);
+
 			m_architecture->clearAnalysis(func);
+			m_architecture->setActionProfile(profile);
 			m_architecture->performActions(*func);
 
+			// sleigh caches decoded instructions, code may not be loaded again
+			auto& blocks = func->getBasicBlocks();
+			for (auto i = 0; i < blocks.getSize(); i++)
+			{
+				auto block = static_cast<const BlockBasic*>(blocks.getBlock(i));
+				if (block->getStart().isInvalid())
+				{
+					continue;
+				}
+				dependencies.addBytes(
+					block->getStart().getOffset(),
+					block->getStop().getOffset() - block->getStart().getOffset() + 1
+				);
+			}
+
 			// now we compute symbols
-			std::map<std::string, MemoryLocation> symbols;
-			findVarSymbols(*func, symbols);
-			findFunctionSymbols(*func, symbols);
-			findConstantSymbols(*func, symbols);
+			auto symbols = SymbolCollector::collect(*func);
 			
 			m_architecture->setPrintLanguage("yagi-c-language");
 
@@ -191,33 +131,214 @@ namespace yagi
 			//print as C
 			m_architecture->print->docFunction(func);
 
-			// get back context information
+			// callee prototypes inferred here are lost when the scope is cleared
+			if (profile == Profile::Full)
+			{
+				typeManager->publishCallSites(*func, epoch);
+				if (recovered)
+				{
+					typeManager->publish(*func, epoch);
+				}
+			}
 
-			return Decompiler::Result(
+			auto prototypes = m_architecture->getPrototypeStore();
+			if (prototypes != nullptr)
+			{
+				dependencies.updatePrototypes(*prototypes);
+			}
+
+			// get back context information
+			Decompiler::Result result(
 				funcSym.value()->getSymbol().getName(), 
 				funcSym.value()->getSymbol().getAddress(),
 				ss.str(), 
 				symbols
 			);
+
+			cacheResult(result.ea, CachedResult{ epoch, profile, result, std::move(dependencies) });
+			return result;
 		}
 		
+		// only a successful decompilation keeps ghidra state for the next one
+		catch (DecompilationCanceled&)
+		{
+			m_syncEpoch.reset();
+			throw;
+		}
 		catch (LowlevelError& e)
 		{
+			m_syncEpoch.reset();
 			m_architecture->getLogger().error(e.explain);
 			return nullopt;
 		}
 		catch (Error& e)
 		{
+			m_syncEpoch.reset();
 			m_architecture->getLogger().error(e.what());
 			return nullopt;
 		}
 		catch(std::exception& e)
 		{
+			m_syncEpoch.reset();
 			m_architecture->getLogger().error(e.what());
 			return nullopt;
 		}
 	}
 
+	/**********************************************************************/
+	void GhidraDecompiler::cacheResult(uint64_t ea, CachedResult cached)
+	{
+		auto previous = m_results.find(ea);
+		if (previous != m_results.end())
+		{
+			m_recent.erase(previous->second.recent);
+		}
+
+		m_recent.push_front(ea);
+		cached.recent = m_recent.begin();
+		m_results.insert_or_assign(ea, std::move(cached));
+
+		while (m_results.size() > MAX_RESULTS)
+		{
+			m_results.erase(m_recent.back());
+			m_recent.pop_back();
+		}
+	}
+
+	/**********************************************************************/
+	void GhidraDecompiler::synchronize()
+	{
+		auto& epochs = m_architecture->getEpochs();
+		auto types = static_cast<TypeManager*>(m_architecture->types);
+		auto scope = m_architecture->getYagiScope();
+
+		// translated types are kept, only changed ones are rebuilt
+		auto changes = types->collectChanges();
+		if (!m_syncEpoch.has_value() || changes.flush || epochs.getMemoryEpoch() > m_syncEpoch.value())
+		{
+			scope->clear();
+		}
+		else if (m_syncEpoch.value() != changes.epoch)
+		{
+			// only symbols built from changed addresses or types are built again
+			scope->invalidate(epochs.getAddressesChangedSince(m_syncEpoch.value()), changes.stale);
+		}
+
+		types->synchronize(changes);
+		m_syncEpoch = changes.epoch;
+	}
+
+	/**********************************************************************/
+	size_t GhidraDecompiler::decompileAll(const CallGraph& graph)
+	{
+		size_t count = 0;
+		CallGraphScheduler(1).run(graph, [this, &count](const std::vector<uint64_t>& component) {
+			for (auto ea : component)
+			{
+				if (decompile(ea, Profile::Full).has_value())
+				{
+					count++;
+				}
+			}
+		});
+		return count;
+	}
+
+	/**********************************************************************/
+	std::vector<uint64_t> GhidraDecompiler::getStaleFunctions() const
+	{
+		auto& epochs = m_architecture->getEpochs();
+		std::vector<uint64_t> result;
+		for (auto& [ea, cached] : m_results)
+		{
+			if (cached.dependencies.isStale(epochs, cached.epoch, m_architecture->getPrototypeStore()))
+			{
+				result.push_back(ea);
+			}
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	Decompiler::Progress GhidraDecompiler::importTypes(size_t budget)
+	{
+		if (!m_typesToImport.has_value())
+		{
+			m_typesToImport = m_architecture->getTypeInfoFactory().getTypeNames();
+			m_typesImported = 0;
+		}
+
+		auto& names = m_typesToImport.value();
+		if (m_typesImported >= names.size())
+		{
+			return Decompiler::Progress{ m_typesImported, names.size() };
+		}
+
+		synchronize();
+		auto types = static_cast<TypeManager*>(m_architecture->types);
+
+		auto end = std::min(names.size(), m_typesImported + budget);
+		for (; m_typesImported < end; m_typesImported++)
+		{
+			auto& name = names[m_typesImported];
+			try
+			{
+				auto typeInfo = m_architecture->getTypeInfoFactory().build(name);
+				if (typeInfo.has_value())
+				{
+					types->findByTypeInfo(*typeInfo.value());
+				}
+			}
+			catch (LowlevelError& e)
+			{
+				m_architecture->getLogger().error("Unable to import type ", name, e.explain);
+			}
+			catch (Error& e)
+			{
+				m_architecture->getLogger().error("Unable to import type ", name, std::string(e.what()));
+			}
+		}
+
+		return Decompiler::Progress{ m_typesImported, names.size() };
+	}
+
+	/**********************************************************************/
+	void GhidraDecompiler::setProfiling(bool enable)
+	{
+		m_architecture->setProfiling(enable);
+	}
+
+	/**********************************************************************/
+	void GhidraDecompiler::cancel() noexcept
+	{
+		m_architecture->cancel();
+	}
+
+	/**********************************************************************/
+	bool GhidraDecompiler::writeProfile(std::ostream& out, bool session, ProfileFormat format) const
+	{
+		auto profiler = m_architecture->getProfiler();
+		if (profiler == nullptr)
+		{
+			return false;
+		}
+
+		auto& report = session ? profiler->getSessionReport() : profiler->getLastReport();
+		if (format == ProfileFormat::Json)
+		{
+			report.toJson(out);
+		}
+		else
+		{
+			if (!session)
+			{
+				out << "function: " << profiler->getLastFunction() << "\n";
+			}
+			report.toText(out);
+		}
+		return true;
+	}
+
 	/**********************************************************************/
 	std::string GhidraDecompiler::compute_sleigh_id(const Compiler& compilerType) noexcept {
 
@@ -366,21 +487,34 @@ namespace yagi
 		const Compiler& compilerType,
 		std::unique_ptr<Logger> logger, 
 		std::unique_ptr<SymbolInfoFactory> symbolDatabase, 
-		std::unique_ptr<TypeInfoFactory> typeDatabase
+		std::unique_ptr<TypeInfoFactory> typeDatabase,
+		std::shared_ptr<EpochTracker> epochs,
+		std::shared_ptr<MainThread> mainThread,
+		std::shared_ptr<TraceRecorder> recorder
 	) noexcept
 	{
 		auto sleighId = compute_sleigh_id(compilerType);
+		auto defaultCC = compute_default_cc(compilerType);
 		logger->info("load compiler with sleigh id : " + sleighId);
 
+		std::unique_ptr<LoaderFactory> loader = std::make_unique<IdaLoaderFactory>(epochs, mainThread);
+		if (recorder != nullptr)
+		{
+			recorder->setArchitecture(sleighId, defaultCC);
+			loader = std::make_unique<RecordingLoaderFactory>(std::move(loader), recorder);
+		}
+
 		auto architecture = std::make_unique<YagiArchitecture>(
 			"", 
 			sleighId,
-			std::make_unique<IdaLoaderFactory>(),
+			std::move(loader),
 			std::move(logger), 
 			std::move(symbolDatabase), 
 			std::move(typeDatabase),
-			compute_default_cc(compilerType)
+			defaultCC,
+			epochs
 		);
+		architecture->setPrototypeStore(std::make_shared<PrototypeStore>());
 
 		// compute architecture rule and action
 		switch (compilerType.language)
@@ -389,7 +523,10 @@ namespace yagi
 		case Compiler::Language::X86_GCC:
 		case Compiler::Language::X86_WINDOWS:
 			architecture->addInjection("alloca_probe", "alloca_probe");
-			architecture->extra_pool_rules.push_back(new RuleWindowsControlFlowGuard("analysis", "guard_dispatch_icall_fptr"));
+			architecture->extra_pool_rules.push_back(new RuleWindowsControlFlowGuard("analysis", std::vector<std::string>{
+				"guard_dispatch_icall_fptr",
+				"guard_xfg_dispatch_icall_fptr"
+			}));
 			break;
 		case Compiler::Language::MIPS:
 			architecture->addArchAction(new ActionMIPST9Optimization("t9optim"));
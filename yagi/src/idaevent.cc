@@ -0,0 +1,202 @@
+#include "idaevent.hh"
+#include <funcs.hpp>
+#include <frame.hpp>
+#include <struct.hpp>
+#include <typeinf.hpp>
+
+namespace yagi 
+{
+	/**********************************************************************/
+	IdaEventListener::IdaEventListener(std::shared_ptr<EpochTracker> epochs)
+		: m_epochs{ epochs }
+	{
+		snapshotLocalTypes(m_localTypes);
+		hook_to_notification_point(HT_IDB, &IdaEventListener::onIdbEvent, this);
+	}
+
+	/**********************************************************************/
+	IdaEventListener::~IdaEventListener()
+	{
+		unhook_from_notification_point(HT_IDB, &IdaEventListener::onIdbEvent, this);
+	}
+
+	/**********************************************************************/
+	std::optional<std::pair<std::string, std::string>> IdaEventListener::snapshotLocalType(uint32_t ordinal)
+	{
+		auto name = get_numbered_type_name(get_idati(), ordinal);
+		if (name == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		const type_t* type = nullptr;
+		const p_list* fields = nullptr;
+		if (!get_numbered_type(get_idati(), ordinal, &type, &fields))
+		{
+			return std::nullopt;
+		}
+
+		std::string serialized(reinterpret_cast<const char*>(type));
+		serialized.push_back('\0');
+		if (fields != nullptr)
+		{
+			serialized += reinterpret_cast<const char*>(fields);
+		}
+
+		return std::make_pair(std::string(name), serialized);
+	}
+
+	/**********************************************************************/
+	void IdaEventListener::snapshotLocalTypes(std::map<uint32_t, std::pair<std::string, std::string>>& snapshot)
+	{
+		auto count = get_ordinal_qty(get_idati());
+		// ordinal are 1-based, count is uint32(-1) on failure
+		for (uint32_t ordinal = 1; count != uint32_t(-1) && ordinal <= count; ordinal++)
+		{
+			auto type = snapshotLocalType(ordinal);
+			if (type.has_value())
+			{
+				snapshot.emplace(ordinal, std::move(type.value()));
+			}
+		}
+	}
+
+	/**********************************************************************/
+	void IdaEventListener::onLocalTypesChanged()
+	{
+		std::map<uint32_t, std::pair<std::string, std::string>> current;
+		snapshotLocalTypes(current);
+
+		for (auto& [ordinal, type] : current)
+		{
+			auto old = m_localTypes.find(ordinal);
+			if (old == m_localTypes.end() || old->second != type)
+			{
+				m_epochs->touchType(type.first);
+				if (old != m_localTypes.end() && old->second.first != type.first)
+				{
+					m_epochs->touchType(old->second.first);
+				}
+			}
+		}
+
+		for (auto& [ordinal, type] : m_localTypes)
+		{
+			if (current.find(ordinal) == current.end())
+			{
+				m_epochs->touchType(type.first);
+			}
+		}
+
+		m_localTypes = std::move(current);
+	}
+
+	/**********************************************************************/
+	void IdaEventListener::onLocalTypeChanged(uint32_t ordinal)
+	{
+		auto type = snapshotLocalType(ordinal);
+		auto old = m_localTypes.find(ordinal);
+		if (old != m_localTypes.end() && (!type.has_value() || old->second != type.value()))
+		{
+			m_epochs->touchType(old->second.first);
+		}
+
+		if (!type.has_value())
+		{
+			if (old != m_localTypes.end())
+			{
+				m_localTypes.erase(old);
+			}
+			return;
+		}
+
+		if (old == m_localTypes.end() || old->second != type.value())
+		{
+			m_epochs->touchType(type.value().first);
+			m_localTypes.insert_or_assign(ordinal, std::move(type.value()));
+		}
+	}
+
+	/**********************************************************************/
+	void IdaEventListener::onStructChanged(uint64_t id)
+	{
+		// frame of a function
+		auto func = get_func_by_frame(id);
+		if (func != BADADDR)
+		{
+			m_epochs->touchAddress(func);
+			return;
+		}
+
+		qstring name;
+		if (get_struc_name(&name, id) > 0)
+		{
+			m_epochs->touchType(name.c_str());
+		}
+	}
+
+	/**********************************************************************/
+	ssize_t idaapi IdaEventListener::onIdbEvent(void* userData, int code, va_list va)
+	{
+		auto listener = static_cast<IdaEventListener*>(userData);
+		auto& epochs = *listener->m_epochs;
+
+		switch (code)
+		{
+		case idb_event::renamed:
+		case idb_event::ti_changed:
+			epochs.touchAddress(va_arg(va, ea_t));
+			break;
+		case idb_event::func_added:
+		case idb_event::func_updated:
+		case idb_event::deleting_func:
+		case idb_event::set_func_start:
+		case idb_event::set_func_end:
+			epochs.touchAddress(va_arg(va, func_t*)->start_ea);
+			break;
+		case idb_event::byte_patched:
+			epochs.touchBytes(va_arg(va, ea_t), 1);
+			break;
+		case idb_event::segm_added:
+		case idb_event::segm_deleted:
+		case idb_event::segm_start_changed:
+		case idb_event::segm_end_changed:
+		case idb_event::allsegs_moved:
+			epochs.touchMemory();
+			break;
+		case idb_event::local_types_changed:
+		{
+#if IDA_SDK_VERSION >= 830
+			// only the changed ordinal is diffed, when IDA knows it
+			auto change = va_argi(va, local_type_change_t);
+			auto ordinal = va_arg(va, uint32);
+			if (ordinal != 0 && (change == LTC_ADDED || change == LTC_DELETED || change == LTC_EDITED || change == LTC_ALIASED))
+			{
+				listener->onLocalTypeChanged(ordinal);
+				break;
+			}
+#endif
+			listener->onLocalTypesChanged();
+			break;
+		}
+		case idb_event::compiler_changed:
+			epochs.touchTypeLibrary();
+			break;
+		case idb_event::struc_created:
+			listener->onStructChanged(va_arg(va, tid_t));
+			break;
+		case idb_event::deleting_struc:
+		case idb_event::struc_renamed:
+		case idb_event::struc_expanded:
+		case idb_event::struc_member_created:
+		case idb_event::struc_member_deleted:
+		case idb_event::struc_member_renamed:
+		case idb_event::struc_member_changed:
+			listener->onStructChanged(va_arg(va, struc_t*)->id);
+			break;
+		default:
+			break;
+		}
+		return 0;
+	}
+} // end of namespace yagi
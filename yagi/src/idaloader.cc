@@ -1,6 +1,7 @@
 #include "idaloader.hh"
 #include "exception.hh"
 #include <libdecomp.hh>
+#include <algorithm>
 
 // due to some include incompatibility
 // we only forward the interesting function
@@ -10,13 +11,16 @@
 
 extern "C" int64_t __stdcall get_bytes(void* buf, int64_t size, uint64_t ea, int gmb_flags = 0, void* mask = NULL);
 
+// try to read all bytes, even after an unitialized one
+#define GMB_READALL	0x01
+
 #define IDA_LOADER	"ida"
 
 namespace yagi 
 {
 	/**********************************************************************/
-	IdaLoader::IdaLoader()
-		: LoadImage(IDA_LOADER)
+	IdaLoader::IdaLoader(std::shared_ptr<EpochTracker> epochs, std::shared_ptr<MainThread> mainThread)
+		: LoadImage(IDA_LOADER), m_epochs{ epochs }, m_mainThread{ mainThread }
 	{}
 
 	/**********************************************************************/
@@ -25,10 +29,73 @@ namespace yagi
 		return IDA_LOADER;
 	}
 
+	/**********************************************************************/
+	bool IdaLoader::isPageValid(uint64_t pageNumber) const
+	{
+		auto iter = m_pages.find(pageNumber);
+		return iter != m_pages.end() && iter->second.epoch >= m_epochs->getPageEpoch(pageNumber * EpochTracker::LOADER_PAGE_SIZE);
+	}
+
+	/**********************************************************************/
+	void IdaLoader::loadPages(uint64_t firstPage, uint64_t lastPage)
+	{
+		std::vector<uint64_t> pageNumbers;
+		for (auto pageNumber = firstPage; pageNumber <= lastPage + LOADER_READ_AHEAD; pageNumber++)
+		{
+			// read ahead only pages not already up to date
+			if (!isPageValid(pageNumber))
+			{
+				pageNumbers.push_back(pageNumber);
+			}
+		}
+
+		if (pageNumbers.empty())
+		{
+			return;
+		}
+
+		// one request to the main thread for all pages
+		m_mainThread->execute([this, &pageNumbers]() {
+			for (auto pageNumber : pageNumbers)
+			{
+				Page page{ m_epochs->getCurrent(), std::vector<uint1>(EpochTracker::LOADER_PAGE_SIZE, 0) };
+				::get_bytes(page.bytes.data(), EpochTracker::LOADER_PAGE_SIZE, pageNumber * EpochTracker::LOADER_PAGE_SIZE, GMB_READALL);
+				m_pages.insert_or_assign(pageNumber, std::move(page));
+			}
+		});
+	}
+
 	/**********************************************************************/
 	void IdaLoader::loadFill(uint1* ptr, int4 size, const Address& addr)
 	{
-		::get_bytes(ptr, size, addr.getOffset());
+		if (size <= 0)
+		{
+			return;
+		}
+
+		auto offset = addr.getOffset();
+		auto firstPage = offset / EpochTracker::LOADER_PAGE_SIZE;
+		auto lastPage = (offset + size - 1) / EpochTracker::LOADER_PAGE_SIZE;
+		for (auto pageNumber = firstPage; pageNumber <= lastPage; pageNumber++)
+		{
+			if (!isPageValid(pageNumber))
+			{
+				loadPages(pageNumber, lastPage);
+				break;
+			}
+		}
+
+		while (size > 0)
+		{
+			auto& page = m_pages.at(offset / EpochTracker::LOADER_PAGE_SIZE);
+			auto pageOffset = offset % EpochTracker::LOADER_PAGE_SIZE;
+			auto count = std::min<uint64_t>(size, EpochTracker::LOADER_PAGE_SIZE - pageOffset);
+			std::copy_n(page.bytes.begin() + pageOffset, count, ptr);
+
+			ptr += count;
+			offset += count;
+			size -= (int4)count;
+		}
 	}
 
 	/**********************************************************************/
@@ -36,4 +103,15 @@ namespace yagi
 	{
 		throw LowlevelError("Cannot adjust YAGI virtual memory");
 	}
+
+	/**********************************************************************/
+	IdaLoaderFactory::IdaLoaderFactory(std::shared_ptr<EpochTracker> epochs, std::shared_ptr<MainThread> mainThread)
+		: m_epochs{ epochs }, m_mainThread{ mainThread }
+	{}
+
+	/**********************************************************************/
+	LoadImage* IdaLoaderFactory::build()
+	{
+		return new IdaLoader(m_epochs, m_mainThread);
+	}
 } // end of namespace ghidra
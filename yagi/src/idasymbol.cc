@@ -7,7 +7,13 @@
 #include <frame.hpp>
 #include <struct.hpp>
 #include <name.hpp>
+#include <funcs.hpp>
+#include <netnode.hpp>
 #include <sstream>
+#include <functional>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
 
 namespace yagi 
 {
@@ -156,58 +162,294 @@ namespace yagi
 	}
 
 	/**********************************************************************/
-	std::optional<std::string> IdaFunctionSymbolInfo::findStackVar(uint64_t offset, uint32_t addrSize)
+	IdaFrameMap::IdaFrameMap(uint64_t functionAddress)
+		: m_frameDelta{ 0 }
 	{
-		auto idaFunc = get_func(m_symbol->getAddress());
+		auto idaFunc = get_func(functionAddress);
+		if (idaFunc == nullptr)
+		{
+			return;
+		}
+
+		m_frameDelta = idaFunc->frsize + idaFunc->frregs;
+
 		auto frame = get_frame(idaFunc);
 		if (frame == nullptr)
 		{
-			return std::nullopt;
+			return;
 		}
 
 		for (uint32_t i = 0; i < frame->memqty; i++)
 		{
-			auto member = frame->members[i];
+			const auto& member = frame->members[i];
 			auto name = std::string(get_struc_name(member.id, STRNFL_REGEX).c_str());
-			auto sofset = member.get_soff() - (idaFunc->frsize + idaFunc->frregs);
-			if (sofset == offset || (addrSize == 4 && ((uint32_t)sofset == (uint32_t)offset)))
+			auto pp = name.find(".");
+			if (pp != std::string::npos)
 			{
-				auto pp = name.find(".");
-				if (pp != std::string::npos)
-				{
-					return name.substr(pp + 1);
-				}
-				return name;
+				name = name.substr(pp + 1);
+			}
+
+			uint64_t sofset = member.get_soff() - (idaFunc->frsize + idaFunc->frregs);
+
+			// emplace keep the first member in frame order
+			m_members.emplace(sofset, name);
+			m_members32.emplace((uint32_t)sofset, name);
+		}
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> IdaFrameMap::find(uint64_t offset, uint32_t addrSize) const
+	{
+		if (addrSize == 4)
+		{
+			auto iter = m_members32.find((uint32_t)offset);
+			if (iter != m_members32.end())
+			{
+				return iter->second;
 			}
+			return std::nullopt;
+		}
+
+		auto iter = m_members.find(offset);
+		if (iter != m_members.end())
+		{
+			return iter->second;
 		}
 		return std::nullopt;
 	}
 
 	/**********************************************************************/
-	std::optional<std::string> IdaFunctionSymbolInfo::findName(uint64_t pc, const std::string& space, uint64_t& offset)
+	uint64_t IdaFrameMap::toFrameOffset(uint64_t offset, uint32_t addrSize) const
+	{
+		// As ghidra handle 32 bit address even in 64 bits
+		// and stack address cound be negative
+		if (addrSize == 4 && (int32_t)offset < 0)
+		{
+			offset = 0xFFFFFFFF00000000 | offset;
+		}
+
+		return offset + m_frameDelta;
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> IdaFunctionSymbolInfo::findStackVar(uint64_t offset, uint32_t addrSize)
+	{
+		if (!m_frame.has_value())
+		{
+			m_frame.emplace(m_symbol->getAddress());
+		}
+
+		return m_frame->find(offset, addrSize);
+	}
+
+	/*!
+	 * \brief	kind of local informations in the function storage,
+	 *			with the name used by the legacy storage
+	 */
+	static const char* LOCAL_NAME = "name";
+	static const char* LOCAL_TYPE = "type";
+	static const char* LEGACY_NAME = "yagireg";
+	static const char* LEGACY_TYPE = "yagitype";
+	static const std::pair<const char*, const char*> LEGACY_KINDS[] = {
+		{ LEGACY_NAME, LOCAL_NAME },
+		{ LEGACY_TYPE, LOCAL_TYPE }
+	};
+
+	/*!
+	 * \brief	database wide netnode that records the storage version,
+	 *			absent before migration
+	 */
+	static const char* STORAGE_VERSION_NODE = "$ yagi.locals";
+	static const char* STORAGE_VERSION_KEY = "version";
+	static const char* STORAGE_VERSION = "1";
+
+	/**********************************************************************/
+	static std::string _StorageName(uint64_t functionAddress)
+	{
+		std::stringstream ss;
+		ss << "$ yagi.locals." << to_hex(functionAddress);
+		return ss.str();
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Name of the legacy netnode of a local, one per use address
+	 *			Still written so that older builds keep the edits
+	 */
+	static std::string _LegacyName(uint64_t functionAddress, const std::string& legacyKind, const std::string& space, uint64_t pc)
 	{
 		std::stringstream ss;
-		ss << "$ " << to_hex(m_symbol->getAddress()) << ".yagireg." << space << "." << to_hex(pc);
-		netnode n(ss.str().c_str(), 0, true);
+		ss << "$ " << to_hex(functionAddress) << "." << legacyKind << "." << space << "." << to_hex(pc);
+		return ss.str();
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Parse an hexadecimal token of a netnode name or value
+	 *			Database content is not trusted, a malformed token is rejected
+	 */
+	static std::optional<uint64_t> _ParseHex(const char* token)
+	{
+		char* end = nullptr;
+		errno = 0;
+		auto value = std::strtoull(token, &end, 16);
+		if (end == token || *end != '\0' || errno == ERANGE)
+		{
+			return std::nullopt;
+		}
+		return value;
+	}
+
+	/**********************************************************************/
+	static std::string _LocalKey(const std::string& kind, const std::string& space, uint64_t pc)
+	{
+		std::stringstream ss;
+		ss << kind << "." << space << "." << to_hex(pc);
+		return ss.str();
+	}
 
-		qstring res;
-		auto size = n.valstr(&res);
+	/**********************************************************************/
+	static void _SetLocal(netnode& storage, const std::string& key, const std::string& value)
+	{
+		storage.hashset(key.c_str(), value.c_str(), value.size() + 1);
+	}
 
-		if (res.size() == 0)
+	/**********************************************************************/
+	/*!
+	 * \brief	Parse a stored value "<value>|<hex offset>"
+	 */
+	static std::optional<std::tuple<std::string, uint64_t>> _ParseLocal(const qstring& stored)
+	{
+		auto pb = stored.find('|');
+		if (stored.size() == 0 || pb == qstring::npos)
 		{
 			return std::nullopt;
 		}
 
-		auto pb = res.find('|');
-		if (pb == qstring::npos)
+		auto offset = _ParseHex(stored.substr(pb + 1).c_str());
+		if (!offset.has_value())
 		{
 			return std::nullopt;
 		}
 
-		std::string name = res.substr(0, pb).c_str();
-		offset = std::stoull(res.substr(pb + 1).c_str(), nullptr, 16);
+		return std::make_tuple(std::string(stored.substr(0, pb).c_str()), offset.value());
+	}
 
-		return name;
+	/**********************************************************************/
+	/*!
+	 * \brief	Walk every stored local of a kind
+	 * \param	storage	the function storage
+	 * \param	kind	LOCAL_NAME or LOCAL_TYPE
+	 * \param	visitor	called with space, pc, value and offset
+	 */
+	static void _VisitLocals(netnode& storage, const std::string& kind,
+		const std::function<void(const std::string&, uint64_t, const std::string&, uint64_t)>& visitor)
+	{
+		qstring key;
+		for (auto size = storage.hashfirst(&key); size >= 0; size = storage.hashnext(&key, std::string(key.c_str()).c_str()))
+		{
+			auto tokens = split(key.c_str(), '.');
+			if (tokens.size() != 3 || tokens[0] != kind)
+			{
+				continue;
+			}
+
+			auto pc = _ParseHex(tokens[2].c_str());
+			qstring stored;
+			storage.hashstr(&stored, key.c_str());
+			auto local = _ParseLocal(stored);
+			if (pc.has_value() && local.has_value())
+			{
+				visitor(tokens[1], pc.value(), std::get<0>(local.value()), std::get<1>(local.value()));
+			}
+		}
+	}
+
+	/**********************************************************************/
+	netnode IdaFunctionSymbolInfo::getStorage()
+	{
+		return netnode(_StorageName(m_symbol->getAddress()).c_str(), 0, true);
+	}
+
+	/**********************************************************************/
+	std::optional<netnode> IdaFunctionSymbolInfo::findStorage() const
+	{
+		netnode storage(_StorageName(m_symbol->getAddress()).c_str());
+		if (storage == BADNODE)
+		{
+			return std::nullopt;
+		}
+		return storage;
+	}
+
+	/**********************************************************************/
+	void IdaFunctionSymbolInfo::migrateStorage()
+	{
+		netnode versionNode(STORAGE_VERSION_NODE, 0, true);
+		qstring version;
+		if (versionNode.hashstr(&version, STORAGE_VERSION_KEY) > 0)
+		{
+			return;
+		}
+
+		// legacy netnodes are named "$ <function>.<kind>.<space>.<pc>",
+		// they are copied and kept for older builds that still read them
+		netnode node;
+		for (bool ok = node.start(); ok; ok = node.next())
+		{
+			qstring name;
+			if (node.get_name(&name) <= 0 || strncmp(name.c_str(), "$ 0x", 4) != 0)
+			{
+				continue;
+			}
+
+			auto tokens = split(name.c_str() + 2, '.');
+			if (tokens.size() != 4)
+			{
+				continue;
+			}
+
+			auto functionAddress = _ParseHex(tokens[0].c_str());
+			auto pc = _ParseHex(tokens[3].c_str());
+			if (!functionAddress.has_value() || !pc.has_value())
+			{
+				continue;
+			}
+
+			for (auto& [legacyKind, kind] : LEGACY_KINDS)
+			{
+				qstring stored;
+				if (tokens[1] == legacyKind && node.valstr(&stored) > 0 && stored.size() != 0)
+				{
+					netnode storage(_StorageName(functionAddress.value()).c_str(), 0, true);
+					_SetLocal(storage, _LocalKey(kind, tokens[2], pc.value()), stored.c_str());
+				}
+			}
+		}
+
+		_SetLocal(versionNode, STORAGE_VERSION_KEY, STORAGE_VERSION);
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> IdaFunctionSymbolInfo::findName(uint64_t pc, const std::string& space, uint64_t& offset)
+	{
+		auto storage = findStorage();
+		if (!storage.has_value())
+		{
+			return std::nullopt;
+		}
+
+		qstring stored;
+		storage.value().hashstr(&stored, _LocalKey(LOCAL_NAME, space, pc).c_str());
+
+		auto local = _ParseLocal(stored);
+		if (!local.has_value())
+		{
+			return std::nullopt;
+		}
+
+		offset = std::get<1>(local.value());
+		return std::get<0>(local.value());
 	}
 
 	/**********************************************************************/
@@ -222,12 +464,14 @@ namespace yagi
 	/**********************************************************************/
 	void IdaFunctionSymbolInfo::saveName(uint64_t address, const std::string& space, uint64_t pc, const std::string& value)
 	{
-		std::stringstream ss, os;
-		ss << "$ " << to_hex(m_symbol->getAddress()) << ".yagireg." << space << "." << to_hex(pc);
-		netnode n(ss.str().c_str(), 0, true);
-
+		std::stringstream os;
 		os << value << "|" << to_hex(address);
-		n.set(os.str().c_str());
+
+		auto storage = getStorage();
+		_SetLocal(storage, _LocalKey(LOCAL_NAME, space, pc), os.str());
+
+		netnode legacy(_LegacyName(m_symbol->getAddress(), LEGACY_NAME, space, pc).c_str(), 0, true);
+		legacy.set(os.str().c_str());
 	}
 
 	/**********************************************************************/
@@ -242,12 +486,14 @@ namespace yagi
 	/**********************************************************************/
 	void IdaFunctionSymbolInfo::saveType(uint64_t address, const std::string& space, uint64_t pc, const TypeInfo& newType)
 	{
-		std::stringstream ss, os;
-		ss << "$ " << to_hex(m_symbol->getAddress()) << ".yagitype." << space << "." << to_hex(pc);
-		netnode n(ss.str().c_str(), 0, true);
-
+		std::stringstream os;
 		os << newType.getName() << "|" << to_hex(address);
-		n.set(os.str().c_str());
+
+		auto storage = getStorage();
+		_SetLocal(storage, _LocalKey(LOCAL_TYPE, space, pc), os.str());
+
+		netnode legacy(_LegacyName(m_symbol->getAddress(), LEGACY_TYPE, space, pc).c_str(), 0, true);
+		legacy.set(os.str().c_str());
 	}
 
 	/**********************************************************************/
@@ -264,36 +510,71 @@ namespace yagi
 	/**********************************************************************/
 	bool IdaFunctionSymbolInfo::clearType(const std::string& space, uint64_t pc)
 	{
-		std::stringstream ss, os;
-		ss << "$ " << to_hex(m_symbol->getAddress()) << ".yagitype." << space << "." << to_hex(pc);
-		netnode n(ss.str().c_str(), 0, true);
-		return n.delvalue() == 1;
+		netnode legacy(_LegacyName(m_symbol->getAddress(), LEGACY_TYPE, space, pc).c_str());
+		if (legacy != BADNODE)
+		{
+			legacy.delvalue();
+		}
+
+		auto storage = findStorage();
+		return storage.has_value() && storage.value().hashdel(_LocalKey(LOCAL_TYPE, space, pc).c_str());
 	}
 
 	/**********************************************************************/
 	std::optional<std::unique_ptr<TypeInfo>> IdaFunctionSymbolInfo::findType(uint64_t pc, const std::string& from, uint64_t& offset)
 	{
-		std::stringstream ss;
-		ss << "$ " << to_hex(m_symbol->getAddress()) << ".yagitype." << from << "." << to_hex(pc);
-		netnode n(ss.str().c_str(), 0, true);
+		auto storage = findStorage();
+		if (!storage.has_value())
+		{
+			return std::nullopt;
+		}
 
-		qstring res;
-		auto size = n.valstr(&res);
+		qstring stored;
+		storage.value().hashstr(&stored, _LocalKey(LOCAL_TYPE, from, pc).c_str());
 
-		if (res.size() == 0)
+		auto local = _ParseLocal(stored);
+		if (!local.has_value())
 		{
 			return std::nullopt;
 		}
 
-		auto pb = res.find('|');
-		if (pb == qstring::npos)
+		offset = std::get<1>(local.value());
+		return IdaTypeInfoFactory().build_decl(std::get<0>(local.value()));
+	}
+
+	/**********************************************************************/
+	std::vector<LocalName> IdaFunctionSymbolInfo::getLocalNames()
+	{
+		std::vector<LocalName> result;
+		auto storage = findStorage();
+		if (!storage.has_value())
 		{
-			return std::nullopt;
+			return result;
 		}
 
-		std::string typeName = res.substr(0, pb).c_str();
-		offset = std::stoull(res.substr(pb + 1).c_str(), nullptr, 16);
+		_VisitLocals(storage.value(), LOCAL_NAME, [&result](const std::string& space, uint64_t pc, const std::string& name, uint64_t offset) {
+			result.push_back(LocalName{ space, pc, offset, name });
+		});
+		return result;
+	}
 
-		return IdaTypeInfoFactory().build_decl(typeName);
+	/**********************************************************************/
+	std::vector<LocalType> IdaFunctionSymbolInfo::getLocalTypes()
+	{
+		std::vector<LocalType> result;
+		auto storage = findStorage();
+		if (!storage.has_value())
+		{
+			return result;
+		}
+
+		_VisitLocals(storage.value(), LOCAL_TYPE, [&result](const std::string& space, uint64_t pc, const std::string& typeName, uint64_t offset) {
+			auto type = IdaTypeInfoFactory().build_decl(typeName);
+			if (type.has_value())
+			{
+				result.push_back(LocalType{ space, pc, offset, std::move(type.value()) });
+			}
+		});
+		return result;
 	}
-} // end of namespace yagi
\ No newline at end of file
+} // end of namespace yagi
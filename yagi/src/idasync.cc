@@ -0,0 +1,440 @@
+#include "idasync.hh"
+#include "exception.hh"
+#include <kernwin.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Answer of a request, shared by the calling thread
+	 *			and the main thread
+	 */
+	struct _MainThreadAnswer
+	{
+		bool executed = false;
+		std::exception_ptr error;
+	};
+
+	/*!
+	 * \brief	A request executed by the main thread of IDA
+	 *			exceptions are kept to be raised in the calling thread
+	 *			Posted without waiting, so IDA deletes it once executed
+	 */
+	class _MainThreadRequest : public exec_request_t
+	{
+	protected:
+		const MainThread& m_mainThread;
+		const std::function<void()>& m_request;
+		std::mutex& m_mutex;
+		std::condition_variable& m_executed;
+		std::shared_ptr<_MainThreadAnswer> m_answer;
+
+	public:
+		explicit _MainThreadRequest(const MainThread& mainThread, const std::function<void()>& request, std::mutex& mutex, std::condition_variable& executed, std::shared_ptr<_MainThreadAnswer> answer)
+			: m_mainThread{ mainThread }, m_request{ request }, m_mutex{ mutex }, m_executed{ executed }, m_answer{ answer }
+		{}
+
+		int idaapi execute() override
+		{
+			// the calling thread doesn't wait anymore, its request is gone
+			if (m_mainThread.isClosed())
+			{
+				return 0;
+			}
+
+			std::exception_ptr error;
+			try
+			{
+				m_request();
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_answer->executed = true;
+			m_answer->error = error;
+			m_executed.notify_all();
+			return 0;
+		}
+	};
+
+	/**********************************************************************/
+	MainThread::MainThread()
+		: m_closed{ false }
+	{}
+
+	/**********************************************************************/
+	void MainThread::execute(const std::function<void()>& request, bool write) const
+	{
+		if (is_main_thread())
+		{
+			if (isClosed())
+			{
+				throw MainThreadClosed();
+			}
+			request();
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (isClosed())
+		{
+			throw MainThreadClosed();
+		}
+
+		// wait here rather than in IDA, so close can release this thread
+		auto answer = std::make_shared<_MainThreadAnswer>();
+		auto id = execute_sync(*new _MainThreadRequest(*this, request, m_mutex, m_executed, answer), MFF_NOWAIT | (write ? MFF_WRITE : MFF_READ));
+		m_pending.insert(id);
+		m_executed.wait(lock, [this, &answer]() { return answer->executed || isClosed(); });
+		m_pending.erase(id);
+
+		if (!answer->executed)
+		{
+			throw MainThreadClosed();
+		}
+		if (answer->error)
+		{
+			std::rethrow_exception(answer->error);
+		}
+	}
+
+	/**********************************************************************/
+	void MainThread::close() noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closed = true;
+		for (auto id : m_pending)
+		{
+			cancel_exec_request(id);
+		}
+		m_executed.notify_all();
+	}
+
+	/**********************************************************************/
+	bool MainThread::isClosed() const noexcept
+	{
+		return m_closed;
+	}
+
+	/**********************************************************************/
+	std::vector<std::unique_ptr<TypeInfo>> TypeSnapshots::add(const std::vector<const TypeInfo*>& types)
+	{
+		TypeDatabaseWriter writer;
+		std::vector<uint32_t> indexes;
+		for (auto type : types)
+		{
+			indexes.push_back(writer.add(*type));
+		}
+
+		// one database for all types of a request
+		std::shared_ptr<const TypeDatabase> database = TypeDatabase::snapshot(writer);
+		std::vector<std::unique_ptr<TypeInfo>> result;
+		for (auto index : indexes)
+		{
+			result.push_back(std::make_unique<FileTypeInfo>(database, index));
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	MainThreadSymbolInfoFactory::MainThreadSymbolInfoFactory(std::unique_ptr<SymbolInfoFactory> inner, std::shared_ptr<MainThread> mainThread, std::shared_ptr<EpochTracker> epochs, std::shared_ptr<TypeSnapshots> types)
+		: m_inner{ std::move(inner) }, m_mainThread{ mainThread }, m_epochs{ epochs }, m_types{ types }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<SymbolInfo>> MainThreadSymbolInfoFactory::find(uint64_t ea)
+	{
+		// segment changes may update read only state
+		auto epoch = std::max(m_epochs->getAddressEpoch(ea), m_epochs->getPageEpoch(ea));
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto cached = m_symbols.find(ea);
+			if (cached != m_symbols.end() && cached->second.epoch >= epoch)
+			{
+				if (!cached->second.symbol.has_value())
+				{
+					return std::nullopt;
+				}
+				return std::make_unique<ReplaySymbolInfo>(cached->second.symbol.value());
+			}
+		}
+
+		auto snapshot = m_mainThread->query<CachedSymbol>([this, ea]() {
+			auto symbol = m_inner->find(ea);
+			return CachedSymbol{
+				m_epochs->getCurrent(),
+				symbol.has_value() ? std::make_optional(TraceSymbol::capture(*symbol.value())) : std::nullopt
+			};
+		});
+
+		auto symbol = snapshot.symbol;
+		{
+			// another thread may have stored a more recent snapshot meanwhile
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto cached = m_symbols.find(ea);
+			if (cached == m_symbols.end() || cached->second.epoch < snapshot.epoch)
+			{
+				m_symbols.insert_or_assign(ea, std::move(snapshot));
+			}
+		}
+
+		if (!symbol.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<ReplaySymbolInfo>(std::move(symbol.value()));
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<FunctionSymbolInfo>> MainThreadSymbolInfoFactory::find_function(uint64_t ea)
+	{
+		// local storage is modified through the function address,
+		// local types may use any named type
+		auto epoch = std::max(m_epochs->getAddressEpoch(ea), m_epochs->getLastTypeEpoch());
+		std::shared_ptr<const FunctionSnapshot> function;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto cached = m_functions.find(ea);
+			if (cached != m_functions.end() && cached->second->epoch >= epoch)
+			{
+				function = cached->second;
+			}
+		}
+
+		if (function == nullptr)
+		{
+			// one request for the symbol and every local, actions query them one after the other
+			function = m_mainThread->query<std::shared_ptr<const FunctionSnapshot>>([this, ea]() {
+				auto result = std::make_shared<FunctionSnapshot>();
+				result->epoch = m_epochs->getCurrent();
+
+				auto inner = m_inner->find_function(ea);
+				if (!inner.has_value())
+				{
+					return result;
+				}
+
+				result->symbol = TraceSymbol::capture(inner.value()->getSymbol());
+				result->names = inner.value()->getLocalNames();
+				result->types = inner.value()->getLocalTypes();
+
+				std::vector<const TypeInfo*> types;
+				for (auto& local : result->types)
+				{
+					types.push_back(local.type.get());
+				}
+
+				// all local types share the same snapshot
+				auto snapshots = m_types->add(types);
+				for (size_t i = 0; i < result->types.size(); i++)
+				{
+					result->types[i].type = std::move(snapshots[i]);
+				}
+				return result;
+			});
+
+			// another thread may have stored a more recent snapshot meanwhile
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto cached = m_functions.find(ea);
+			if (cached == m_functions.end() || cached->second->epoch < function->epoch)
+			{
+				m_functions.insert_or_assign(ea, function);
+			}
+		}
+
+		if (!function->symbol.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<MainThreadFunctionSymbolInfo>(*m_inner, function, m_mainThread, m_epochs);
+	}
+
+	/**********************************************************************/
+	MainThreadFunctionSymbolInfo::MainThreadFunctionSymbolInfo(SymbolInfoFactory& factory, std::shared_ptr<const FunctionSnapshot> snapshot, std::shared_ptr<MainThread> mainThread, std::shared_ptr<EpochTracker> epochs)
+		: FunctionSymbolInfo(std::make_unique<ReplaySymbolInfo>(snapshot->symbol.value())), m_factory{ factory }, m_snapshot{ snapshot }, m_mainThread{ mainThread }, m_epochs{ epochs }
+	{}
+
+	/**********************************************************************/
+	FunctionSymbolInfo& MainThreadFunctionSymbolInfo::getInner()
+	{
+		if (m_inner == nullptr)
+		{
+			auto inner = m_factory.find_function(m_symbol->getAddress());
+			if (!inner.has_value())
+			{
+				throw UnableToFindFunction(m_symbol->getAddress());
+			}
+			m_inner = std::move(inner.value());
+		}
+		return *m_inner;
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> MainThreadFunctionSymbolInfo::findStackVar(uint64_t offset, uint32_t addrSize)
+	{
+		// frame members are not part of the snapshot, the frame is
+		// decoded once by the IDA symbol on the first lookup
+		return m_mainThread->query<std::optional<std::string>>([this, offset, addrSize]() {
+			return getInner().findStackVar(offset, addrSize);
+		});
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> MainThreadFunctionSymbolInfo::findName(uint64_t pc, const std::string& space, uint64_t& offset)
+	{
+		for (auto& local : m_snapshot->names)
+		{
+			if (local.pc == pc && local.space == space)
+			{
+				offset = local.offset;
+				return local.name;
+			}
+		}
+		return std::nullopt;
+	}
+
+	/**********************************************************************/
+	void MainThreadFunctionSymbolInfo::saveName(const MemoryLocation& loc, const std::string& space)
+	{
+		m_mainThread->execute([this, &loc, &space]() {
+			getInner().saveName(loc, space);
+		}, true);
+
+		// outdate the snapshot of the function
+		m_epochs->touchAddress(m_symbol->getAddress());
+	}
+
+	/**********************************************************************/
+	void MainThreadFunctionSymbolInfo::saveType(const MemoryLocation& loc, const TypeInfo& newType)
+	{
+		m_mainThread->execute([this, &loc, &newType]() {
+			getInner().saveType(loc, newType);
+		}, true);
+		m_epochs->touchAddress(m_symbol->getAddress());
+	}
+
+	/**********************************************************************/
+	bool MainThreadFunctionSymbolInfo::clearType(const MemoryLocation& loc)
+	{
+		auto cleared = false;
+		m_mainThread->execute([this, &loc, &cleared]() {
+			cleared = getInner().clearType(loc);
+		}, true);
+		m_epochs->touchAddress(m_symbol->getAddress());
+		return cleared;
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> MainThreadFunctionSymbolInfo::findType(uint64_t pc, const std::string& from, uint64_t& offset)
+	{
+		for (auto& local : m_snapshot->types)
+		{
+			if (local.pc == pc && local.space == from)
+			{
+				offset = local.offset;
+				return std::make_unique<FileTypeInfo>(*static_cast<const FileTypeInfo*>(local.type.get()));
+			}
+		}
+		return std::nullopt;
+	}
+
+	/**********************************************************************/
+	std::vector<LocalName> MainThreadFunctionSymbolInfo::getLocalNames()
+	{
+		return m_snapshot->names;
+	}
+
+	/**********************************************************************/
+	std::vector<LocalType> MainThreadFunctionSymbolInfo::getLocalTypes()
+	{
+		std::vector<LocalType> result;
+		for (auto& local : m_snapshot->types)
+		{
+			result.push_back(LocalType{ local.space, local.pc, local.offset, std::make_unique<FileTypeInfo>(*static_cast<const FileTypeInfo*>(local.type.get())) });
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	MainThreadTypeInfoFactory::MainThreadTypeInfoFactory(std::unique_ptr<TypeInfoFactory> inner, std::shared_ptr<MainThread> mainThread, std::shared_ptr<EpochTracker> epochs, std::shared_ptr<TypeSnapshots> types)
+		: m_inner{ std::move(inner) }, m_mainThread{ mainThread }, m_epochs{ epochs }, m_types{ types }
+	{}
+
+	/**********************************************************************/
+	MainThreadTypeInfoFactory::CachedType MainThreadTypeInfoFactory::snapshot(const std::function<std::optional<std::unique_ptr<TypeInfo>>()>& build)
+	{
+		return m_mainThread->query<CachedType>([this, &build]() {
+			CachedType result{ m_epochs->getCurrent(), std::nullopt };
+			auto type = build();
+			if (type.has_value())
+			{
+				auto snapshot = m_types->add({ type.value().get() });
+				result.type = *static_cast<const FileTypeInfo*>(snapshot.front().get());
+			}
+			return result;
+		});
+	}
+
+	/**********************************************************************/
+	template<typename Key>
+	std::optional<std::unique_ptr<TypeInfo>> MainThreadTypeInfoFactory::find(std::map<Key, CachedType>& cache, const Key& key, uint64_t epoch, const std::function<std::optional<std::unique_ptr<TypeInfo>>()>& build)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto cached = cache.find(key);
+			if (cached != cache.end() && cached->second.epoch >= epoch)
+			{
+				if (!cached->second.type.has_value())
+				{
+					return std::nullopt;
+				}
+				return std::make_unique<FileTypeInfo>(cached->second.type.value());
+			}
+		}
+
+		auto entry = snapshot(build);
+		auto type = entry.type;
+		{
+			// another thread may have stored a more recent snapshot meanwhile
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto cached = cache.find(key);
+			if (cached == cache.end() || cached->second.epoch < entry.epoch)
+			{
+				cache.insert_or_assign(key, std::move(entry));
+			}
+		}
+
+		if (!type.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileTypeInfo>(std::move(type.value()));
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> MainThreadTypeInfoFactory::build(const std::string& name)
+	{
+		// a type snapshot includes every type it uses
+		return find(m_names, name, m_epochs->getLastTypeEpoch(), [this, &name]() { return m_inner->build(name); });
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> MainThreadTypeInfoFactory::build(uint64_t ea)
+	{
+		auto epoch = std::max(m_epochs->getAddressEpoch(ea), m_epochs->getLastTypeEpoch());
+		return find(m_addresses, ea, epoch, [this, ea]() { return m_inner->build(ea); });
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> MainThreadTypeInfoFactory::getTypeNames()
+	{
+		return m_mainThread->query<std::vector<std::string>>([this]() {
+			return m_inner->getTypeNames();
+		});
+	}
+} // end of namespace yagi
@@ -3,6 +3,9 @@
 #include "exception.hh"
 #include "idatool.hh"
 
+#include <funcs.hpp>
+#include <name.hpp>
+
 #include <algorithm>
 #include <sstream>
 
@@ -79,15 +82,14 @@ namespace yagi
 	}
 
 	/**********************************************************************/
-	std::string IdaFuncInfo::getCallingConv() const
+	/*!
+	 * \brief	Convert an IDA calling convention into a Ghidra one
+	 * \param	cc	IDA calling convention
+	 * \return	name of the calling convention, nullopt if unknown
+	 */
+	static std::optional<std::string> _ConvertCallingConv(cm_t cc)
 	{
-		func_type_data_t funcInfo;
-		if (!m_info.m_type.get_func_details(&funcInfo))
-		{
-			throw UnknownCallingConvention(m_info.getName());
-		}
-
-		switch (funcInfo.get_cc())
+		switch (cc)
 		{
 		case CM_CC_FASTCALL:
 			return "__fastcall";
@@ -101,8 +103,54 @@ namespace yagi
 		case CM_CC_INVALID:
 		case CM_CC_UNKNOWN:
 		default:
+			return std::nullopt;
+		}
+	}
+
+	/**********************************************************************/
+	std::string IdaFuncInfo::getCallingConv() const
+	{
+		func_type_data_t funcInfo;
+		if (!m_info.m_type.get_func_details(&funcInfo))
+		{
+			throw UnknownCallingConvention(m_info.getName());
+		}
+
+		auto cc = _ConvertCallingConv(funcInfo.get_cc());
+		if (!cc.has_value())
+		{
 			throw UnknownCallingConvention(m_info.getName());
 		}
+		return cc.value();
+	}
+
+	/**********************************************************************/
+	FunctionSignature IdaFuncInfo::getSignature() const
+	{
+		FunctionSignature signature{ nullptr, {}, {}, std::nullopt, isDotDotDot() };
+		func_type_data_t funcInfo;
+		if (!m_info.m_type.get_func_details(&funcInfo, GTD_CALC_ARGLOCS))
+		{
+			// not found return empty signature
+			return signature;
+		}
+
+		signature.returnType = std::make_unique<IdaTypeInfo>(funcInfo.rettype);
+		for (auto& arg : funcInfo)
+		{
+			signature.paramTypes.push_back(std::make_unique<IdaTypeInfo>(arg.type));
+			if (arg.name.empty())
+			{
+				signature.paramNames.push_back("a" + std::to_string(signature.paramTypes.size()));
+			}
+			else
+			{
+				signature.paramNames.push_back(arg.name.c_str());
+			}
+		}
+
+		signature.callingConv = _ConvertCallingConv(funcInfo.get_cc());
+		return signature;
 	}
 
 	/**********************************************************************/
@@ -142,6 +190,17 @@ namespace yagi
 	}
 
 
+	/**********************************************************************/
+	void IdaStructInfo::visitFields(FunctionRef<void(uint64_t, std::string_view, const TypeInfo&)> visitor) const
+	{
+		udt_type_data_t attributes;
+		m_info.m_type.get_udt_details(&attributes);
+		for (auto& member : attributes)
+		{
+			visitor(member.offset / 8, std::string_view(member.name.c_str(), member.name.length()), IdaTypeInfo(member.type));
+		}
+	}
+
 	/**********************************************************************/
 	const TypeInfo& IdaStructInfo::getType() const
 	{
@@ -217,6 +276,29 @@ namespace yagi
 		return name.c_str();
 	}
 
+	/**********************************************************************/
+	std::string IdaTypeInfo::getKey() const
+	{
+		// const and volatile share the ordinal of the unqualified type
+		auto ordinal = m_type.get_ordinal();
+		if (ordinal != 0)
+		{
+			return "#" + std::to_string(ordinal) + ":" + std::to_string(m_type.get_modifiers());
+		}
+
+		qtype type, fields;
+		if (!m_type.serialize(&type, &fields))
+		{
+			return getName();
+		}
+
+		std::string key = "@";
+		key.append(reinterpret_cast<const char*>(type.begin()), type.size());
+		key.push_back('\0');
+		key.append(reinterpret_cast<const char*>(fields.begin()), fields.size());
+		return key;
+	}
+
 	/**********************************************************************/
 	bool IdaTypeInfo::isBool() const
 	{
@@ -314,6 +396,54 @@ namespace yagi
 		return std::make_unique<IdaArrayInfo>(*this);
 	}
 
+	/**********************************************************************/
+	bool IdaTypeInfo::visitPointedObject(FunctionRef<void(const TypeInfo&)> visitor) const
+	{
+		if (!m_type.is_ptr())
+		{
+			return false;
+		}
+
+		visitor(IdaTypeInfo(m_type.get_pointed_object()));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool IdaTypeInfo::visitArrayElement(FunctionRef<void(const TypeInfo&)> visitor) const
+	{
+		if (!m_type.is_array())
+		{
+			return false;
+		}
+
+		visitor(IdaTypeInfo(m_type.get_array_element()));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool IdaTypeInfo::visitFunc(FunctionRef<void(const FuncInfo&)> visitor) const
+	{
+		if (!m_type.is_func())
+		{
+			return false;
+		}
+
+		visitor(IdaFuncInfo(*this));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool IdaTypeInfo::visitStruct(FunctionRef<void(const StructInfo&)> visitor) const
+	{
+		if (!m_type.is_struct())
+		{
+			return false;
+		}
+
+		visitor(IdaStructInfo(*this));
+		return true;
+	}
+
 	/**********************************************************************/
 	std::optional<std::unique_ptr<TypeInfo>> IdaTypeInfoFactory::build(const std::string& name)
 	{
@@ -362,4 +492,60 @@ namespace yagi
 		return std::make_unique<IdaTypeInfo>(idaTypeInfo);
 	}
 
+	/**********************************************************************/
+	std::vector<std::string> IdaTypeInfoFactory::getTypeNames()
+	{
+		std::vector<std::string> result;
+		auto count = get_ordinal_qty(get_idati());
+		// ordinal are 1-based, count is uint32(-1) on failure
+		for (uint32_t ordinal = 1; count != uint32_t(-1) && ordinal <= count; ordinal++)
+		{
+			auto name = get_numbered_type_name(get_idati(), ordinal);
+			if (name != nullptr)
+			{
+				result.push_back(name);
+			}
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	size_t IdaTypeInfoFactory::exportTypes(TypeDatabaseWriter& writer)
+	{
+		size_t count = 0;
+		for (auto& name : getTypeNames())
+		{
+			auto type = build(name);
+			if (type.has_value())
+			{
+				writer.addName(name, *type.value());
+				count++;
+			}
+		}
+
+		auto addAddress = [&writer, &count](ea_t ea) {
+			tinfo_t idaTypeInfo;
+			if (get_tinfo(&idaTypeInfo, ea) || guess_tinfo(&idaTypeInfo, ea))
+			{
+				writer.addAddress(ea, IdaTypeInfo(idaTypeInfo));
+				count++;
+			}
+		};
+
+		for (size_t i = 0; i < get_func_qty(); i++)
+		{
+			auto func = getn_func(i);
+			if (func != nullptr)
+			{
+				addAddress(func->start_ea);
+			}
+		}
+
+		for (size_t i = 0; i < get_nlist_size(); i++)
+		{
+			addAddress(get_nlist_ea(i));
+		}
+		return count;
+	}
+
 } // end of namespace yagi
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "idaview.hh"
+#include <loader.hpp>
+
+namespace yagi 
+{
+	/**********************************************************************/
+	int IdaViewPlace::s_id = -1;
+
+	/**********************************************************************/
+	/*!
+	 * \brief	CodeView of the custom viewer
+	 */
+	static const CodeView& _GetView(void* ud)
+	{
+		return *static_cast<const CodeView*>(ud);
+	}
+
+	/**********************************************************************/
+	IdaViewPlace::IdaViewPlace(uval_t line)
+		: place_t(0), m_line{ line }
+	{}
+
+	/**********************************************************************/
+	void IdaViewPlace::registerClass()
+	{
+		if (s_id == -1)
+		{
+			IdaViewPlace tmplate;
+			s_id = register_place_class(&tmplate, PCF_MAKEPLACE_ALLOCATES, &PLUGIN);
+		}
+	}
+
+	/**********************************************************************/
+	void idaapi IdaViewPlace::print(qstring* out_buf, void* ud) const
+	{
+		auto line = _GetView(ud).getLine(m_line);
+		qstring text(line.data(), line.size());
+		tag_remove(out_buf, text);
+	}
+
+	/**********************************************************************/
+	uval_t idaapi IdaViewPlace::touval(void* ud) const
+	{
+		return m_line;
+	}
+
+	/**********************************************************************/
+	place_t* idaapi IdaViewPlace::clone() const
+	{
+		return new IdaViewPlace(*this);
+	}
+
+	/**********************************************************************/
+	void idaapi IdaViewPlace::copyfrom(const place_t* from)
+	{
+		auto other = static_cast<const IdaViewPlace*>(from);
+		lnnum = other->lnnum;
+		m_line = other->m_line;
+	}
+
+	/**********************************************************************/
+	place_t* idaapi IdaViewPlace::makeplace(void* ud, uval_t x, int lnnum) const
+	{
+		auto place = new IdaViewPlace(x);
+		place->lnnum = lnnum;
+		return place;
+	}
+
+	/**********************************************************************/
+	int idaapi IdaViewPlace::compare(const place_t* t2) const
+	{
+		auto other = static_cast<const IdaViewPlace*>(t2);
+		if (m_line == other->m_line)
+		{
+			return 0;
+		}
+		return m_line < other->m_line ? -1 : 1;
+	}
+
+	/**********************************************************************/
+	int idaapi IdaViewPlace::compare2(const place_t* t2, void* ud) const
+	{
+		return compare(t2);
+	}
+
+	/**********************************************************************/
+	void idaapi IdaViewPlace::adjust(void* ud)
+	{
+		auto size = _GetView(ud).size();
+		if (m_line >= size)
+		{
+			m_line = size == 0 ? 0 : size - 1;
+		}
+		lnnum = 0;
+	}
+
+	/**********************************************************************/
+	bool idaapi IdaViewPlace::prev(void* ud)
+	{
+		if (m_line == 0)
+		{
+			return false;
+		}
+		m_line--;
+		return true;
+	}
+
+	/**********************************************************************/
+	bool idaapi IdaViewPlace::next(void* ud)
+	{
+		if (m_line + 1 >= _GetView(ud).size())
+		{
+			return false;
+		}
+		m_line++;
+		return true;
+	}
+
+	/**********************************************************************/
+	bool idaapi IdaViewPlace::beginning(void* ud) const
+	{
+		return m_line == 0;
+	}
+
+	/**********************************************************************/
+	bool idaapi IdaViewPlace::ending(void* ud) const
+	{
+		return m_line + 1 >= _GetView(ud).size();
+	}
+
+	/**********************************************************************/
+	int idaapi IdaViewPlace::generate(qstrvec_t* out, int* out_deflnnum, color_t* out_pfx_color, bgcolor_t* out_bgcolor, void* ud, int maxsize) const
+	{
+		if (maxsize <= 0)
+		{
+			return 0;
+		}
+
+		// one place is one line of code
+		auto line = _GetView(ud).getLine(m_line);
+		out->push_back(qstring(line.data(), line.size()));
+		*out_deflnnum = 0;
+		return 1;
+	}
+
+	/**********************************************************************/
+	void idaapi IdaViewPlace::serialize(bytevec_t* out) const
+	{
+		place_t__serialize(this, out);
+		out->pack_ea(m_line);
+	}
+
+	/**********************************************************************/
+	bool idaapi IdaViewPlace::deserialize(const uchar** pptr, const uchar* end)
+	{
+		if (!place_t__deserialize(this, pptr, end) || *pptr >= end)
+		{
+			return false;
+		}
+		m_line = unpack_ea(pptr, end);
+		return true;
+	}
+
+	/**********************************************************************/
+	int idaapi IdaViewPlace::id() const
+	{
+		return s_id;
+	}
+
+	/**********************************************************************/
+	const char* idaapi IdaViewPlace::name() const
+	{
+		return "yagi_place_t";
+	}
+} // end of namespace yagi
@@ -17,13 +17,148 @@
 #include "idatype.hh"
 #include "idasymbol.hh"
 #include "idalogger.hh"
+#include "idaview.hh"
+#include "trace.hh"
+#include "idasync.hh"
 #include <kernwin.hpp>
 #include <loader.hpp>
+#include <funcs.hpp>
+#include <xref.hpp>
+#include <libdecomp.hh>
 #include <sstream>
+#include <fstream>
 #include <algorithm>
+#include <map>
+#include <set>
 
 namespace yagi 
 {
+	/*!
+	 * \brief	Data attached to a decompiler view
+	 */
+	struct ViewerContext
+	{
+		/*!
+		 * \brief	displayed decompilation, lines are generated on demand
+		 */
+		CodeView lines;
+
+		/*!
+		 * \brief	use to report local edits that IDA doesn't notify
+		 */
+		std::shared_ptr<EpochTracker> epochs;
+
+		/*!
+		 * \brief	custom viewer that displays the lines
+		 */
+		TWidget* viewer;
+
+		/*!
+		 * \brief	views of the plugin by title, null once the plugin is gone
+		 */
+		ViewRegistry<ViewerContext>* views;
+	};
+
+	/*!
+	 * \brief	number of types translated by a slice of the background import
+	 */
+	static const size_t IMPORT_TYPES_BUDGET = 64;
+
+	/*!
+	 * \brief	delay between two slices of the background import in ms
+	 */
+	static const int IMPORT_TYPES_INTERVAL = 50;
+
+	/*!
+	 * \brief	delay between two checks of IDB changes
+	 *			for the refresh of opened views in ms
+	 */
+	static const int REFRESH_VIEWS_INTERVAL = 500;
+
+	/*!
+	 * \brief	run argument of the plugin that exports the type database
+	 *			(run_plugin from a script)
+	 */
+	static const size_t EXPORT_TYPES_ARG = 1;
+
+	/*!
+	 * \brief	run argument of the plugin that exports the profiling report
+	 *			of the session as JSON (needs the profile option)
+	 */
+	static const size_t EXPORT_PROFILE_ARG = 2;
+
+	/*!
+	 * \brief	run argument of the plugin that decompiles
+	 *			with the fast preview profile
+	 */
+	static const size_t PREVIEW_ARG = 3;
+
+	/*!
+	 * \brief	run argument of the plugin that exports the backend trace
+	 *			of the session (needs the record_trace option)
+	 */
+	static const size_t EXPORT_TRACE_ARG = 4;
+
+	/*!
+	 * \brief	run argument of the plugin that decompiles every function,
+	 *			callees first, to share recovered prototypes
+	 */
+	static const size_t DECOMPILE_ALL_ARG = 5;
+
+	/**********************************************************************/
+	static int idaapi _ImportTypesTimer(void* ud)
+	{
+		auto plugin = static_cast<Plugin*>(ud);
+		return plugin->importTypes() ? IMPORT_TYPES_INTERVAL : -1;
+	}
+
+	/**********************************************************************/
+	static int idaapi _RefreshViewsTimer(void* ud)
+	{
+		auto plugin = static_cast<Plugin*>(ud);
+		plugin->refreshViews();
+		return REFRESH_VIEWS_INTERVAL;
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Build the call graph of the IDB from code references
+	 * \return	every function and its direct calls
+	 */
+	static CallGraph _BuildCallGraph()
+	{
+		CallGraph graph;
+		for (size_t i = 0; i < get_func_qty(); i++)
+		{
+			auto func = getn_func(i);
+			if (func == nullptr)
+			{
+				continue;
+			}
+
+			graph.addFunction(func->start_ea);
+			func_item_iterator_t items;
+			for (auto ok = items.set(func); ok; ok = items.next_code())
+			{
+				xrefblk_t xref;
+				for (auto found = xref.first_from(items.current(), XREF_FAR); found; found = xref.next_from())
+				{
+					if (xref.type != fl_CN && xref.type != fl_CF)
+					{
+						continue;
+					}
+
+					auto callee = get_func(xref.to);
+					if (callee != nullptr && callee->start_ea == xref.to)
+					{
+						graph.addCall(func->start_ea, callee->start_ea);
+					}
+				}
+			}
+		}
+		return graph;
+	}
+
 	/**********************************************************************/
 	static void _RunYagi()
 	{
@@ -51,27 +186,19 @@ namespace yagi
 		auto typeFunc = typeInfo.toFunc();
 		if (typeFunc.has_value())
 		{
-			auto prototype = typeFunc.value()->getFuncPrototype();
-			std::string cc = "";
-			try
-			{
-				cc = typeFunc.value()->getCallingConv();
-			}
-			catch (UnknownCallingConvention&) {}
+			auto signature = typeFunc.value()->getSignature();
+			auto cc = signature.callingConv.value_or("");
 
-			auto paramIter = prototype.begin();
-
-			if (prototype.size() > 0)
+			if (signature.returnType != nullptr)
 			{
-				paramIter++;
 				std::string parametersDecl = "";
 
-				std::for_each(paramIter, prototype.end(), [&parametersDecl](const std::unique_ptr<TypeInfo>& info) {
+				std::for_each(signature.paramTypes.begin(), signature.paramTypes.end(), [&parametersDecl](const std::unique_ptr<TypeInfo>& info) {
 					parametersDecl += info->getName() + ",";
 				});
 
 				// Varargs management
-				if(typeFunc.value()->isDotDotDot())
+				if(signature.isDotDotDot)
 				{
 					parametersDecl += "...";
 				}
@@ -82,7 +209,7 @@ namespace yagi
 					parametersDecl = parametersDecl.substr(0, parametersDecl.size() - 1);
 				}
 
-				return prototype[0]->getName() + " " + cc + " " + name + "(" + parametersDecl + ");";
+				return signature.returnType->getName() + " " + cc + " " + name + "(" + parametersDecl + ");";
 			}
 		}
 
@@ -159,7 +286,8 @@ namespace yagi
 			return false;
 		}
 
-		auto code = static_cast<Decompiler::Result*>(ud);
+		auto context = static_cast<ViewerContext*>(ud);
+		auto code = &context->lines.getResult();
 		auto addr = code->symbolAddress.find(keyword.value());
 
 		if (addr == code->symbolAddress.end())
@@ -207,6 +335,7 @@ namespace yagi
 					if (ask_str(&name, HIST_IDENT, "Please enter item name"))
 					{
 						functionSymbolInfo.value()->saveName(addr->second, name.c_str());
+						context->epochs->touchAddress(code->ea);
 						_RunYagi();
 					}
 				}
@@ -245,6 +374,7 @@ namespace yagi
 						{
 							auto typeInfo = IdaTypeInfoFactory().build(idaTypeInfo);
 							functionSymbolInfo.value()->saveType(addr->second, *(typeInfo.value()));
+							context->epochs->touchAddress(code->ea);
 							_RunYagi();
 						}
 					}
@@ -255,6 +385,7 @@ namespace yagi
 			if (functionSymbolInfo.value()->clearType(addr->second))
 			{
 				IdaLogger().info("Clear type for symbol : ", addr->first);
+				context->epochs->touchAddress(code->ea);
 				_RunYagi();
 			}
 			break;
@@ -266,14 +397,52 @@ namespace yagi
 	/**********************************************************************/
 	static void idaapi _Close(TWidget* cv, void* ud)
 	{
-		auto code = static_cast<Decompiler::Result*>(ud);
-		delete code;
+		auto context = static_cast<ViewerContext*>(ud);
+		if (context->views != nullptr)
+		{
+			// the function may have been renamed since the view was opened
+			context->views->remove(context);
+		}
+		delete context;
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Display a new decompilation in an existing view
+	 *			The cursor follows its line through the diff of old and new lines
+	 *			and stays at the same row of the screen
+	 * \param	context	context of the view
+	 * \param	code	new decompilation
+	 */
+	static void _Refresh(ViewerContext& context, std::shared_ptr<const Decompiler::Result> code)
+	{
+		int x = 0, y = 0;
+		uval_t line = 0;
+		auto place = get_custom_viewer_place(context.viewer, false, &x, &y);
+		if (place != nullptr)
+		{
+			line = place->touval(&context.lines);
+		}
+
+		// places keep pointing to context.lines, only its content changes
+		CodeView lines(code);
+		auto diff = CodeView::diff(context.lines, lines);
+		context.lines = std::move(lines);
+
+		auto size = context.lines.size();
+		IdaViewPlace first;
+		IdaViewPlace last(size == 0 ? 0 : size - 1);
+		set_custom_viewer_range(context.viewer, &first, &last);
+
+		IdaViewPlace cursor(diff.remap(line));
+		jumpto(context.viewer, &cursor, x, y);
+		refresh_custom_viewer(context.viewer);
 	}
 
 	/**********************************************************************/
 	static bool idaapi _DoubleClickCallback(TWidget* w, int shift, void* ud) 
 	{
-		auto code = static_cast<Decompiler::Result*>(ud);
+		auto code = &static_cast<ViewerContext*>(ud)->lines.getResult();
 		auto keyword = _ComputeKeyword(w);
 		if (!keyword.has_value())
 		{
@@ -295,15 +464,13 @@ namespace yagi
 		else if (addr->second.spaceName == "stack" || addr->second.spaceName == "const")
 		{
 			auto idaFunc = get_func(code->ea);
-			auto offset = addr->second.offset;
-			// As ghidra handle 32 bit address even in 64 bits
-			// and stack address cound be negative
-			if (addr->second.addrSize == 4 && (int32_t)addr->second.offset < 0)
+			if (idaFunc == nullptr)
 			{
-				offset = 0xFFFFFFFF00000000 | offset;
+				return false;
 			}
 
-			open_frame_window(idaFunc, offset + (idaFunc->frsize + idaFunc->frregs));
+			IdaFrameMap frame(code->ea);
+			open_frame_window(idaFunc, frame.toFrameOffset(addr->second.offset, addr->second.addrSize));
 		}
 		
 		return false;
@@ -323,46 +490,401 @@ namespace yagi
 	);
 
 	/**********************************************************************/
-	Plugin::Plugin(std::unique_ptr<Decompiler> decompiler)
-		: m_decompiler(std::move(decompiler))
-	{}
+	bool Plugin::hasOption(const std::string& option)
+	{
+		auto options = get_plugin_options("yagi");
+		if (options == nullptr)
+		{
+			return false;
+		}
+
+		std::istringstream iss(options);
+		for (std::string item; std::getline(iss, item, ':'); )
+		{
+			if (item == option)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
 
 	/**********************************************************************/
-	bool idaapi Plugin::run(size_t)
+	Plugin::Plugin(std::unique_ptr<Decompiler> decompiler, std::shared_ptr<EpochTracker> epochs, std::shared_ptr<MainThread> mainThread, std::shared_ptr<TraceRecorder> recorder)
+		: m_decompiler(std::move(decompiler)), m_epochs(epochs), m_mainThread(mainThread), m_recorder(recorder), m_busy(std::make_shared<std::atomic<bool>>(false)), m_listener(epochs), m_importTimer(nullptr), m_importStep(0), m_refreshEpoch(epochs->getCurrent())
 	{
-		auto func_address = get_screen_ea();
+		m_refreshTimer = register_timer(REFRESH_VIEWS_INTERVAL, _RefreshViewsTimer, this);
+
+		if (hasOption("import_types"))
+		{
+			IdaLogger().info("Start background import of local types");
+			m_importTimer = register_timer(IMPORT_TYPES_INTERVAL, _ImportTypesTimer, this);
+		}
+
+		if (hasOption("profile"))
+		{
+			IdaLogger().info("Profiling of decompilation enabled");
+			m_decompiler->setProfiling(true);
+		}
+	}
+
+	/**********************************************************************/
+	Plugin::~Plugin()
+	{
+		if (m_importTimer != nullptr)
+		{
+			unregister_timer(m_importTimer);
+		}
+		unregister_timer(m_refreshTimer);
+
+		// views may outlive the plugin
+		for (auto& [name, context] : m_views)
+		{
+			context->views = nullptr;
+		}
+
+		// a running decompilation stops at its next stage or query,
+		// closing the gate also releases a query waiting for this thread
+		m_decompiler->cancel();
+		m_mainThread->close();
+		if (m_worker.joinable())
+		{
+			m_worker.join();
+		}
+	}
+
+	/**********************************************************************/
+	bool Plugin::importTypes()
+	{
+		// the decompiler is used by the worker, try again later
+		if (*m_busy)
+		{
+			return true;
+		}
+
+		auto progress = m_decompiler->importTypes(IMPORT_TYPES_BUDGET);
+		if (progress.isFinished())
+		{
+			IdaLogger().info("Local types imported :", std::to_string(progress.total));
+			m_importTimer = nullptr;
+			return false;
+		}
+
+		auto step = progress.done * 10 / progress.total;
+		if (step != m_importStep)
+		{
+			m_importStep = step;
+			IdaLogger().info("Importing local types :", std::to_string(progress.done), "/", std::to_string(progress.total));
+		}
+		return true;
+	}
+
+	/**********************************************************************/
+	void Plugin::refreshViews()
+	{
+		// the decompiler is used by the worker, try again later
+		auto epoch = m_epochs->getCurrent();
+		if (epoch == m_refreshEpoch || *m_busy)
+		{
+			return;
+		}
+		m_refreshEpoch = epoch;
+
+		std::set<uint64_t> opened;
+		for (auto& [name, context] : m_views)
+		{
+			opened.insert(context->lines.getResult().ea);
+		}
+
+		if (opened.empty())
+		{
+			return;
+		}
+
+		// other stale functions are decompiled again on demand
+		startWorker([this, mainThread = m_mainThread, opened = std::move(opened)](Decompiler& decompiler) {
+			for (auto ea : decompiler.getStaleFunctions())
+			{
+				if (opened.count(ea) == 0)
+				{
+					continue;
+				}
+
+				auto decompilerResult = decompiler.decompile(ea);
+				if (!decompilerResult.has_value())
+				{
+					continue;
+				}
+
+				auto code = std::make_shared<const Decompiler::Result>(std::move(decompilerResult.value()));
+				mainThread->execute([this, code]() {
+					refreshView(code);
+				}, true);
+			}
+		});
+	}
+
+	/**********************************************************************/
+	bool idaapi Plugin::run(size_t arg)
+	{
+		if (arg == EXPORT_TYPES_ARG)
+		{
+			exportTypes();
+			return true;
+		}
+
+		if (arg == EXPORT_PROFILE_ARG)
+		{
+			exportProfile();
+			return true;
+		}
+
+		if (arg == EXPORT_TRACE_ARG)
+		{
+			exportTrace();
+			return true;
+		}
 
-		auto decompilerResult = m_decompiler->decompile(func_address);
-		if (decompilerResult.has_value())
+		if (arg == DECOMPILE_ALL_ARG)
 		{
-			view(decompilerResult.value().name, decompilerResult.value());
+			decompileAll();
+			return true;
 		}
+
+		auto func_address = get_screen_ea();
+		auto profile = arg == PREVIEW_ARG ? Decompiler::Profile::Preview : Decompiler::Profile::Full;
+
+		startWorker([this, mainThread = m_mainThread, func_address, profile](Decompiler& decompiler) {
+			auto decompilerResult = decompiler.decompile(func_address, profile);
+
+			std::stringstream report;
+			if (decompiler.writeProfile(report, false, Decompiler::ProfileFormat::Text))
+			{
+				IdaLogger().info("Decompilation profile\n", report.str());
+			}
+
+			if (decompilerResult.has_value())
+			{
+				auto code = std::make_shared<const Decompiler::Result>(std::move(decompilerResult.value()));
+
+				// the plugin is alive as long as the main thread is open
+				mainThread->execute([this, code]() {
+					view(code);
+				}, true);
+			}
+		});
 		
 		return true;
 	}
 
 	/**********************************************************************/
-	void Plugin::view(const std::string& name, const Decompiler::Result& code) const
+	bool Plugin::startWorker(std::function<void(Decompiler&)> task)
+	{
+		if (*m_busy)
+		{
+			IdaLogger().info("A decompilation is already running");
+			return false;
+		}
+
+		if (m_worker.joinable())
+		{
+			m_worker.join();
+		}
+
+		// the worker is joined by the plugin destructor
+		*m_busy = true;
+		m_worker = std::thread([task, decompiler = m_decompiler, busy = m_busy]() {
+			try
+			{
+				task(*decompiler);
+			}
+			catch (MainThreadClosed&)
+			{
+				// plugin is closed, nothing to display
+			}
+			catch (DecompilationCanceled&)
+			{
+				// plugin is closed, nothing to display
+			}
+			catch (Error& e)
+			{
+				IdaLogger().error(e.what());
+			}
+			catch (LowlevelError& e)
+			{
+				IdaLogger().error(e.explain);
+			}
+			catch (std::exception& e)
+			{
+				IdaLogger().error(e.what());
+			}
+			catch (...)
+			{
+				IdaLogger().error("Unexpected error in the decompilation worker");
+			}
+			*busy = false;
+		});
+		return true;
+	}
+
+	/**********************************************************************/
+	void Plugin::decompileAll()
+	{
+		if (*m_busy)
+		{
+			IdaLogger().info("A decompilation is already running");
+			return;
+		}
+
+		auto graph = _BuildCallGraph();
+		IdaLogger().info("Decompiling all functions :", std::to_string(graph.size()));
+
+		startWorker([graph = std::move(graph)](Decompiler& decompiler) {
+			auto count = decompiler.decompileAll(graph);
+			IdaLogger().info("Functions decompiled :", std::to_string(count), "/", std::to_string(graph.size()));
+		});
+	}
+
+	/**********************************************************************/
+	void Plugin::exportTypes() const
+	{
+		auto path = ask_file(true, "*.ytdb", "Export type database");
+		if (path == nullptr)
+		{
+			return;
+		}
+
+		try
+		{
+			TypeDatabaseWriter writer;
+			auto count = IdaTypeInfoFactory().exportTypes(writer);
+			writer.save(path);
+			IdaLogger().info("Type database exported :", std::string(path), std::to_string(count) + " entries");
+		}
+		catch (Error& e)
+		{
+			IdaLogger().error(e.what());
+		}
+	}
+
+	/**********************************************************************/
+	void Plugin::exportProfile() const
 	{
-		strvec_t* sv = new strvec_t();
-		std::istringstream iss(code.cCode);
-		for (std::string line; std::getline(iss, line); )
+		if (*m_busy)
+		{
+			IdaLogger().error("A decompilation is running, try again later");
+			return;
+		}
+
+		std::stringstream profile;
+		if (!m_decompiler->writeProfile(profile, true, Decompiler::ProfileFormat::Json))
+		{
+			IdaLogger().error("Profiling is disabled, use -Oyagi:profile");
+			return;
+		}
+
+		auto path = ask_file(true, "*.json", "Export profiling report");
+		if (path == nullptr)
 		{
-			sv->push_back(simpleline_t(line.c_str()));
+			return;
 		}
 
-		simpleline_place_t s1;
-		simpleline_place_t s2((int)(sv->size() - 1));
+		std::ofstream output(path);
+		output << profile.str();
+		if (!output)
+		{
+			IdaLogger().error("Unable to write profiling report", std::string(path));
+			return;
+		}
+		IdaLogger().info("Profiling report exported :", std::string(path));
+	}
+
+	/**********************************************************************/
+	void Plugin::exportTrace() const
+	{
+		if (m_recorder == nullptr)
+		{
+			IdaLogger().error("Trace recording is disabled, use -Oyagi:record_trace");
+			return;
+		}
+
+		if (*m_busy)
+		{
+			IdaLogger().error("A decompilation is running, try again later");
+			return;
+		}
+
+		auto path = ask_file(true, "*.ytrc", "Export backend trace");
+		if (path == nullptr)
+		{
+			return;
+		}
+
+		// timers keep running while the dialog is open and may start the worker,
+		// the worker is only started from the main thread so it can't start once checked
+		if (*m_busy)
+		{
+			IdaLogger().error("A decompilation is running, try again later");
+			return;
+		}
+
+		try
+		{
+			m_recorder->save(path);
+			IdaLogger().info("Backend trace exported :", std::string(path));
+		}
+		catch (Error& e)
+		{
+			IdaLogger().error(e.what());
+		}
+	}
+
+	/**********************************************************************/
+	void Plugin::view(std::shared_ptr<const Decompiler::Result> code)
+	{
+		IdaViewPlace::registerClass();
+
+		auto name = code->name;
+		auto found = m_views.find(name);
+		if (found != nullptr)
+		{
+			_Refresh(*found, code);
+			activate_widget(find_widget(name.c_str()), true);
+			return;
+		}
+
+		auto context = new ViewerContext{ CodeView(code), m_epochs, nullptr, &m_views };
+		auto lines = context->lines.size();
+
+		IdaViewPlace s1;
+		IdaViewPlace s2(lines == 0 ? 0 : lines - 1);
 		auto oldWidget = find_widget(name.c_str());
 		if (oldWidget != nullptr)
 		{
 			close_widget(oldWidget, 0);
 		}
 
+		// places read their lines from the CodeView owned by the context
 		auto w = create_custom_viewer(name.c_str(), &s1, &s2,
-			&s1, nullptr, sv, &_ViewHandlers, new Decompiler::Result(code));
+			&s1, nullptr, &context->lines, &_ViewHandlers, context);
+		context->viewer = w;
+		m_views.add(name, context);
 		TWidget* code_view = create_code_viewer(w);
 		set_code_viewer_is_source(code_view);
 		display_widget(code_view, WOPN_DP_TAB);
 	}
+
+	/**********************************************************************/
+	void Plugin::refreshView(std::shared_ptr<const Decompiler::Result> code)
+	{
+		// the function may have been renamed, its view keeps its title
+		for (auto& [name, context] : m_views)
+		{
+			if (context->lines.getResult().ea == code->ea)
+			{
+				_Refresh(*context, code);
+				return;
+			}
+		}
+	}
 } // end of namespace yagi
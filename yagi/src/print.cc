@@ -3,6 +3,8 @@
 #include "varnode.hh"
 #include "funcdata.hh"
 
+#include <cstring>
+
 
 #define COLOR_ON        '\1'     ///< Escape character (ON).
 ///< Followed by a color code (::color_t).
@@ -90,20 +92,34 @@ namespace yagi
 		return *static_cast<IdaEmit*>(emit);
 	}
 
+	/**********************************************************************/
+	/*!
+	 * \brief	Skip the import prefix of a symbol name
+	 * \return	true if the name is an import
+	 */
+	static bool _SkipImportPrefix(const char*& ptr)
+	{
+		auto& prefix = SymbolInfo::IMPORT_PREFIX;
+		if (std::strncmp(ptr, prefix.c_str(), prefix.length()) != 0)
+		{
+			return false;
+		}
+		ptr += prefix.length();
+		return true;
+	}
+
 	/**********************************************************************/
 	void IdaEmit::startColorTag(char c)
 	{
-		std::stringstream ss;
-		ss << COLOR_ON << c;
-		EmitPrettyPrint::print(ss.str().c_str());
+		const char tag[] = { COLOR_ON, c, '\0' };
+		EmitPrettyPrint::print(tag);
 	}
 
 	/**********************************************************************/
 	void IdaEmit::endColorTag(char c)
 	{
-		std::stringstream ss;
-		ss << COLOR_OFF << c;
-		EmitPrettyPrint::print(ss.str().c_str());
+		const char tag[] = { COLOR_OFF, c, '\0' };
+		EmitPrettyPrint::print(tag);
 	}
 
 	/**********************************************************************/
@@ -137,14 +153,8 @@ namespace yagi
 	void IdaEmit::tagVariable(const char* ptr, syntax_highlight hl,
 		const Varnode* vn, const PcodeOp* op)
 	{
-		auto name = std::string(ptr);
-		bool isImport = false;
-
-		if (name.substr(0, SymbolInfo::IMPORT_PREFIX.length()) == SymbolInfo::IMPORT_PREFIX)
-		{
-			isImport = true;
-			name = name.substr(SymbolInfo::IMPORT_PREFIX.length(), name.length() - SymbolInfo::IMPORT_PREFIX.length());
-		}
+		auto name = ptr;
+		auto isImport = _SkipImportPrefix(name);
 
 		// case of variable declaration
 		if (op == nullptr)
@@ -155,48 +165,42 @@ namespace yagi
 		if (isImport)
 		{
 			EmitColorGuard guard(*this, COLOR_IMPNAME);
-			EmitPrettyPrint::tagVariable(name.c_str(), hl, vn, op);
+			EmitPrettyPrint::tagVariable(name, hl, vn, op);
 		}
 		// Constant string
 		else if (*ptr == '\"' || *ptr == '\'')
 		{
 			EmitColorGuard guard(*this, COLOR_DSTR);
-			EmitPrettyPrint::tagVariable(name.c_str(), hl, vn, op);
+			EmitPrettyPrint::tagVariable(name, hl, vn, op);
 		}
 		// unicode string
 		else if (*ptr == 'L' && ptr[1] != '\0' && (ptr[1] == '\"' || ptr[1] == '\''))
 		{
 			EmitColorGuard guard(*this, COLOR_DSTR);
-			EmitPrettyPrint::tagVariable(name.c_str(), hl, vn, op);
+			EmitPrettyPrint::tagVariable(name, hl, vn, op);
 		}
 		else
 		{
 			EmitColorGuard guard(*this, hl);
-			EmitPrettyPrint::tagVariable(name.c_str(), hl, vn, op);
+			EmitPrettyPrint::tagVariable(name, hl, vn, op);
 		}
 	}
 
 	/**********************************************************************/
 	void IdaEmit::tagFuncName(const char* ptr, syntax_highlight hl, const Funcdata* fd, const PcodeOp* op)
 	{
-		auto name = std::string(ptr);
-		bool isImport = false;
+		auto name = ptr;
+		auto isImport = _SkipImportPrefix(name);
 
-		if (name.substr(0, SymbolInfo::IMPORT_PREFIX.length()) == SymbolInfo::IMPORT_PREFIX)
-		{
-			isImport = true;
-			name = name.substr(SymbolInfo::IMPORT_PREFIX.length(), name.length() - SymbolInfo::IMPORT_PREFIX.length());
-		}
-		
 		if (isImport)
 		{
 			EmitColorGuard guard(*this, COLOR_IMPNAME);
-			EmitPrettyPrint::tagFuncName(name.c_str(), hl, fd, op);
+			EmitPrettyPrint::tagFuncName(name, hl, fd, op);
 		}
 		else
 		{
 			EmitColorGuard guard(*this, hl);
-			EmitPrettyPrint::tagFuncName(name.c_str(), hl, fd, op);
+			EmitPrettyPrint::tagFuncName(name, hl, fd, op);
 		}
 	}
 
@@ -0,0 +1,243 @@
+#include "profiler.hh"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace yagi
+{
+	/**********************************************************************/
+	/*!
+	 * \brief	Escape a string for JSON output
+	 */
+	static std::string _JsonEscape(const std::string& value)
+	{
+		std::string result;
+		for (auto c : value)
+		{
+			switch (c)
+			{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\t': result += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					continue;
+				}
+				result += c;
+			}
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Read the value of "key=value" in a statistics line
+	 */
+	static bool _ReadCounter(const std::string& line, const std::string& key, size_t& position, uint64_t& value)
+	{
+		position = line.rfind(" " + key + "=");
+		if (position == std::string::npos)
+		{
+			return false;
+		}
+
+		try
+		{
+			value = std::stoull(line.substr(position + key.size() + 2));
+		}
+		catch (std::exception&)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	/**********************************************************************/
+	ProfileReport::ProfileReport()
+		: m_functions{ 0 }
+	{}
+
+	/**********************************************************************/
+	void ProfileReport::add(const ProfileEntry& entry)
+	{
+		auto found = m_entries.find(entry.name);
+		if (found == m_entries.end())
+		{
+			m_entries.emplace(entry.name, entry);
+			return;
+		}
+
+		found->second.calls += entry.calls;
+		found->second.time += entry.time;
+		found->second.tests += entry.tests;
+		found->second.applies += entry.applies;
+		found->second.changes += entry.changes;
+	}
+
+	/**********************************************************************/
+	void ProfileReport::merge(const ProfileReport& other)
+	{
+		for (auto& [name, entry] : other.m_entries)
+		{
+			add(entry);
+		}
+		m_functions += std::max<size_t>(other.m_functions, 1);
+	}
+
+	/**********************************************************************/
+	void ProfileReport::clear()
+	{
+		m_entries.clear();
+		m_functions = 0;
+	}
+
+	/**********************************************************************/
+	std::vector<ProfileEntry> ProfileReport::getSorted() const
+	{
+		std::vector<ProfileEntry> result;
+		for (auto& [name, entry] : m_entries)
+		{
+			result.push_back(entry);
+		}
+
+		std::stable_sort(result.begin(), result.end(), [](const ProfileEntry& a, const ProfileEntry& b) {
+			if (a.time != b.time)
+			{
+				return a.time > b.time;
+			}
+			if (a.applies != b.applies)
+			{
+				return a.applies > b.applies;
+			}
+			return a.tests > b.tests;
+		});
+		return result;
+	}
+
+	/**********************************************************************/
+	size_t ProfileReport::getFunctionCount() const
+	{
+		return m_functions;
+	}
+
+	/**********************************************************************/
+	void ProfileReport::toText(std::ostream& out) const
+	{
+		out << "functions: " << m_functions << "\n";
+		out << std::left << std::setw(48) << "name"
+			<< std::right << std::setw(12) << "time(us)"
+			<< std::setw(10) << "calls"
+			<< std::setw(12) << "tests"
+			<< std::setw(12) << "applies"
+			<< std::setw(10) << "changes" << "\n";
+
+		for (auto& entry : getSorted())
+		{
+			out << std::left << std::setw(48) << entry.name
+				<< std::right << std::setw(12) << std::chrono::duration_cast<std::chrono::microseconds>(entry.time).count()
+				<< std::setw(10) << entry.calls
+				<< std::setw(12) << entry.tests
+				<< std::setw(12) << entry.applies
+				<< std::setw(10) << entry.changes << "\n";
+		}
+	}
+
+	/**********************************************************************/
+	void ProfileReport::toJson(std::ostream& out) const
+	{
+		out << "{\"functions\":" << m_functions << ",\"entries\":[";
+		auto first = true;
+		for (auto& entry : getSorted())
+		{
+			out << (first ? "" : ",")
+				<< "{\"name\":\"" << _JsonEscape(entry.name) << "\""
+				<< ",\"time_ns\":" << entry.time.count()
+				<< ",\"calls\":" << entry.calls
+				<< ",\"tests\":" << entry.tests
+				<< ",\"applies\":" << entry.applies
+				<< ",\"changes\":" << entry.changes << "}";
+			first = false;
+		}
+		out << "]}";
+	}
+
+	/**********************************************************************/
+	void Profiler::begin(const std::string& function)
+	{
+		m_function = function;
+		m_current.clear();
+	}
+
+	/**********************************************************************/
+	void Profiler::end()
+	{
+		m_last.clear();
+		m_last.merge(m_current);
+		m_session.merge(m_current);
+		m_current.clear();
+	}
+
+	/**********************************************************************/
+	void Profiler::addStage(const std::string& stage, std::chrono::nanoseconds time, int64_t changes)
+	{
+		m_current.add(ProfileEntry{ stage, 1, time, 0, 0, changes > 0 ? uint64_t(changes) : 0 });
+	}
+
+	/**********************************************************************/
+	void Profiler::addCounter(const std::string& name, uint64_t tests, uint64_t applies)
+	{
+		m_current.add(ProfileEntry{ name, 1, std::chrono::nanoseconds(0), tests, applies, 0 });
+	}
+
+	/**********************************************************************/
+	void Profiler::addStatistics(const std::string& stage, std::istream& statistics)
+	{
+		for (std::string line; std::getline(statistics, line); )
+		{
+			size_t testedPosition, appliedPosition;
+			uint64_t tests, applies;
+			// actions print "Apply=", rules print "Applied="
+			if (!_ReadCounter(line, "Tested", testedPosition, tests) ||
+				(!_ReadCounter(line, "Applied", appliedPosition, applies) && !_ReadCounter(line, "Apply", appliedPosition, applies)))
+			{
+				continue;
+			}
+
+			// skip actions and rules never tried for this function
+			if (tests == 0 && applies == 0)
+			{
+				continue;
+			}
+
+			auto start = line.find_first_not_of(" \t");
+			auto end = std::min(testedPosition, appliedPosition);
+			if (start == std::string::npos || start >= end)
+			{
+				continue;
+			}
+
+			auto name = line.substr(start, end - start);
+			addCounter(stage + "/" + name, tests, applies);
+		}
+	}
+
+	/**********************************************************************/
+	const std::string& Profiler::getLastFunction() const
+	{
+		return m_function;
+	}
+
+	/**********************************************************************/
+	const ProfileReport& Profiler::getLastReport() const
+	{
+		return m_last;
+	}
+
+	/**********************************************************************/
+	const ProfileReport& Profiler::getSessionReport() const
+	{
+		return m_session;
+	}
+} // end of namespace yagi
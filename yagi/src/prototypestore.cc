@@ -0,0 +1,117 @@
+#include "prototypestore.hh"
+
+#include <algorithm>
+#include <mutex>
+
+namespace yagi
+{
+	/**********************************************************************/
+	/*!
+	 * \brief	Check if two prototypes are applied the same way to a function
+	 *			votes that don't change the lock keep the version
+	 */
+	static bool _SameAnswer(const RecoveredPrototype& a, const RecoveredPrototype& b)
+	{
+		return a.model == b.model && a.output == b.output && a.inputs == b.inputs &&
+			a.names == b.names && a.isDotDotDot == b.isDotDotDot && a.source == b.source &&
+			a.isLocked() == b.isLocked();
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Merge a new recovery into the retained prototype of a function
+	 */
+	static void _Merge(RecoveredPrototype& current, RecoveredPrototype prototype)
+	{
+		if (prototype.source != current.source)
+		{
+			if (prototype.source > current.source)
+			{
+				current = std::move(prototype);
+			}
+			return;
+		}
+
+		// a new decompilation of the function is the best knowledge
+		if (prototype.source == RecoveredPrototype::Source::Decompilation)
+		{
+			current = std::move(prototype);
+			return;
+		}
+
+		// a caller that guesses again replaces its previous vote
+		auto agree = prototype.inputs.size() == current.inputs.size();
+		for (auto caller : prototype.callers)
+		{
+			if (agree)
+			{
+				current.dissenters.erase(caller);
+				current.callers.insert(caller);
+			}
+			else
+			{
+				current.callers.erase(caller);
+				current.dissenters.insert(caller);
+			}
+		}
+
+		if (current.callers.size() <= current.dissenters.size())
+		{
+			current = std::move(prototype);
+			return;
+		}
+
+		current.confidence = static_cast<uint32_t>(current.callers.size() - current.dissenters.size());
+		if (agree)
+		{
+			current.epoch = std::max(current.epoch, prototype.epoch);
+		}
+	}
+
+	/**********************************************************************/
+	void PrototypeStore::publish(uint64_t ea, RecoveredPrototype prototype, uint64_t validSince)
+	{
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		auto found = m_prototypes.find(ea);
+		if (found == m_prototypes.end() || found->second.epoch < validSince)
+		{
+			m_prototypes.insert_or_assign(ea, std::move(prototype));
+			m_versions[ea]++;
+			return;
+		}
+
+		auto before = found->second;
+		_Merge(found->second, std::move(prototype));
+		if (!_SameAnswer(before, found->second))
+		{
+			m_versions[ea]++;
+		}
+	}
+
+	/**********************************************************************/
+	std::optional<RecoveredPrototype> PrototypeStore::find(uint64_t ea, uint64_t validSince) const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		auto found = m_prototypes.find(ea);
+		if (found == m_prototypes.end() || found->second.epoch < validSince)
+		{
+			return std::nullopt;
+		}
+		return found->second;
+	}
+
+	/**********************************************************************/
+	uint64_t PrototypeStore::getVersion(uint64_t ea) const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		auto found = m_versions.find(ea);
+		return found == m_versions.end() ? 0 : found->second;
+	}
+
+	/**********************************************************************/
+	size_t PrototypeStore::size() const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_prototypes.size();
+	}
+} // end of namespace yagi
@@ -0,0 +1,237 @@
+#include "scheduler.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace yagi
+{
+	/*!
+	 * \brief	Ready tasks of a worker
+	 *			the owner works on the newest, thieves take the oldest
+	 */
+	struct _WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<size_t> tasks;
+	};
+
+	/*!
+	 * \brief	State shared by the workers of a run
+	 */
+	struct _Schedule
+	{
+		/*!
+		 * \brief	components of the call graph, callees first
+		 */
+		std::vector<std::vector<uint64_t>> components;
+
+		/*!
+		 * \brief	components calling each component
+		 */
+		std::vector<std::vector<size_t>> callers;
+
+		/*!
+		 * \brief	number of called components not done yet
+		 */
+		std::vector<std::atomic<size_t>> pending;
+
+		std::vector<_WorkerQueue> queues;
+
+		/*!
+		 * \brief	protect queued, remaining and error
+		 */
+		std::mutex mutex;
+		std::condition_variable signal;
+		size_t queued;
+		size_t remaining;
+		std::exception_ptr error;
+		std::atomic<bool> canceled;
+
+		explicit _Schedule(std::vector<std::vector<uint64_t>> components, size_t workers)
+			: components{ std::move(components) }, callers(this->components.size()), pending(this->components.size()),
+			queues(workers), queued{ 0 }, remaining{ this->components.size() }, canceled{ false }
+		{}
+	};
+
+	/**********************************************************************/
+	static void _Push(_Schedule& schedule, size_t worker, size_t task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(schedule.queues[worker].mutex);
+			schedule.queues[worker].tasks.push_back(task);
+		}
+		{
+			std::lock_guard<std::mutex> lock(schedule.mutex);
+			schedule.queued++;
+		}
+		schedule.signal.notify_one();
+	}
+
+	/**********************************************************************/
+	static std::optional<size_t> _Take(_Schedule& schedule, size_t worker)
+	{
+		std::optional<size_t> task;
+		for (size_t i = 0; i < schedule.queues.size() && !task.has_value(); i++)
+		{
+			auto& queue = schedule.queues[(worker + i) % schedule.queues.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.tasks.empty())
+			{
+				continue;
+			}
+
+			// own queue first, then steal
+			if (i == 0)
+			{
+				task = queue.tasks.back();
+				queue.tasks.pop_back();
+			}
+			else
+			{
+				task = queue.tasks.front();
+				queue.tasks.pop_front();
+			}
+		}
+
+		if (task.has_value())
+		{
+			std::lock_guard<std::mutex> lock(schedule.mutex);
+			schedule.queued--;
+		}
+		return task;
+	}
+
+	/**********************************************************************/
+	static void _Work(_Schedule& schedule, size_t worker, const CallGraphScheduler::Job& job)
+	{
+		while (!schedule.canceled)
+		{
+			auto task = _Take(schedule, worker);
+			if (!task.has_value())
+			{
+				std::unique_lock<std::mutex> lock(schedule.mutex);
+				schedule.signal.wait(lock, [&schedule]() {
+					return schedule.queued > 0 || schedule.remaining == 0 || schedule.canceled;
+				});
+				if (schedule.remaining == 0)
+				{
+					return;
+				}
+				continue;
+			}
+
+			try
+			{
+				job(schedule.components[task.value()]);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(schedule.mutex);
+				if (!schedule.error)
+				{
+					schedule.error = std::current_exception();
+				}
+				schedule.canceled = true;
+				schedule.signal.notify_all();
+				return;
+			}
+
+			// a caller is likely to use what was just computed, keep it local
+			for (auto caller : schedule.callers[task.value()])
+			{
+				if (--schedule.pending[caller] == 0)
+				{
+					_Push(schedule, worker, caller);
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(schedule.mutex);
+			if (--schedule.remaining == 0)
+			{
+				schedule.signal.notify_all();
+			}
+		}
+	}
+
+	/**********************************************************************/
+	CallGraphScheduler::CallGraphScheduler(size_t workers)
+		: m_workers{ std::max<size_t>(workers, 1) }
+	{}
+
+	/**********************************************************************/
+	void CallGraphScheduler::run(const CallGraph& graph, const Job& job) const
+	{
+		_Schedule schedule(graph.getComponents(), m_workers);
+		if (schedule.components.empty())
+		{
+			return;
+		}
+
+		std::map<uint64_t, size_t> componentOf;
+		for (size_t i = 0; i < schedule.components.size(); i++)
+		{
+			for (auto ea : schedule.components[i])
+			{
+				componentOf[ea] = i;
+			}
+		}
+
+		// a component waits for every other component it calls
+		for (size_t i = 0; i < schedule.components.size(); i++)
+		{
+			std::vector<size_t> callees;
+			for (auto ea : schedule.components[i])
+			{
+				for (auto callee : graph.getCallees(ea))
+				{
+					auto component = componentOf.at(callee);
+					if (component != i)
+					{
+						callees.push_back(component);
+					}
+				}
+			}
+
+			std::sort(callees.begin(), callees.end());
+			callees.erase(std::unique(callees.begin(), callees.end()), callees.end());
+			schedule.pending[i] = callees.size();
+			for (auto callee : callees)
+			{
+				schedule.callers[callee].push_back(i);
+			}
+		}
+
+		size_t next = 0;
+		for (size_t i = 0; i < schedule.components.size(); i++)
+		{
+			if (schedule.pending[i] == 0)
+			{
+				_Push(schedule, next++ % m_workers, i);
+			}
+		}
+
+		// the calling thread is the first worker
+		std::vector<std::thread> threads;
+		for (size_t worker = 1; worker < m_workers; worker++)
+		{
+			threads.emplace_back(_Work, std::ref(schedule), worker, std::cref(job));
+		}
+		_Work(schedule, 0, job);
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		if (schedule.error)
+		{
+			std::rethrow_exception(schedule.error);
+		}
+	}
+} // end of namespace yagi
@@ -8,9 +8,25 @@
 
 namespace yagi 
 {
+	/*!
+	 * \brief	Record a symbol lookup into the dependencies of the running decompilation
+	 * \param	archi	architecture of the scope
+	 * \param	ea	looked up address
+	 */
+	static void _AddDependency(YagiArchitecture* archi, uint64_t ea)
+	{
+		auto dependencies = archi->getDependencies();
+		if (dependencies != nullptr)
+		{
+			dependencies->addAddress(ea);
+		}
+	}
+
 	/**********************************************************************/
 	YagiScope::YagiScope(uint8_t id, YagiArchitecture* architecture)
-		: Scope(id, "", architecture, this), m_proxy(0, "", architecture, this)
+		: Scope(id, "", architecture, this), 
+		m_proxy(0, "", architecture, this), 
+		m_persistent(1, "", architecture, this)
 	{}
 
 	/**********************************************************************/
@@ -19,16 +35,58 @@ namespace yagi
 		return &m_proxy;
 	}
 
+	/**********************************************************************/
+	ScopeInternal* YagiScope::getPersistent()
+	{
+		return &m_persistent;
+	}
+
+	/**********************************************************************/
+	void YagiScope::clearPersistent()
+	{
+		m_persistent.clear();
+	}
+
+	/**********************************************************************/
+	void YagiScope::invalidate(const std::set<uint64_t>& addresses, const std::set<Datatype*>& types)
+	{
+		std::set<Symbol*> stale;
+		for (auto iter = m_proxy.begin(); iter != m_proxy.end(); ++iter)
+		{
+			auto symbol = (*iter)->getSymbol();
+			if (addresses.find((*iter)->getAddr().getOffset()) != addresses.end() ||
+				types.find(symbol->getType()) != types.end() ||
+				(!types.empty() && dynamic_cast<FunctionSymbol*>(symbol) != nullptr))
+			{
+				stale.insert(symbol);
+			}
+		}
+
+		for (auto symbol : stale)
+		{
+			m_proxy.removeSymbol(symbol);
+		}
+	}
+
 	/**********************************************************************/
 	Funcdata* YagiScope::findFunction(const Address& addr) const
 	{
 		auto yagiScope = static_cast<YagiScope*>(glb->symboltab->getGlobalScope());
 		auto proxy = yagiScope->getProxy();
 		auto archi = static_cast<YagiArchitecture*>(glb);
+		auto types = static_cast<TypeManager*>(glb->types);
+		_AddDependency(archi, addr.getOffset());
 
 		auto result = proxy->findFunction(addr);
+		if (result == nullptr)
+		{
+			result = yagiScope->getPersistent()->findFunction(addr);
+		}
+
 		if (result != nullptr)
 		{
+			// the prototype was translated by a previous decompilation
+			types->addDependencies(result->getFuncProto());
 			return result;
 		}
 
@@ -48,12 +106,13 @@ namespace yagi
 		auto injection = archi->findInjection(funcData->getName());
 		if (injection.has_value())
 		{
-			archi->getLogger().info("Perform injection ", injection.value());
+			YAGI_DEBUG(archi->getLogger(), "Perform injection ", injection.value());
 			yagiScope->setInjectAttribute(*funcData, injection.value());
 		}
 
 		// Try to set model type
-		static_cast<TypeManager*>(glb->types)->update(*funcData);
+		types->update(*funcData);
+		types->addDependencies(funcData->getFuncProto());
 		
 		return funcData;
 	}
@@ -87,10 +146,17 @@ namespace yagi
 		auto yagiScope = static_cast<YagiScope*>(glb->symboltab->getGlobalScope());
 		auto proxy = yagiScope->getProxy();
 		auto archi = static_cast<YagiArchitecture*>(glb);
+
+		// other spaces (stack, registers...) are not backed by symbols
+		if (addr.getSpace() == glb->getDefaultCodeSpace())
+		{
+			_AddDependency(archi, addr.getOffset());
+		}
 		
 		auto result = proxy->findContainer(addr, size, usepoint);
 		if (result != nullptr)
 		{
+			static_cast<TypeManager*>(glb->types)->addDependencies(result->getSymbol()->getType());
 			return result;
 		}
 
@@ -110,15 +176,15 @@ namespace yagi
 			switch (data.value()->getType())
 			{
 			case SymbolInfo::Type::Function:
-				archi->getLogger().info("Found function symbol ", name);
+				YAGI_DEBUG(archi->getLogger(), "Found function symbol ", name);
 				symbol = proxy->addFunction(addr, name);
 				break;
 			case SymbolInfo::Type::Import:
-				archi->getLogger().info("Found import symbol ", name);
+				YAGI_DEBUG(archi->getLogger(), "Found import symbol ", name);
 				symbol = proxy->addExternalRef(addr, addr, name);
 				break;
 			case SymbolInfo::Type::Label:
-				archi->getLogger().info("Found label symbol ", name);
+				YAGI_DEBUG(archi->getLogger(), "Found label symbol ", name);
 				symbol = proxy->addCodeLabel(addr, name);
 				break;
 			case SymbolInfo::Type::Other:
@@ -126,12 +192,12 @@ namespace yagi
 				auto type = archi->getTypeInfoFactory().build(addr.getOffset());
 				if (type.has_value())
 				{
-					archi->getLogger().info("Found type", type.value()->getName(),  std::string("for"), name);
+					YAGI_DEBUG(archi->getLogger(), "Found type", type.value()->getName(),  "for", name);
 					symbol = proxy->addSymbol(name, static_cast<TypeManager*>(glb->types)->findByTypeInfo(*(type.value())));
 				}
 				else 
 				{
-					archi->getLogger().info("Unknown type for ", name);
+					YAGI_DEBUG(archi->getLogger(), "Unknown type for ", name);
 					symbol = proxy->addSymbol(name, static_cast<TypeManager*>(glb->types)->getBase(size, TYPE_UNKNOWN));
 				}
 				break;
@@ -142,11 +208,11 @@ namespace yagi
 
 			if (data.value()->isReadOnly())
 			{
-				archi->getLogger().info("Apply readonly type for ", name);
+				YAGI_DEBUG(archi->getLogger(), "Apply readonly type for ", name);
 				proxy->setAttribute(symbol, Varnode::readonly);
 			}
 
-			archi->getLogger().info("Found symbol ", name, std::string(" at "), to_hex(addr.getOffset()));
+			YAGI_DEBUG(archi->getLogger(), "Found symbol ", name, " at ", to_hex(addr.getOffset()));
 			return proxy->addMapPoint(symbol, addr, usepoint);
 		}
 
@@ -165,6 +231,7 @@ namespace yagi
 		auto yagiScope = static_cast<YagiScope*>(glb->symboltab->getGlobalScope());
 		auto proxy = yagiScope->getProxy();
 		auto archi = static_cast<YagiArchitecture*>(glb);
+		_AddDependency(archi, addr.getOffset());
 
 		auto result = proxy->findExternalRef(addr);
 		if (result != nullptr)
@@ -178,7 +245,7 @@ namespace yagi
 			return nullptr;
 		}
 
-		archi->getLogger().info("Find external ref ", data.value()->getName());
+		YAGI_DEBUG(archi->getLogger(), "Find external ref ", data.value()->getName());
 		return proxy->addExternalRef(addr, addr, data.value()->getName());
 	}
 
@@ -188,6 +255,7 @@ namespace yagi
 		auto yagiScope = static_cast<YagiScope*>(glb->symboltab->getGlobalScope());
 		auto proxy = yagiScope->getProxy();
 		auto archi = static_cast<YagiArchitecture*>(glb);
+		_AddDependency(archi, addr.getOffset());
 
 		auto result = proxy->findCodeLabel(addr);
 		if (result != nullptr)
@@ -216,6 +284,7 @@ namespace yagi
 		auto yagiScope = static_cast<YagiScope*>(glb->symboltab->getGlobalScope());
 		auto proxy = yagiScope->getProxy();
 		auto archi = static_cast<YagiArchitecture*>(glb);
+		_AddDependency(archi, sym->getRefAddr().getOffset());
 
 		auto data = static_cast<YagiArchitecture*>(glb)->getSymbolDatabase().find(sym->getRefAddr().getOffset());
 		if (data.has_value())
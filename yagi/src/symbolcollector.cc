@@ -0,0 +1,144 @@
+#include "symbolcollector.hh"
+#include "symbolinfo.hh"
+
+#include <libdecomp.hh>
+
+namespace yagi 
+{
+	/**********************************************************************/
+	std::map<std::string, MemoryLocation> SymbolCollector::collect(const Funcdata& data)
+	{
+		std::map<std::string, MemoryLocation> symbols;
+		findVarSymbols(data, symbols);
+		findFunctionSymbols(data, symbols);
+		findConstantSymbols(data, symbols);
+		return symbols;
+	}
+
+	/**********************************************************************/
+	void SymbolCollector::findVarSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols)
+	{
+		auto iter = data.beginDef();
+		while (iter != data.endDef())
+		{
+			auto varnode = *iter;
+			try
+			{
+				if (
+					varnode->getHigh() != nullptr &&
+					varnode->getHigh()->getSymbol() != nullptr &&
+					varnode->getHigh()->getNameRepresentative() != nullptr 
+					)
+				{
+					auto high = varnode->getHigh();
+					auto nameRepr = high->getNameRepresentative();
+					auto sym = high->getSymbol();
+
+					if (nameRepr->getDef() != nullptr)
+					{
+						auto def = nameRepr->getDef();
+						MemoryLocation loc(
+							nameRepr->getAddr().getSpace()->getName(),
+							nameRepr->getAddr().getOffset(),
+							nameRepr->getAddr().getAddrSize()
+						);
+						loc.pc.push_back(def->getAddr().getOffset());
+						symbols.emplace(sym->getName(),
+							loc
+						);
+					}
+					else {
+						MemoryLocation loc(
+							nameRepr->getAddr().getSpace()->getName(),
+							nameRepr->getAddr().getOffset(),
+							nameRepr->getAddr().getAddrSize()
+						);
+
+						// no name representative, so const (merge multiple variable)
+						auto itOp = data.beginOp(data.getAddress());
+						while (itOp != data.endOp(data.getAddress() + data.getSize()))
+						{
+							auto op = itOp->second;
+							for (auto i = 0; i < op->numInput(); i++)
+							{
+								auto tmpVn = op->getIn(i);
+								if (varnode->getAddr() == tmpVn->getAddr())
+								{
+									loc.pc.push_back(op->getAddr().getOffset());
+								}
+							}
+							++itOp;
+						}
+						symbols.emplace(sym->getName(),
+							loc
+						);
+					}
+				}
+			}
+			catch (LowlevelError&) {}
+			iter++;
+		}
+	}
+
+	/**********************************************************************/
+	void SymbolCollector::findFunctionSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols)
+	{
+		// first we add the local function symbol
+		symbols.emplace(data.getName(),
+			MemoryLocation(
+				"ram",
+				data.getAddress().getOffset(),
+				data.getAddress().getSpace()->getAddrSize()
+			)
+		);
+
+		for (auto i = 0; i < data.numCalls(); i++)
+		{
+			auto call = data.getCallSpecs(i);
+			if(call->getEntryAddress().getSpace() == nullptr)
+			{
+				continue;
+			}
+
+			auto name = call->getName();
+
+			if (name.substr(0, SymbolInfo::IMPORT_PREFIX.length()) == SymbolInfo::IMPORT_PREFIX)
+			{
+				name = name.substr(SymbolInfo::IMPORT_PREFIX.length(), name.length() - SymbolInfo::IMPORT_PREFIX.length());
+			}
+
+			symbols.emplace(name,
+				MemoryLocation(
+					"ram", 
+					call->getEntryAddress().getOffset(), 
+					call->getEntryAddress().getSpace()->getAddrSize()
+				)
+			);
+		}
+	}
+
+	/**********************************************************************/
+	void SymbolCollector::findConstantSymbols(const Funcdata& data, std::map<std::string, MemoryLocation>& symbols)
+	{
+		auto iter = data.beginOp(data.getAddress());
+		while (iter != data.endOp(data.getAddress() + data.getSize()))
+		{
+			auto op = iter->second;
+			for (auto i = 0; i < op->numInput(); i++)
+			{
+				auto varnode = op->getIn(i);
+				if (varnode->isConstant())
+				{
+					MemoryLocation loc(
+						varnode->getAddr().getSpace()->getName(),
+						varnode->getAddr().getOffset(),
+						varnode->getAddr().getSpace()->getAddrSize()
+					);
+					loc.pc.push_back(op->getAddr().getOffset());
+					
+				}
+			}
+			iter++;
+		}
+	}
+} // end of namespace yagi
@@ -0,0 +1,984 @@
+#include "trace.hh"
+#include "exception.hh"
+#include <libdecomp.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#define TRACE_LOADER	"trace"
+
+namespace yagi
+{
+	/**********************************************************************/
+	/*!
+	 * \brief	Append a fixed size value to a trace section
+	 */
+	template<typename T>
+	static void _Write(std::vector<uint8_t>& output, T value)
+	{
+		auto position = output.size();
+		output.resize(position + sizeof(T));
+		std::memcpy(output.data() + position, &value, sizeof(T));
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Append a string as a 32 bits length followed by bytes
+	 */
+	static void _WriteString(std::vector<uint8_t>& output, const std::string& value)
+	{
+		_Write<uint32_t>(output, static_cast<uint32_t>(value.size()));
+		output.insert(output.end(), value.begin(), value.end());
+	}
+
+	/**********************************************************************/
+	static void _WriteSymbol(std::vector<uint8_t>& output, const TraceSymbol& symbol)
+	{
+		_Write<uint64_t>(output, symbol.ea);
+		_WriteString(output, symbol.name);
+		_Write<uint8_t>(output, symbol.functionSize.has_value());
+		_Write<uint64_t>(output, symbol.functionSize.value_or(0));
+		_Write<uint8_t>(output, symbol.isFunction);
+		_Write<uint8_t>(output, symbol.isLabel);
+		_Write<uint8_t>(output, symbol.isImport);
+		_Write<uint8_t>(output, symbol.isReadOnly);
+	}
+
+	/*!
+	 * \brief	Position in a trace section being parsed
+	 */
+	struct _Cursor
+	{
+		const uint8_t* data;
+		size_t size;
+		size_t position;
+		const std::string& path;
+	};
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Read a fixed size value from a trace section
+	 * \raise	InvalidTrace	if the section is too short
+	 */
+	template<typename T>
+	static T _Read(_Cursor& cursor)
+	{
+		if (cursor.size - cursor.position < sizeof(T))
+		{
+			throw InvalidTrace(cursor.path, "truncated trace");
+		}
+		T value;
+		std::memcpy(&value, cursor.data + cursor.position, sizeof(T));
+		cursor.position += sizeof(T);
+		return value;
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Check that a count of records can be read
+	 *			use before reserving memory from an untrusted count
+	 */
+	static uint32_t _ReadCount(_Cursor& cursor, size_t minRecordSize)
+	{
+		auto count = _Read<uint32_t>(cursor);
+		if (count > (cursor.size - cursor.position) / minRecordSize)
+		{
+			throw InvalidTrace(cursor.path, "truncated trace");
+		}
+		return count;
+	}
+
+	/**********************************************************************/
+	static std::string _ReadString(_Cursor& cursor)
+	{
+		auto size = _Read<uint32_t>(cursor);
+		if (cursor.size - cursor.position < size)
+		{
+			throw InvalidTrace(cursor.path, "truncated trace");
+		}
+		std::string result(reinterpret_cast<const char*>(cursor.data + cursor.position), size);
+		cursor.position += size;
+		return result;
+	}
+
+	/**********************************************************************/
+	static TraceSymbol _ReadSymbol(_Cursor& cursor)
+	{
+		TraceSymbol symbol;
+		symbol.ea = _Read<uint64_t>(cursor);
+		symbol.name = _ReadString(cursor);
+		auto hasSize = _Read<uint8_t>(cursor);
+		auto size = _Read<uint64_t>(cursor);
+		if (hasSize)
+		{
+			symbol.functionSize = size;
+		}
+		symbol.isFunction = _Read<uint8_t>(cursor) != 0;
+		symbol.isLabel = _Read<uint8_t>(cursor) != 0;
+		symbol.isImport = _Read<uint8_t>(cursor) != 0;
+		symbol.isReadOnly = _Read<uint8_t>(cursor) != 0;
+		return symbol;
+	}
+
+	/**********************************************************************/
+	TraceSymbol TraceSymbol::capture(const SymbolInfo& symbol)
+	{
+		std::optional<uint64_t> functionSize;
+		try
+		{
+			functionSize = symbol.getFunctionSize();
+		}
+		catch (const Error&)
+		{
+			// replay will raise the same error
+		}
+
+		return TraceSymbol{
+			symbol.getAddress(), symbol.getName(), functionSize,
+			symbol.isFunction(), symbol.isLabel(), symbol.isImport(), symbol.isReadOnly()
+		};
+	}
+
+	/**********************************************************************/
+	void TraceContent::addMemory(const std::string& space, uint64_t offset, const uint8_t* bytes, size_t size)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		auto& chunks = memory[space];
+		auto start = offset;
+		auto end = offset + size;
+
+		// first chunk that overlaps or touches the new bytes
+		auto first = chunks.upper_bound(start);
+		if (first != chunks.begin() && std::prev(first)->first + std::prev(first)->second.size() >= start)
+		{
+			--first;
+		}
+
+		auto last = first;
+		while (last != chunks.end() && last->first <= end)
+		{
+			++last;
+		}
+
+		if (first != last)
+		{
+			start = std::min(start, first->first);
+			auto back = std::prev(last);
+			end = std::max(end, back->first + back->second.size());
+		}
+
+		std::vector<uint8_t> merged(end - start, 0);
+		for (auto iter = first; iter != last; ++iter)
+		{
+			std::copy(iter->second.begin(), iter->second.end(), merged.begin() + (iter->first - start));
+		}
+		std::copy_n(bytes, size, merged.begin() + (offset - start));
+
+		chunks.erase(first, last);
+		chunks.emplace(start, std::move(merged));
+	}
+
+	/**********************************************************************/
+	bool TraceContent::readMemory(const std::string& space, uint64_t offset, uint8_t* bytes, size_t size) const
+	{
+		auto chunks = memory.find(space);
+		if (chunks == memory.end())
+		{
+			return false;
+		}
+
+		// chunks are merged, so all bytes are in the same one
+		auto chunk = chunks->second.upper_bound(offset);
+		if (chunk == chunks->second.begin())
+		{
+			return false;
+		}
+		--chunk;
+
+		auto chunkOffset = offset - chunk->first;
+		if (chunkOffset > chunk->second.size() || size > chunk->second.size() - chunkOffset)
+		{
+			return false;
+		}
+
+		std::copy_n(chunk->second.begin() + chunkOffset, size, bytes);
+		return true;
+	}
+
+	/**********************************************************************/
+	std::vector<uint8_t> TraceContent::serialize() const
+	{
+		std::vector<uint8_t> output;
+		_Write<uint32_t>(output, trace::VERSION);
+		_WriteString(output, sleighId);
+		_WriteString(output, defaultCC);
+
+		_Write<uint32_t>(output, static_cast<uint32_t>(memory.size()));
+		for (auto& [space, chunks] : memory)
+		{
+			_WriteString(output, space);
+			_Write<uint32_t>(output, static_cast<uint32_t>(chunks.size()));
+			for (auto& [offset, bytes] : chunks)
+			{
+				_Write<uint64_t>(output, offset);
+				_Write<uint64_t>(output, bytes.size());
+				output.insert(output.end(), bytes.begin(), bytes.end());
+			}
+		}
+
+		_Write<uint32_t>(output, static_cast<uint32_t>(symbols.size()));
+		for (auto& [ea, symbol] : symbols)
+		{
+			_Write<uint64_t>(output, ea);
+			_Write<uint8_t>(output, symbol.has_value());
+			if (symbol.has_value())
+			{
+				_WriteSymbol(output, symbol.value());
+			}
+		}
+
+		_Write<uint32_t>(output, static_cast<uint32_t>(functionLookups.size()));
+		for (auto& [ea, function] : functionLookups)
+		{
+			_Write<uint64_t>(output, ea);
+			_Write<uint8_t>(output, function.has_value());
+			_Write<uint64_t>(output, function.value_or(0));
+		}
+
+		_Write<uint32_t>(output, static_cast<uint32_t>(functions.size()));
+		for (auto& [ea, function] : functions)
+		{
+			_WriteSymbol(output, function.symbol);
+
+			_Write<uint32_t>(output, static_cast<uint32_t>(function.stackVars.size()));
+			for (auto& [key, name] : function.stackVars)
+			{
+				_Write<uint64_t>(output, std::get<0>(key));
+				_Write<uint32_t>(output, std::get<1>(key));
+				_Write<uint8_t>(output, name.has_value());
+				_WriteString(output, name.value_or(""));
+			}
+
+			_Write<uint32_t>(output, static_cast<uint32_t>(function.names.size()));
+			for (auto& [key, name] : function.names)
+			{
+				_Write<uint64_t>(output, std::get<0>(key));
+				_WriteString(output, std::get<1>(key));
+				_Write<uint8_t>(output, name.has_value());
+				_WriteString(output, name.has_value() ? std::get<0>(name.value()) : "");
+				_Write<uint64_t>(output, name.has_value() ? std::get<1>(name.value()) : 0);
+			}
+
+			_Write<uint32_t>(output, static_cast<uint32_t>(function.types.size()));
+			for (auto& [key, type] : function.types)
+			{
+				_Write<uint64_t>(output, std::get<0>(key));
+				_WriteString(output, std::get<1>(key));
+				_Write<uint8_t>(output, type.has_value());
+				_Write<uint32_t>(output, type.has_value() ? std::get<0>(type.value()) : typedb::NONE);
+				_Write<uint64_t>(output, type.has_value() ? std::get<1>(type.value()) : 0);
+			}
+
+			_Write<uint8_t>(output, function.localNames.has_value());
+			if (function.localNames.has_value())
+			{
+				_Write<uint32_t>(output, static_cast<uint32_t>(function.localNames->size()));
+				for (auto& local : function.localNames.value())
+				{
+					_WriteString(output, local.space);
+					_Write<uint64_t>(output, local.pc);
+					_Write<uint64_t>(output, local.offset);
+					_WriteString(output, local.name);
+				}
+			}
+
+			_Write<uint8_t>(output, function.localTypes.has_value());
+			if (function.localTypes.has_value())
+			{
+				_Write<uint32_t>(output, static_cast<uint32_t>(function.localTypes->size()));
+				for (auto& local : function.localTypes.value())
+				{
+					_WriteString(output, local.space);
+					_Write<uint64_t>(output, local.pc);
+					_Write<uint64_t>(output, local.offset);
+					_Write<uint32_t>(output, local.type);
+				}
+			}
+		}
+
+		_Write<uint8_t>(output, typeNames.has_value());
+		if (typeNames.has_value())
+		{
+			_Write<uint32_t>(output, static_cast<uint32_t>(typeNames->size()));
+			for (auto& name : typeNames.value())
+			{
+				_WriteString(output, name);
+			}
+		}
+
+		return output;
+	}
+
+	/**********************************************************************/
+	TraceContent TraceContent::deserialize(const uint8_t* data, size_t size, const std::string& path)
+	{
+		_Cursor cursor{ data, size, 0, path };
+		auto version = _Read<uint32_t>(cursor);
+		if (version != trace::VERSION)
+		{
+			throw InvalidTrace(path, "unsupported version " + std::to_string(version));
+		}
+
+		TraceContent content;
+		content.sleighId = _ReadString(cursor);
+		content.defaultCC = _ReadString(cursor);
+
+		auto spaceCount = _ReadCount(cursor, sizeof(uint32_t) * 2);
+		for (uint32_t i = 0; i < spaceCount; i++)
+		{
+			auto& chunks = content.memory[_ReadString(cursor)];
+			auto chunkCount = _ReadCount(cursor, sizeof(uint64_t) * 2);
+			for (uint32_t j = 0; j < chunkCount; j++)
+			{
+				auto offset = _Read<uint64_t>(cursor);
+				auto length = _Read<uint64_t>(cursor);
+				if (cursor.size - cursor.position < length)
+				{
+					throw InvalidTrace(path, "truncated trace");
+				}
+				chunks.emplace(offset, std::vector<uint8_t>(cursor.data + cursor.position, cursor.data + cursor.position + length));
+				cursor.position += length;
+			}
+		}
+
+		auto symbolCount = _ReadCount(cursor, sizeof(uint64_t) + sizeof(uint8_t));
+		for (uint32_t i = 0; i < symbolCount; i++)
+		{
+			auto ea = _Read<uint64_t>(cursor);
+			std::optional<TraceSymbol> symbol;
+			if (_Read<uint8_t>(cursor))
+			{
+				symbol = _ReadSymbol(cursor);
+			}
+			content.symbols.emplace(ea, std::move(symbol));
+		}
+
+		auto lookupCount = _ReadCount(cursor, sizeof(uint64_t) * 2 + sizeof(uint8_t));
+		for (uint32_t i = 0; i < lookupCount; i++)
+		{
+			auto ea = _Read<uint64_t>(cursor);
+			auto found = _Read<uint8_t>(cursor);
+			auto function = _Read<uint64_t>(cursor);
+			content.functionLookups.emplace(ea, found ? std::optional<uint64_t>(function) : std::nullopt);
+		}
+
+		auto functionCount = _ReadCount(cursor, sizeof(uint64_t));
+		for (uint32_t i = 0; i < functionCount; i++)
+		{
+			TraceFunction function;
+			function.symbol = _ReadSymbol(cursor);
+
+			auto stackVarCount = _ReadCount(cursor, sizeof(uint64_t));
+			for (uint32_t j = 0; j < stackVarCount; j++)
+			{
+				auto offset = _Read<uint64_t>(cursor);
+				auto addrSize = _Read<uint32_t>(cursor);
+				auto found = _Read<uint8_t>(cursor);
+				auto name = _ReadString(cursor);
+				function.stackVars.emplace(std::make_tuple(offset, addrSize), found ? std::optional<std::string>(name) : std::nullopt);
+			}
+
+			auto nameCount = _ReadCount(cursor, sizeof(uint64_t));
+			for (uint32_t j = 0; j < nameCount; j++)
+			{
+				auto pc = _Read<uint64_t>(cursor);
+				auto space = _ReadString(cursor);
+				auto found = _Read<uint8_t>(cursor);
+				auto name = _ReadString(cursor);
+				auto offset = _Read<uint64_t>(cursor);
+				function.names.emplace(std::make_tuple(pc, space), found ? std::make_optional(std::make_tuple(name, offset)) : std::nullopt);
+			}
+
+			auto typeCount = _ReadCount(cursor, sizeof(uint64_t));
+			for (uint32_t j = 0; j < typeCount; j++)
+			{
+				auto pc = _Read<uint64_t>(cursor);
+				auto space = _ReadString(cursor);
+				auto found = _Read<uint8_t>(cursor);
+				auto type = _Read<uint32_t>(cursor);
+				auto offset = _Read<uint64_t>(cursor);
+				function.types.emplace(std::make_tuple(pc, space), found ? std::make_optional(std::make_tuple(type, offset)) : std::nullopt);
+			}
+
+			if (_Read<uint8_t>(cursor))
+			{
+				auto localCount = _ReadCount(cursor, sizeof(uint64_t));
+				function.localNames.emplace();
+				for (uint32_t j = 0; j < localCount; j++)
+				{
+					LocalName local;
+					local.space = _ReadString(cursor);
+					local.pc = _Read<uint64_t>(cursor);
+					local.offset = _Read<uint64_t>(cursor);
+					local.name = _ReadString(cursor);
+					function.localNames->push_back(std::move(local));
+				}
+			}
+
+			if (_Read<uint8_t>(cursor))
+			{
+				auto localCount = _ReadCount(cursor, sizeof(uint64_t));
+				function.localTypes.emplace();
+				for (uint32_t j = 0; j < localCount; j++)
+				{
+					TraceLocalType local;
+					local.space = _ReadString(cursor);
+					local.pc = _Read<uint64_t>(cursor);
+					local.offset = _Read<uint64_t>(cursor);
+					local.type = _Read<uint32_t>(cursor);
+					function.localTypes->push_back(std::move(local));
+				}
+			}
+
+			auto ea = function.symbol.ea;
+			content.functions.emplace(ea, std::move(function));
+		}
+
+		if (_Read<uint8_t>(cursor))
+		{
+			auto typeNameCount = _ReadCount(cursor, sizeof(uint32_t));
+			content.typeNames.emplace();
+			for (uint32_t i = 0; i < typeNameCount; i++)
+			{
+				content.typeNames->push_back(_ReadString(cursor));
+			}
+		}
+
+		if (cursor.position != cursor.size)
+		{
+			throw InvalidTrace(path, "unexpected data after trace");
+		}
+
+		return content;
+	}
+
+	/**********************************************************************/
+	void TraceRecorder::setArchitecture(const std::string& sleighId, const std::string& defaultCC)
+	{
+		m_content.sleighId = sleighId;
+		m_content.defaultCC = defaultCC;
+	}
+
+	/**********************************************************************/
+	TraceContent& TraceRecorder::getContent()
+	{
+		return m_content;
+	}
+
+	/**********************************************************************/
+	uint32_t TraceRecorder::addType(const TypeInfo& type)
+	{
+		return m_types.add(type);
+	}
+
+	/**********************************************************************/
+	void TraceRecorder::addNamedType(const std::string& name, const TypeInfo& type)
+	{
+		m_types.addName(name, type);
+	}
+
+	/**********************************************************************/
+	void TraceRecorder::addAddressType(uint64_t ea, const TypeInfo& type)
+	{
+		m_types.addAddress(ea, type);
+	}
+
+	/**********************************************************************/
+	void TraceRecorder::save(const std::string& path) const
+	{
+		auto content = m_types.serialize();
+		uint64_t traceOffset = content.size();
+
+		auto section = m_content.serialize();
+		content.insert(content.end(), section.begin(), section.end());
+		_Write<uint64_t>(content, traceOffset);
+		content.insert(content.end(), std::begin(trace::MAGIC), std::end(trace::MAGIC));
+
+		std::ofstream output(path, std::ios::binary | std::ios::trunc);
+		output.write(reinterpret_cast<const char*>(content.data()), content.size());
+		if (!output)
+		{
+			throw InvalidTrace(path, "unable to write file");
+		}
+	}
+
+	/**********************************************************************/
+	TraceReplay::TraceReplay(TraceContent content, std::unique_ptr<TypeDatabase> types)
+		: m_content{ std::move(content) }, m_types{ std::move(types) }
+	{}
+
+	/**********************************************************************/
+	std::shared_ptr<const TraceReplay> TraceReplay::load(const std::string& path)
+	{
+		std::ifstream input(path, std::ios::binary);
+		if (!input)
+		{
+			throw InvalidTrace(path, "unable to open file");
+		}
+		std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+		const size_t footerSize = sizeof(uint64_t) + sizeof(trace::MAGIC);
+		if (data.size() < footerSize)
+		{
+			throw InvalidTrace(path, "file too small");
+		}
+
+		auto footer = data.data() + data.size() - footerSize;
+		if (std::memcmp(footer + sizeof(uint64_t), trace::MAGIC, sizeof(trace::MAGIC)) != 0)
+		{
+			throw InvalidTrace(path, "bad magic");
+		}
+
+		uint64_t traceOffset;
+		std::memcpy(&traceOffset, footer, sizeof(traceOffset));
+		if (traceOffset > data.size() - footerSize)
+		{
+			throw InvalidTrace(path, "truncated file");
+		}
+
+		auto content = TraceContent::deserialize(data.data() + traceOffset, data.size() - footerSize - traceOffset, path);
+		return std::shared_ptr<const TraceReplay>(new TraceReplay(std::move(content), TypeDatabase::load(path)));
+	}
+
+	/**********************************************************************/
+	const TraceContent& TraceReplay::getContent() const
+	{
+		return m_content;
+	}
+
+	/**********************************************************************/
+	const std::shared_ptr<const TypeDatabase>& TraceReplay::getTypes() const
+	{
+		return m_types;
+	}
+
+	/*!
+	 * \brief	Forward loads to another loader and record loaded bytes
+	 */
+	class RecordingLoader : public LoadImage
+	{
+	protected:
+		std::unique_ptr<LoadImage> m_inner;
+		std::shared_ptr<TraceRecorder> m_recorder;
+
+	public:
+		explicit RecordingLoader(std::unique_ptr<LoadImage> inner, std::shared_ptr<TraceRecorder> recorder)
+			: LoadImage(inner->getFileName()), m_inner{ std::move(inner) }, m_recorder{ recorder }
+		{}
+
+		std::string getArchType(void) const override
+		{
+			return m_inner->getArchType();
+		}
+
+		void loadFill(uint1* ptr, int4 size, const Address& addr) override
+		{
+			m_inner->loadFill(ptr, size, addr);
+			m_recorder->getContent().addMemory(addr.getSpace()->getName(), addr.getOffset(), ptr, size);
+		}
+
+		void adjustVma(long adjust) override
+		{
+			m_inner->adjustVma(adjust);
+		}
+	};
+
+	/*!
+	 * \brief	Serve loads from a trace
+	 */
+	class ReplayLoader : public LoadImage
+	{
+	protected:
+		std::shared_ptr<const TraceReplay> m_replay;
+
+	public:
+		explicit ReplayLoader(std::shared_ptr<const TraceReplay> replay)
+			: LoadImage(TRACE_LOADER), m_replay{ replay }
+		{}
+
+		std::string getArchType(void) const override
+		{
+			return TRACE_LOADER;
+		}
+
+		void loadFill(uint1* ptr, int4 size, const Address& addr) override
+		{
+			if (!m_replay->getContent().readMemory(addr.getSpace()->getName(), addr.getOffset(), ptr, size))
+			{
+				std::ostringstream ss;
+				ss << "Bytes at ";
+				addr.printRaw(ss);
+				ss << " were not loaded when the trace was recorded";
+				throw DataUnavailError(ss.str());
+			}
+		}
+
+		void adjustVma(long adjust) override
+		{
+		}
+	};
+
+	/**********************************************************************/
+	RecordingLoaderFactory::RecordingLoaderFactory(std::unique_ptr<LoaderFactory> inner, std::shared_ptr<TraceRecorder> recorder)
+		: m_inner{ std::move(inner) }, m_recorder{ recorder }
+	{}
+
+	/**********************************************************************/
+	LoadImage* RecordingLoaderFactory::build()
+	{
+		return new RecordingLoader(std::unique_ptr<LoadImage>(m_inner->build()), m_recorder);
+	}
+
+	/**********************************************************************/
+	RecordingSymbolInfoFactory::RecordingSymbolInfoFactory(std::unique_ptr<SymbolInfoFactory> inner, std::shared_ptr<TraceRecorder> recorder)
+		: m_inner{ std::move(inner) }, m_recorder{ recorder }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<SymbolInfo>> RecordingSymbolInfoFactory::find(uint64_t ea)
+	{
+		auto symbol = m_inner->find(ea);
+		m_recorder->getContent().symbols.insert_or_assign(
+			ea, symbol.has_value() ? std::make_optional(TraceSymbol::capture(*symbol.value())) : std::nullopt
+		);
+		return symbol;
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<FunctionSymbolInfo>> RecordingSymbolInfoFactory::find_function(uint64_t ea)
+	{
+		auto& content = m_recorder->getContent();
+		auto function = m_inner->find_function(ea);
+		if (!function.has_value())
+		{
+			content.functionLookups.insert_or_assign(ea, std::nullopt);
+			return std::nullopt;
+		}
+
+		auto symbol = TraceSymbol::capture(function.value()->getSymbol());
+		content.functionLookups.insert_or_assign(ea, symbol.ea);
+
+		// a function found again keeps its answers, new ones overwrite old ones
+		auto& record = content.functions[symbol.ea];
+		record.symbol = symbol;
+		return std::make_unique<RecordingFunctionSymbolInfo>(std::move(function.value()), m_recorder, &record);
+	}
+
+	/**********************************************************************/
+	RecordingFunctionSymbolInfo::RecordingFunctionSymbolInfo(std::unique_ptr<FunctionSymbolInfo> inner, std::shared_ptr<TraceRecorder> recorder, TraceFunction* function)
+		: FunctionSymbolInfo(std::make_unique<ReplaySymbolInfo>(function->symbol)), m_inner{ std::move(inner) }, m_recorder{ recorder }, m_function{ function }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::string> RecordingFunctionSymbolInfo::findStackVar(uint64_t offset, uint32_t addrSize)
+	{
+		auto name = m_inner->findStackVar(offset, addrSize);
+		m_function->stackVars.insert_or_assign(std::make_tuple(offset, addrSize), name);
+		return name;
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> RecordingFunctionSymbolInfo::findName(uint64_t pc, const std::string& space, uint64_t& offset)
+	{
+		auto name = m_inner->findName(pc, space, offset);
+		m_function->names.insert_or_assign(
+			std::make_tuple(pc, space), name.has_value() ? std::make_optional(std::make_tuple(name.value(), offset)) : std::nullopt
+		);
+		return name;
+	}
+
+	/**********************************************************************/
+	void RecordingFunctionSymbolInfo::saveName(const MemoryLocation& loc, const std::string& space)
+	{
+		m_inner->saveName(loc, space);
+	}
+
+	/**********************************************************************/
+	void RecordingFunctionSymbolInfo::saveType(const MemoryLocation& loc, const TypeInfo& newType)
+	{
+		m_inner->saveType(loc, newType);
+	}
+
+	/**********************************************************************/
+	bool RecordingFunctionSymbolInfo::clearType(const MemoryLocation& loc)
+	{
+		return m_inner->clearType(loc);
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> RecordingFunctionSymbolInfo::findType(uint64_t pc, const std::string& from, uint64_t& offset)
+	{
+		auto type = m_inner->findType(pc, from, offset);
+		m_function->types.insert_or_assign(
+			std::make_tuple(pc, from), type.has_value() ? std::make_optional(std::make_tuple(m_recorder->addType(*type.value()), offset)) : std::nullopt
+		);
+		return type;
+	}
+
+	/**********************************************************************/
+	std::vector<LocalName> RecordingFunctionSymbolInfo::getLocalNames()
+	{
+		auto names = m_inner->getLocalNames();
+		m_function->localNames = names;
+		return names;
+	}
+
+	/**********************************************************************/
+	std::vector<LocalType> RecordingFunctionSymbolInfo::getLocalTypes()
+	{
+		auto types = m_inner->getLocalTypes();
+		std::vector<TraceLocalType> records;
+		for (auto& local : types)
+		{
+			records.push_back(TraceLocalType{ local.space, local.pc, local.offset, m_recorder->addType(*local.type) });
+		}
+		m_function->localTypes = std::move(records);
+		return types;
+	}
+
+	/**********************************************************************/
+	RecordingTypeInfoFactory::RecordingTypeInfoFactory(std::unique_ptr<TypeInfoFactory> inner, std::shared_ptr<TraceRecorder> recorder)
+		: m_inner{ std::move(inner) }, m_recorder{ recorder }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> RecordingTypeInfoFactory::build(const std::string& name)
+	{
+		auto type = m_inner->build(name);
+		if (type.has_value())
+		{
+			m_recorder->addNamedType(name, *type.value());
+		}
+		return type;
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> RecordingTypeInfoFactory::build(uint64_t ea)
+	{
+		auto type = m_inner->build(ea);
+		if (type.has_value())
+		{
+			m_recorder->addAddressType(ea, *type.value());
+		}
+		return type;
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> RecordingTypeInfoFactory::getTypeNames()
+	{
+		auto names = m_inner->getTypeNames();
+		m_recorder->getContent().typeNames = names;
+		return names;
+	}
+
+	/**********************************************************************/
+	ReplayLoaderFactory::ReplayLoaderFactory(std::shared_ptr<const TraceReplay> replay)
+		: m_replay{ replay }
+	{}
+
+	/**********************************************************************/
+	LoadImage* ReplayLoaderFactory::build()
+	{
+		return new ReplayLoader(m_replay);
+	}
+
+	/**********************************************************************/
+	ReplaySymbolInfo::ReplaySymbolInfo(TraceSymbol symbol)
+		: SymbolInfo(symbol.ea, symbol.name), m_symbol{ std::move(symbol) }
+	{}
+
+	/**********************************************************************/
+	uint64_t ReplaySymbolInfo::getFunctionSize() const
+	{
+		if (!m_symbol.functionSize.has_value())
+		{
+			throw SymbolIsNotAFunction(m_symbol.name);
+		}
+		return m_symbol.functionSize.value();
+	}
+
+	/**********************************************************************/
+	bool ReplaySymbolInfo::isFunction() const noexcept
+	{
+		return m_symbol.isFunction;
+	}
+
+	/**********************************************************************/
+	bool ReplaySymbolInfo::isLabel() const noexcept
+	{
+		return m_symbol.isLabel;
+	}
+
+	/**********************************************************************/
+	bool ReplaySymbolInfo::isImport() const noexcept
+	{
+		return m_symbol.isImport;
+	}
+
+	/**********************************************************************/
+	bool ReplaySymbolInfo::isReadOnly() const noexcept
+	{
+		return m_symbol.isReadOnly;
+	}
+
+	/**********************************************************************/
+	ReplayFunctionSymbolInfo::ReplayFunctionSymbolInfo(std::shared_ptr<const TraceReplay> replay, const TraceFunction& function)
+		: FunctionSymbolInfo(std::make_unique<ReplaySymbolInfo>(function.symbol)), m_replay{ replay }, m_function{ function }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::string> ReplayFunctionSymbolInfo::findStackVar(uint64_t offset, uint32_t addrSize)
+	{
+		auto iter = m_function.stackVars.find(std::make_tuple(offset, addrSize));
+		if (iter == m_function.stackVars.end())
+		{
+			return std::nullopt;
+		}
+		return iter->second;
+	}
+
+	/**********************************************************************/
+	std::optional<std::string> ReplayFunctionSymbolInfo::findName(uint64_t pc, const std::string& space, uint64_t& offset)
+	{
+		auto iter = m_function.names.find(std::make_tuple(pc, space));
+		if (iter == m_function.names.end() || !iter->second.has_value())
+		{
+			return std::nullopt;
+		}
+		offset = std::get<1>(iter->second.value());
+		return std::get<0>(iter->second.value());
+	}
+
+	/**********************************************************************/
+	void ReplayFunctionSymbolInfo::saveName(const MemoryLocation& loc, const std::string& space)
+	{
+	}
+
+	/**********************************************************************/
+	void ReplayFunctionSymbolInfo::saveType(const MemoryLocation& loc, const TypeInfo& newType)
+	{
+	}
+
+	/**********************************************************************/
+	bool ReplayFunctionSymbolInfo::clearType(const MemoryLocation& loc)
+	{
+		return false;
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> ReplayFunctionSymbolInfo::findType(uint64_t pc, const std::string& from, uint64_t& offset)
+	{
+		auto iter = m_function.types.find(std::make_tuple(pc, from));
+		if (iter == m_function.types.end() || !iter->second.has_value())
+		{
+			return std::nullopt;
+		}
+		offset = std::get<1>(iter->second.value());
+		return std::make_unique<FileTypeInfo>(m_replay->getTypes(), std::get<0>(iter->second.value()));
+	}
+
+	/**********************************************************************/
+	std::vector<LocalName> ReplayFunctionSymbolInfo::getLocalNames()
+	{
+		return m_function.localNames.value_or(std::vector<LocalName>());
+	}
+
+	/**********************************************************************/
+	std::vector<LocalType> ReplayFunctionSymbolInfo::getLocalTypes()
+	{
+		std::vector<LocalType> result;
+		if (m_function.localTypes.has_value())
+		{
+			for (auto& local : m_function.localTypes.value())
+			{
+				result.push_back(LocalType{ local.space, local.pc, local.offset, std::make_unique<FileTypeInfo>(m_replay->getTypes(), local.type) });
+			}
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	ReplaySymbolInfoFactory::ReplaySymbolInfoFactory(std::shared_ptr<const TraceReplay> replay)
+		: m_replay{ replay }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<SymbolInfo>> ReplaySymbolInfoFactory::find(uint64_t ea)
+	{
+		auto& symbols = m_replay->getContent().symbols;
+		auto iter = symbols.find(ea);
+		if (iter == symbols.end() || !iter->second.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<ReplaySymbolInfo>(iter->second.value());
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<FunctionSymbolInfo>> ReplaySymbolInfoFactory::find_function(uint64_t ea)
+	{
+		auto& content = m_replay->getContent();
+		auto lookup = content.functionLookups.find(ea);
+		if (lookup == content.functionLookups.end() || !lookup->second.has_value())
+		{
+			return std::nullopt;
+		}
+
+		auto function = content.functions.find(lookup->second.value());
+		if (function == content.functions.end())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<ReplayFunctionSymbolInfo>(m_replay, function->second);
+	}
+
+	/**********************************************************************/
+	ReplayTypeInfoFactory::ReplayTypeInfoFactory(std::shared_ptr<const TraceReplay> replay)
+		: m_replay{ replay }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> ReplayTypeInfoFactory::build(const std::string& name)
+	{
+		auto index = m_replay->getTypes()->findName(name);
+		if (!index.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileTypeInfo>(m_replay->getTypes(), index.value());
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> ReplayTypeInfoFactory::build(uint64_t ea)
+	{
+		auto index = m_replay->getTypes()->findAddress(ea);
+		if (!index.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileTypeInfo>(m_replay->getTypes(), index.value());
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> ReplayTypeInfoFactory::getTypeNames()
+	{
+		return m_replay->getContent().typeNames.value_or(std::vector<std::string>());
+	}
+} // end of namespace yagi
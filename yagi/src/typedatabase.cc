@@ -0,0 +1,853 @@
+#include "typedatabase.hh"
+#include "exception.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace yagi
+{
+	/**********************************************************************/
+	/*!
+	 * \brief	Round up an offset to keep tables aligned
+	 */
+	static uint64_t _Align(uint64_t offset)
+	{
+		return (offset + 7) & ~uint64_t(7);
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Copy a table in the file
+	 *			An empty table may have no storage at all
+	 */
+	static void _Copy(uint8_t* dest, const void* src, size_t size)
+	{
+		if (size != 0)
+		{
+			std::memcpy(dest, src, size);
+		}
+	}
+
+	/**********************************************************************/
+	/*!
+	 * \brief	Check that a table is inside the file
+	 */
+	static bool _IsInside(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t size)
+	{
+		return offset <= size && count <= (size - offset) / recordSize;
+	}
+
+	/**********************************************************************/
+	TypeDatabase::TypeDatabase(const uint8_t* data, size_t size, void* mapping)
+		: m_data{ data }, m_size{ size }, m_mapping{ mapping },
+		m_header{ nullptr }, m_types{ nullptr }, m_members{ nullptr }, m_names{ nullptr }, m_addresses{ nullptr }
+	{}
+
+	/**********************************************************************/
+	TypeDatabase::~TypeDatabase()
+	{
+		// a snapshot owns its content, nothing is mapped
+		if (!m_buffer.empty())
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+		munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+	}
+
+	/**********************************************************************/
+	std::unique_ptr<TypeDatabase> TypeDatabase::load(const std::string& path)
+	{
+#ifdef _WIN32
+		auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw InvalidTypeDatabase(path, "unable to open file");
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(typedb::Header))
+		{
+			CloseHandle(file);
+			throw InvalidTypeDatabase(path, "file too small");
+		}
+
+		auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr)
+		{
+			throw InvalidTypeDatabase(path, "unable to map file");
+		}
+
+		auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			throw InvalidTypeDatabase(path, "unable to map file");
+		}
+
+		std::unique_ptr<TypeDatabase> database(new TypeDatabase(static_cast<const uint8_t*>(data), (size_t)size.QuadPart, mapping));
+#else
+		auto fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw InvalidTypeDatabase(path, "unable to open file");
+		}
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(typedb::Header))
+		{
+			close(fd);
+			throw InvalidTypeDatabase(path, "file too small");
+		}
+
+		auto data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (data == MAP_FAILED)
+		{
+			throw InvalidTypeDatabase(path, "unable to map file");
+		}
+
+		std::unique_ptr<TypeDatabase> database(new TypeDatabase(static_cast<const uint8_t*>(data), (size_t)info.st_size, nullptr));
+#endif
+		database->check(path);
+		return database;
+	}
+
+	/**********************************************************************/
+	std::unique_ptr<TypeDatabase> TypeDatabase::snapshot(const TypeDatabaseWriter& writer)
+	{
+		std::unique_ptr<TypeDatabase> database(new TypeDatabase(nullptr, 0, nullptr));
+		database->m_buffer = writer.serialize();
+		database->m_data = database->m_buffer.data();
+		database->m_size = database->m_buffer.size();
+		database->m_keys = writer.getKeys();
+		database->check("snapshot");
+		return database;
+	}
+
+	/**********************************************************************/
+	void TypeDatabase::check(const std::string& path)
+	{
+		m_header = reinterpret_cast<const typedb::Header*>(m_data);
+		if (std::memcmp(m_header->magic, typedb::MAGIC, sizeof(typedb::MAGIC)) != 0)
+		{
+			throw InvalidTypeDatabase(path, "bad magic");
+		}
+
+		if (m_header->version != typedb::VERSION)
+		{
+			throw InvalidTypeDatabase(path, "unsupported version " + std::to_string(m_header->version));
+		}
+
+		if (!_IsInside(m_header->typesOffset, m_header->typeCount, sizeof(typedb::TypeRecord), m_size) ||
+			!_IsInside(m_header->membersOffset, m_header->memberCount, sizeof(typedb::MemberRecord), m_size) ||
+			!_IsInside(m_header->namesOffset, m_header->nameCount, sizeof(typedb::NameRecord), m_size) ||
+			!_IsInside(m_header->addressesOffset, m_header->addressCount, sizeof(typedb::AddressRecord), m_size) ||
+			!_IsInside(m_header->stringsOffset, m_header->stringsSize, 1, m_size))
+		{
+			throw InvalidTypeDatabase(path, "truncated file");
+		}
+
+		m_types = reinterpret_cast<const typedb::TypeRecord*>(m_data + m_header->typesOffset);
+		m_members = reinterpret_cast<const typedb::MemberRecord*>(m_data + m_header->membersOffset);
+		m_names = reinterpret_cast<const typedb::NameRecord*>(m_data + m_header->namesOffset);
+		m_addresses = reinterpret_cast<const typedb::AddressRecord*>(m_data + m_header->addressesOffset);
+
+		// check every reference once, so accessors can trust the file
+		auto isString = [this](uint32_t offset) {
+			uint32_t length;
+			if (offset == typedb::NONE)
+			{
+				return true;
+			}
+			if (uint64_t(offset) + sizeof(length) > m_header->stringsSize)
+			{
+				return false;
+			}
+			std::memcpy(&length, m_data + m_header->stringsOffset + offset, sizeof(length));
+			return uint64_t(offset) + sizeof(length) + length <= m_header->stringsSize;
+		};
+		auto isType = [this](uint32_t index) {
+			return index == typedb::NONE || index < m_header->typeCount;
+		};
+
+		for (uint32_t i = 0; i < m_header->typeCount; i++)
+		{
+			auto& type = m_types[i];
+			if (!isString(type.name) || !isString(type.callingConv) || !isType(type.target) ||
+				uint64_t(type.firstMember) + type.memberCount > m_header->memberCount)
+			{
+				throw InvalidTypeDatabase(path, "corrupted type " + std::to_string(i));
+			}
+		}
+
+		for (uint32_t i = 0; i < m_header->memberCount; i++)
+		{
+			if (!isString(m_members[i].name) || m_members[i].type >= m_header->typeCount)
+			{
+				throw InvalidTypeDatabase(path, "corrupted member " + std::to_string(i));
+			}
+		}
+
+		for (uint32_t i = 0; i < m_header->nameCount; i++)
+		{
+			if (m_names[i].name == typedb::NONE || !isString(m_names[i].name) || m_names[i].type >= m_header->typeCount)
+			{
+				throw InvalidTypeDatabase(path, "corrupted name " + std::to_string(i));
+			}
+		}
+
+		for (uint32_t i = 0; i < m_header->addressCount; i++)
+		{
+			if (m_addresses[i].type >= m_header->typeCount)
+			{
+				throw InvalidTypeDatabase(path, "corrupted address " + std::to_string(i));
+			}
+		}
+	}
+
+	/**********************************************************************/
+	const typedb::TypeRecord& TypeDatabase::getType(uint32_t index) const
+	{
+		return m_types[index];
+	}
+
+	/**********************************************************************/
+	const typedb::MemberRecord& TypeDatabase::getMember(uint32_t index) const
+	{
+		return m_members[index];
+	}
+
+	/**********************************************************************/
+	std::string TypeDatabase::getKey(uint32_t index) const
+	{
+		if (index < m_keys.size())
+		{
+			return m_keys[index];
+		}
+		return "#" + std::to_string(index);
+	}
+
+	/**********************************************************************/
+	std::string_view TypeDatabase::getString(uint32_t offset) const
+	{
+		if (offset == typedb::NONE)
+		{
+			return std::string_view();
+		}
+
+		uint32_t length;
+		auto start = m_data + m_header->stringsOffset + offset;
+		std::memcpy(&length, start, sizeof(length));
+		return std::string_view(reinterpret_cast<const char*>(start + sizeof(length)), length);
+	}
+
+	/**********************************************************************/
+	uint32_t TypeDatabase::getNameCount() const
+	{
+		return m_header->nameCount;
+	}
+
+	/**********************************************************************/
+	const typedb::NameRecord& TypeDatabase::getName(uint32_t index) const
+	{
+		return m_names[index];
+	}
+
+	/**********************************************************************/
+	std::optional<uint32_t> TypeDatabase::findName(std::string_view name) const
+	{
+		auto end = m_names + m_header->nameCount;
+		auto iter = std::lower_bound(m_names, end, name, [this](const typedb::NameRecord& record, std::string_view value) {
+			return getString(record.name) < value;
+		});
+
+		if (iter == end || getString(iter->name) != name)
+		{
+			return std::nullopt;
+		}
+		return iter->type;
+	}
+
+	/**********************************************************************/
+	std::optional<uint32_t> TypeDatabase::findAddress(uint64_t ea) const
+	{
+		auto end = m_addresses + m_header->addressCount;
+		auto iter = std::lower_bound(m_addresses, end, ea, [](const typedb::AddressRecord& record, uint64_t value) {
+			return record.ea < value;
+		});
+
+		if (iter == end || iter->ea != ea)
+		{
+			return std::nullopt;
+		}
+		return iter->type;
+	}
+
+	/**********************************************************************/
+	uint32_t TypeDatabaseWriter::addString(std::string_view value)
+	{
+		auto known = m_stringOffsets.find(value);
+		if (known != m_stringOffsets.end())
+		{
+			return known->second;
+		}
+
+		auto offset = static_cast<uint32_t>(m_strings.size());
+		auto length = static_cast<uint32_t>(value.size());
+		auto lengthBytes = reinterpret_cast<const uint8_t*>(&length);
+		m_strings.insert(m_strings.end(), lengthBytes, lengthBytes + sizeof(length));
+		m_strings.insert(m_strings.end(), value.begin(), value.end());
+		m_stringOffsets.emplace(std::string(value), offset);
+		return offset;
+	}
+
+	/**********************************************************************/
+	uint32_t TypeDatabaseWriter::add(const TypeInfo& type)
+	{
+		auto key = type.getKey();
+		auto known = m_indexes.find(key);
+		if (known != m_indexes.end())
+		{
+			return known->second;
+		}
+
+		// register before nested types, recursive types refer to it
+		auto index = static_cast<uint32_t>(m_types.size());
+		m_indexes.emplace(key, index);
+		m_types.push_back(typedb::TypeRecord{
+			addString(type.getName()),
+			static_cast<uint32_t>(typedb::Kind::Unknown),
+			type.getSize(),
+			typedb::NONE,
+			type.isConst() ? typedb::FLAG_CONST : 0u,
+			0, 0, 0,
+			typedb::NONE,
+			0
+		});
+
+		// nested types move m_types, so fill a copy
+		auto record = m_types[index];
+		std::vector<typedb::MemberRecord> members;
+		auto setKind = [&record](typedb::Kind kind) { record.kind = static_cast<uint32_t>(kind); };
+
+		if (type.visitPointedObject([this, &record](const TypeInfo& pointed) { record.target = add(pointed); }))
+		{
+			setKind(typedb::Kind::Pointer);
+		}
+		else if (type.isBool())
+		{
+			setKind(typedb::Kind::Bool);
+		}
+		else if (type.isUnicode())
+		{
+			setKind(typedb::Kind::Unicode);
+		}
+		else if (type.isChar())
+		{
+			setKind(typedb::Kind::Char);
+		}
+		else if (type.isInt())
+		{
+			setKind(typedb::Kind::Int);
+		}
+		else if (type.isFloat())
+		{
+			setKind(typedb::Kind::Float);
+		}
+		else if (type.visitStruct([this, &members](const StructInfo& structType) {
+			structType.visitFields([this, &members](uint64_t offset, std::string_view name, const TypeInfo& field) {
+				members.push_back(typedb::MemberRecord{ addString(name), add(field), offset });
+			});
+		}))
+		{
+			setKind(typedb::Kind::Struct);
+		}
+		else if (type.isVoid())
+		{
+			setKind(typedb::Kind::Void);
+		}
+		else if (type.visitFunc([this, &record, &members](const FuncInfo& funcType) {
+			auto signature = funcType.getSignature();
+			if (signature.returnType != nullptr)
+			{
+				record.target = add(*signature.returnType);
+			}
+
+			for (size_t i = 0; i < signature.paramTypes.size(); i++)
+			{
+				auto name = i < signature.paramNames.size() ? addString(signature.paramNames[i]) : typedb::NONE;
+				members.push_back(typedb::MemberRecord{ name, add(*signature.paramTypes[i]), i });
+			}
+
+			if (signature.callingConv.has_value())
+			{
+				record.callingConv = addString(signature.callingConv.value());
+			}
+
+			if (signature.isDotDotDot)
+			{
+				record.flags |= typedb::FLAG_DOTDOTDOT;
+			}
+		}))
+		{
+			setKind(typedb::Kind::Function);
+		}
+		else if (auto arrayType = type.toArray(); arrayType.has_value())
+		{
+			setKind(typedb::Kind::Array);
+			record.count = arrayType.value()->getSize();
+			type.visitArrayElement([this, &record](const TypeInfo& element) { record.target = add(element); });
+		}
+
+		record.firstMember = static_cast<uint32_t>(m_members.size());
+		record.memberCount = static_cast<uint32_t>(members.size());
+		m_members.insert(m_members.end(), members.begin(), members.end());
+		m_types[index] = record;
+		return index;
+	}
+
+	/**********************************************************************/
+	void TypeDatabaseWriter::addName(const std::string& name, const TypeInfo& type)
+	{
+		auto index = add(type);
+		// the name may differ from the one of the type, so pool it too
+		addString(name);
+		m_names.insert_or_assign(name, index);
+	}
+
+	/**********************************************************************/
+	void TypeDatabaseWriter::addAddress(uint64_t ea, const TypeInfo& type)
+	{
+		auto index = add(type);
+		m_addresses.insert_or_assign(ea, index);
+	}
+
+	/**********************************************************************/
+	std::vector<uint8_t> TypeDatabaseWriter::serialize() const
+	{
+		std::vector<typedb::NameRecord> names;
+		for (auto& [name, type] : m_names)
+		{
+			names.push_back(typedb::NameRecord{ m_stringOffsets.find(name)->second, type });
+		}
+
+		std::vector<typedb::AddressRecord> addresses;
+		for (auto& [ea, type] : m_addresses)
+		{
+			addresses.push_back(typedb::AddressRecord{ ea, type, 0 });
+		}
+
+		typedb::Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, typedb::MAGIC, sizeof(typedb::MAGIC));
+		header.version = typedb::VERSION;
+		header.typeCount = static_cast<uint32_t>(m_types.size());
+		header.memberCount = static_cast<uint32_t>(m_members.size());
+		header.nameCount = static_cast<uint32_t>(names.size());
+		header.addressCount = static_cast<uint32_t>(addresses.size());
+		header.typesOffset = _Align(sizeof(header));
+		header.membersOffset = _Align(header.typesOffset + m_types.size() * sizeof(typedb::TypeRecord));
+		header.namesOffset = _Align(header.membersOffset + m_members.size() * sizeof(typedb::MemberRecord));
+		header.addressesOffset = _Align(header.namesOffset + names.size() * sizeof(typedb::NameRecord));
+		header.stringsOffset = _Align(header.addressesOffset + addresses.size() * sizeof(typedb::AddressRecord));
+		header.stringsSize = m_strings.size();
+
+		std::vector<uint8_t> result(header.stringsOffset + header.stringsSize, 0);
+		std::memcpy(result.data(), &header, sizeof(header));
+		_Copy(result.data() + header.typesOffset, m_types.data(), m_types.size() * sizeof(typedb::TypeRecord));
+		_Copy(result.data() + header.membersOffset, m_members.data(), m_members.size() * sizeof(typedb::MemberRecord));
+		_Copy(result.data() + header.namesOffset, names.data(), names.size() * sizeof(typedb::NameRecord));
+		_Copy(result.data() + header.addressesOffset, addresses.data(), addresses.size() * sizeof(typedb::AddressRecord));
+		_Copy(result.data() + header.stringsOffset, m_strings.data(), m_strings.size());
+		return result;
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> TypeDatabaseWriter::getKeys() const
+	{
+		std::vector<std::string> result(m_types.size());
+		for (auto& [key, index] : m_indexes)
+		{
+			result[index] = key;
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	void TypeDatabaseWriter::save(const std::string& path) const
+	{
+		auto content = serialize();
+		std::ofstream output(path, std::ios::binary | std::ios::trunc);
+		output.write(reinterpret_cast<const char*>(content.data()), content.size());
+		if (!output)
+		{
+			throw InvalidTypeDatabase(path, "unable to write file");
+		}
+	}
+
+	/**********************************************************************/
+	FileTypeInfo::FileTypeInfo(std::shared_ptr<const TypeDatabase> database, uint32_t index)
+		: m_database{ std::move(database) }, m_index{ index }
+	{}
+
+	/**********************************************************************/
+	const typedb::TypeRecord& FileTypeInfo::getRecord() const
+	{
+		return m_database->getType(m_index);
+	}
+
+	/**********************************************************************/
+	typedb::Kind FileTypeInfo::getKind() const
+	{
+		return static_cast<typedb::Kind>(getRecord().kind);
+	}
+
+	/**********************************************************************/
+	size_t FileTypeInfo::getSize() const
+	{
+		return static_cast<size_t>(getRecord().size);
+	}
+
+	/**********************************************************************/
+	std::string FileTypeInfo::getName() const
+	{
+		return std::string(m_database->getString(getRecord().name));
+	}
+
+	/**********************************************************************/
+	std::string FileTypeInfo::getKey() const
+	{
+		return m_database->getKey(m_index);
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isInt() const
+	{
+		auto kind = getKind();
+		return kind == typedb::Kind::Int || kind == typedb::Kind::Char || kind == typedb::Kind::Unicode;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isBool() const
+	{
+		return getKind() == typedb::Kind::Bool;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isFloat() const
+	{
+		return getKind() == typedb::Kind::Float;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isVoid() const
+	{
+		return getKind() == typedb::Kind::Void;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isConst() const
+	{
+		return (getRecord().flags & typedb::FLAG_CONST) != 0;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isChar() const
+	{
+		return getKind() == typedb::Kind::Char;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::isUnicode() const
+	{
+		return getKind() == typedb::Kind::Unicode;
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<FuncInfo>> FileTypeInfo::toFunc() const
+	{
+		if (getKind() != typedb::Kind::Function)
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileFuncInfo>(*this);
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<StructInfo>> FileTypeInfo::toStruct() const
+	{
+		if (getKind() != typedb::Kind::Struct)
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileStructInfo>(*this);
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<PtrInfo>> FileTypeInfo::toPtr() const
+	{
+		if (getKind() != typedb::Kind::Pointer)
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FilePtrInfo>(*this);
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<ArrayInfo>> FileTypeInfo::toArray() const
+	{
+		if (getKind() != typedb::Kind::Array)
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileArrayInfo>(*this);
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::visitPointedObject(FunctionRef<void(const TypeInfo&)> visitor) const
+	{
+		if (getKind() != typedb::Kind::Pointer)
+		{
+			return false;
+		}
+		visitor(FileTypeInfo(m_database, getRecord().target));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::visitArrayElement(FunctionRef<void(const TypeInfo&)> visitor) const
+	{
+		if (getKind() != typedb::Kind::Array)
+		{
+			return false;
+		}
+		visitor(FileTypeInfo(m_database, getRecord().target));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::visitFunc(FunctionRef<void(const FuncInfo&)> visitor) const
+	{
+		if (getKind() != typedb::Kind::Function)
+		{
+			return false;
+		}
+		visitor(FileFuncInfo(*this));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool FileTypeInfo::visitStruct(FunctionRef<void(const StructInfo&)> visitor) const
+	{
+		if (getKind() != typedb::Kind::Struct)
+		{
+			return false;
+		}
+		visitor(FileStructInfo(*this));
+		return true;
+	}
+
+	/**********************************************************************/
+	FileFuncInfo::FileFuncInfo(FileTypeInfo info)
+		: m_info{ info }
+	{}
+
+	/**********************************************************************/
+	bool FileFuncInfo::isDotDotDot() const
+	{
+		return (m_info.getRecord().flags & typedb::FLAG_DOTDOTDOT) != 0;
+	}
+
+	/**********************************************************************/
+	std::vector<std::unique_ptr<TypeInfo>> FileFuncInfo::getFuncPrototype() const
+	{
+		std::vector<std::unique_ptr<TypeInfo>> result;
+		visitPrototype([&result](const TypeInfo& type) {
+			result.push_back(std::make_unique<FileTypeInfo>(static_cast<const FileTypeInfo&>(type)));
+		});
+		return result;
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> FileFuncInfo::getFuncParamName() const
+	{
+		std::vector<std::string> result;
+		auto& record = m_info.getRecord();
+		for (uint32_t i = 0; i < record.memberCount; i++)
+		{
+			result.emplace_back(m_info.m_database->getString(m_info.m_database->getMember(record.firstMember + i).name));
+		}
+		return result;
+	}
+
+	/**********************************************************************/
+	std::string FileFuncInfo::getCallingConv() const
+	{
+		auto& record = m_info.getRecord();
+		if (record.callingConv == typedb::NONE)
+		{
+			throw UnknownCallingConvention(getName());
+		}
+		return std::string(m_info.m_database->getString(record.callingConv));
+	}
+
+	/**********************************************************************/
+	std::string FileFuncInfo::getName() const
+	{
+		return m_info.getName();
+	}
+
+	/**********************************************************************/
+	FunctionSignature FileFuncInfo::getSignature() const
+	{
+		auto& record = m_info.getRecord();
+		FunctionSignature signature{ nullptr, {}, getFuncParamName(), std::nullopt, isDotDotDot() };
+		if (record.target != typedb::NONE)
+		{
+			signature.returnType = std::make_unique<FileTypeInfo>(m_info.m_database, record.target);
+		}
+
+		for (uint32_t i = 0; i < record.memberCount; i++)
+		{
+			signature.paramTypes.push_back(std::make_unique<FileTypeInfo>(m_info.m_database, m_info.m_database->getMember(record.firstMember + i).type));
+		}
+
+		if (record.callingConv != typedb::NONE)
+		{
+			signature.callingConv = std::string(m_info.m_database->getString(record.callingConv));
+		}
+		return signature;
+	}
+
+	/**********************************************************************/
+	void FileFuncInfo::visitPrototype(FunctionRef<void(const TypeInfo&)> visitor) const
+	{
+		// same as getFuncPrototype, no return type means no prototype
+		auto& record = m_info.getRecord();
+		if (record.target == typedb::NONE)
+		{
+			return;
+		}
+
+		visitor(FileTypeInfo(m_info.m_database, record.target));
+		for (uint32_t i = 0; i < record.memberCount; i++)
+		{
+			visitor(FileTypeInfo(m_info.m_database, m_info.m_database->getMember(record.firstMember + i).type));
+		}
+	}
+
+	/**********************************************************************/
+	FileStructInfo::FileStructInfo(FileTypeInfo info)
+		: m_info{ info }
+	{}
+
+	/**********************************************************************/
+	std::vector<TypeStructField> FileStructInfo::getFields() const
+	{
+		std::vector<TypeStructField> result;
+		visitFields([&result](uint64_t offset, std::string_view name, const TypeInfo& type) {
+			result.push_back(TypeStructField{ offset, std::string(name), std::make_unique<FileTypeInfo>(static_cast<const FileTypeInfo&>(type)) });
+		});
+		return result;
+	}
+
+	/**********************************************************************/
+	void FileStructInfo::visitFields(FunctionRef<void(uint64_t, std::string_view, const TypeInfo&)> visitor) const
+	{
+		auto& record = m_info.getRecord();
+		for (uint32_t i = 0; i < record.memberCount; i++)
+		{
+			auto& member = m_info.m_database->getMember(record.firstMember + i);
+			visitor(member.offset, m_info.m_database->getString(member.name), FileTypeInfo(m_info.m_database, member.type));
+		}
+	}
+
+	/**********************************************************************/
+	FilePtrInfo::FilePtrInfo(FileTypeInfo info)
+		: m_info{ info }
+	{}
+
+	/**********************************************************************/
+	std::unique_ptr<TypeInfo> FilePtrInfo::getPointedObject() const
+	{
+		return std::make_unique<FileTypeInfo>(m_info.m_database, m_info.getRecord().target);
+	}
+
+	/**********************************************************************/
+	FileArrayInfo::FileArrayInfo(FileTypeInfo info)
+		: m_info{ info }
+	{}
+
+	/**********************************************************************/
+	std::unique_ptr<TypeInfo> FileArrayInfo::getPointedObject() const
+	{
+		return std::make_unique<FileTypeInfo>(m_info.m_database, m_info.getRecord().target);
+	}
+
+	/**********************************************************************/
+	uint64_t FileArrayInfo::getSize() const
+	{
+		return m_info.getRecord().count;
+	}
+
+	/**********************************************************************/
+	FileTypeInfoFactory::FileTypeInfoFactory(std::unique_ptr<TypeDatabase> database)
+		: m_database{ std::move(database) }
+	{}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> FileTypeInfoFactory::build(const std::string& name)
+	{
+		auto index = m_database->findName(name);
+		if (!index.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileTypeInfo>(m_database, index.value());
+	}
+
+	/**********************************************************************/
+	std::optional<std::unique_ptr<TypeInfo>> FileTypeInfoFactory::build(uint64_t ea)
+	{
+		auto index = m_database->findAddress(ea);
+		if (!index.has_value())
+		{
+			return std::nullopt;
+		}
+		return std::make_unique<FileTypeInfo>(m_database, index.value());
+	}
+
+	/**********************************************************************/
+	std::vector<std::string> FileTypeInfoFactory::getTypeNames()
+	{
+		std::vector<std::string> result;
+		for (uint32_t i = 0; i < m_database->getNameCount(); i++)
+		{
+			result.emplace_back(m_database->getString(m_database->getName(i).name));
+		}
+		return result;
+	}
+} // end of namespace yagi
@@ -2,13 +2,15 @@
 #include "base.hh"
 #include "exception.hh"
 
+#include <algorithm>
 #include <regex>
+#include <sstream>
 
 namespace yagi 
 {
 	/**********************************************************************/
 	TypeManager::TypeManager(YagiArchitecture* architecture)
-		: ::TypeFactory(architecture), m_archi(architecture)
+		: ::TypeFactory(architecture), m_archi(architecture), m_stats{ 0, 0 }, m_syncEpoch{ 0 }, m_flushCount{ 0 }, m_translateDepth{ 0 }
 	{
 
 	}
@@ -20,6 +22,7 @@ namespace yagi
 
 		if (cached != nullptr)
 		{
+			addDependencies(cached);
 			return cached;
 		}
 
@@ -30,38 +33,30 @@ namespace yagi
 			throw UnknownTypeError(n);
 		}
 
-		return parseTypeInfo(*(type.value()));
+		return findByTypeInfo(*(type.value()));
 	}
 
 	/**********************************************************************/
-	TypeCode* TypeManager::parseFunc(const FuncInfo& typeInfo)
+	TypeCode* TypeManager::parseFunc(const std::string& name, const FunctionSignature& signature)
 	{
-		auto prototype = typeInfo.getFuncPrototype();
+		// storage of parameters and return value needs the size of structures used by value
 		Datatype* retType = getTypeVoid();
-		std::vector<Datatype*> paramType;
-
-		if (prototype.size() > 0)
+		if (signature.returnType != nullptr)
 		{
-			retType = findByTypeInfo(*(prototype.front()));
-
-			auto paramIter = prototype.begin();
-			paramIter++;
-			std::transform(paramIter, prototype.end(), std::back_inserter(paramType),
-				[this](const std::unique_ptr<TypeInfo>& type)
-				{
-					return findByTypeInfo(*type);
-				}
-			);
+			retType = findByTypeInfo(*signature.returnType);
+			completeStruct(retType);
 		}
 
-		// handle calling convention conversion
-		std::string cc = "__stdcall";
-		try
+		std::vector<Datatype*> paramType;
+		for (auto& type : signature.paramTypes)
 		{
-			cc = typeInfo.getCallingConv();
+			auto param = findByTypeInfo(*type);
+			completeStruct(param);
+			paramType.push_back(param);
 		}
-		catch (UnknownCallingConvention&)
-		{}
+
+		// handle calling convention conversion
+		std::string cc = signature.callingConv.value_or("__stdcall");
 			
 		if (!glb->hasModel(cc))
 		{
@@ -71,25 +66,42 @@ namespace yagi
 			{
 				cc = (*m_archi->protoModels.begin()).first;
 			}
-			m_archi->getLogger().info("use ", cc, std::string("as default calling convention for "), typeInfo.getName());
+			YAGI_DEBUG(m_archi->getLogger(), "use ", cc, "as default calling convention for ", name);
 		}
 
-		auto newType = getTypeCode(glb->getModel(cc), retType, paramType, typeInfo.isDotDotDot());
-		setName(newType, typeInfo.getName());
+		auto newType = getTypeCode(glb->getModel(cc), retType, paramType, signature.isDotDotDot);
+		setName(newType, name);
 		return newType;
 	}
 
+	/**********************************************************************/
+	std::shared_ptr<const FunctionSignature> TypeManager::findSignature(const TypeInfo& typeInfo, const FuncInfo& funcInfo)
+	{
+		auto& epochs = m_archi->getEpochs();
+		auto key = typeInfo.getKey();
+
+		auto cached = m_signatures.find(key);
+		if (cached != m_signatures.end() && cached->second.epoch >= epochs.getTypeEpoch(cached->second.name))
+		{
+			return cached->second.signature;
+		}
+
+		auto signature = std::make_shared<const FunctionSignature>(funcInfo.getSignature());
+		m_signatures.insert_or_assign(key, CachedSignature{ signature, typeInfo.getName(), epochs.getCurrent() });
+		return signature;
+	}
+
 	/**********************************************************************/
 	Datatype* TypeManager::parseTypeInfo(const TypeInfo& typeInfo)
 	{
 		auto name = typeInfo.getName();
 
-		auto ptrType = typeInfo.toPtr();
-		if (ptrType.has_value())
+		Datatype* pointed = nullptr;
+		if (typeInfo.visitPointedObject([this, &pointed](const TypeInfo& type) { pointed = findByTypeInfo(type); }))
 		{
 			auto ct = getTypePointer(
 				glb->getDefaultCodeSpace()->getAddrSize(),
-				findByTypeInfo(*ptrType.value()->getPointedObject()),
+				pointed,
 				glb->getDefaultCodeSpace()->getWordSize()
 			);
 			setName(ct, name);
@@ -134,16 +146,11 @@ namespace yagi
 		auto structType = typeInfo.toStruct();
 		if (structType.has_value())
 		{
+			// fields are set later, so recursive references find the placeholder
 			auto ct = getTypeStruct(name);
-			auto fields = structType.value()->getFields();
-			std::vector<TypeField> result;
-			std::transform(fields.begin(), fields.end(), std::back_inserter(result),
-				[this](const TypeStructField& info)
-				{
-					return TypeField{ static_cast<int4>(info.offset), info.name, findByTypeInfo(*(info.type)) };
-				}
-			);
-			setFields(result, ct, 0, 0);
+			m_typeCache.insert_or_assign(typeInfo.getKey(), CachedType{ ct, name, m_archi->getEpochs().getCurrent() });
+			m_pendingStructs.emplace(ct, std::move(structType.value()));
+			m_pendingOrder.push_back(ct);
 			return ct;
 		}
 
@@ -159,24 +166,27 @@ namespace yagi
 			return ct;
 		}
 
-		auto funcType = typeInfo.toFunc();
-		if (funcType.has_value())
+		Datatype* funcType = nullptr;
+		if (typeInfo.visitFunc([this, &name, &typeInfo, &funcType](const FuncInfo& func) { funcType = parseFunc(name, *findSignature(typeInfo, func)); }))
 		{
-			return parseFunc(*funcType.value());
+			return funcType;
 		}
 
-		auto arrayType = typeInfo.toArray();
-		if (arrayType.has_value())
+		Datatype* element = nullptr;
+		if (typeInfo.visitArrayElement([this, &element](const TypeInfo& type) { element = findByTypeInfo(type); }))
 		{
 			// if an array of size 0 doesn't handle by ghidra
 			if (typeInfo.getSize() == 0)
 			{
-				return findByTypeInfo(*arrayType.value()->getPointedObject());
+				return element;
 			}
 			
+			// element is used by value
+			completeStruct(element);
+
 			auto ct = getTypeArray(
 				typeInfo.getSize(), 
-				findByTypeInfo(*arrayType.value()->getPointedObject())
+				element
 			);
 			setName(ct, name);
 			return ct;
@@ -195,52 +205,597 @@ namespace yagi
 	/**********************************************************************/
 	Datatype* TypeManager::findByTypeInfo(const TypeInfo& typeInfo)
 	{
+		auto& epochs = m_archi->getEpochs();
+		auto key = typeInfo.getKey();
+
+		auto cached = m_typeCache.find(key);
+		if (cached != m_typeCache.end() && cached->second.epoch >= epochs.getTypeEpoch(cached->second.name))
+		{
+			m_stats.hits++;
+
+			// a structure that failed to complete is retried when asked again
+			if (m_translateDepth == 0)
+			{
+				completeStruct(cached->second.type);
+			}
+			addDependencies(cached->second.type);
+			return cached->second.type;
+		}
+
+		m_stats.misses++;
+
+		// avoid findByName which throws on unknown types
+		auto name = typeInfo.getName();
+		auto type = findByIdLocal(name, 0);
+		if (type == nullptr)
+		{
+			m_translateDepth++;
+			try
+			{
+				type = parseTypeInfo(typeInfo);
+			}
+			catch (...)
+			{
+				m_translateDepth--;
+				throw;
+			}
+			m_translateDepth--;
+		}
+
+		m_typeCache.insert_or_assign(key, CachedType{ type, name, epochs.getCurrent() });
+
+		// outermost translation completes structures created meanwhile
+		// a failure only concerns the caller if it asked for the failing structure,
+		// the others stay pending until a lookup needs them again
+		while (m_translateDepth == 0 && !m_pendingOrder.empty())
+		{
+			auto pending = m_pendingOrder.front();
+			m_pendingOrder.pop_front();
+			try
+			{
+				completeStruct(pending);
+			}
+			catch (LowlevelError& e)
+			{
+				if (pending == type)
+				{
+					throw;
+				}
+				m_archi->getLogger().error("Unable to complete structure ", pending->getName(), e.explain);
+			}
+			catch (Error& e)
+			{
+				if (pending == type)
+				{
+					throw;
+				}
+				m_archi->getLogger().error("Unable to complete structure ", pending->getName(), std::string(e.what()));
+			}
+		}
+
+		if (m_translateDepth == 0)
+		{
+			completeStruct(type);
+		}
+
+		addDependencies(type);
+		return type;
+	}
+
+	/**********************************************************************/
+	void TypeManager::addDependencies(const Datatype* type)
+	{
+		auto dependencies = m_archi->getDependencies();
+		if (dependencies == nullptr || type == nullptr || type->isCoreType())
+		{
+			return;
+		}
+
+		// named types are walked once, which also stops on recursive structures
+		if (!type->getName().empty() && !dependencies->addType(type->getName()))
+		{
+			return;
+		}
+
+		for (auto i = 0; i < type->numDepend(); i++)
+		{
+			addDependencies(type->getDepend(i));
+		}
+
+		if (type->getMetatype() == TYPE_CODE)
+		{
+			auto proto = static_cast<const TypeCode*>(type)->getPrototype();
+			if (proto != nullptr)
+			{
+				addDependencies(*proto);
+			}
+		}
+	}
+
+	/**********************************************************************/
+	void TypeManager::addDependencies(const FuncProto& proto)
+	{
+		if (m_archi->getDependencies() == nullptr)
+		{
+			return;
+		}
+
+		addDependencies(proto.getOutputType());
+		for (auto i = 0; i < proto.numParams(); i++)
+		{
+			addDependencies(proto.getParam(i)->getType());
+		}
+	}
+
+	/**********************************************************************/
+	void TypeManager::completeStruct(Datatype* type)
+	{
+		auto pending = m_pendingStructs.find(type);
+		if (pending == m_pendingStructs.end())
+		{
+			return;
+		}
+
+		// remove it first, a structure is completed once
+		auto structInfo = std::move(pending->second);
+		m_pendingStructs.erase(pending);
+
+		m_translateDepth++;
 		try
 		{
-			return findByName(typeInfo.getName());
+			std::vector<TypeField> result;
+			structInfo->visitFields([this, &result](uint64_t offset, std::string_view name, const TypeInfo& type)
+				{
+					auto fieldType = findByTypeInfo(type);
+
+					// a field used by value needs its size
+					completeStruct(fieldType);
+					result.push_back(TypeField{ static_cast<int4>(offset), std::string(name), fieldType });
+				}
+			);
+			setFields(result, static_cast<TypeStruct*>(type), 0, 0);
+		}
+		catch (...)
+		{
+			// keep it pending, the placeholder has no fields yet
+			m_pendingStructs.emplace(type, std::move(structInfo));
+			m_translateDepth--;
+			throw;
 		}
-		catch (UnknownTypeError&) {}
+		m_translateDepth--;
+	}
 
-		return parseTypeInfo(typeInfo);
+	/**********************************************************************/
+	void TypeManager::flush()
+	{
+		m_typeCache.clear();
+		m_signatures.clear();
+		m_functionSignatures.clear();
+		m_pendingStructs.clear();
+		m_pendingOrder.clear();
+		clearNoncore();
+		m_flushCount++;
 	}
 
 	/**********************************************************************/
-	void TypeManager::update(Funcdata& func)
+	bool TypeManager::dependsOn(const Datatype* type, const std::set<Datatype*>& types)
+	{
+		for (auto i = 0; i < type->numDepend(); i++)
+		{
+			if (types.find(type->getDepend(i)) != types.end())
+			{
+				return true;
+			}
+		}
+
+		// function types don't expose their prototype as dependencies
+		if (type->getMetatype() == TYPE_CODE)
+		{
+			auto proto = static_cast<const TypeCode*>(type)->getPrototype();
+			if (proto == nullptr)
+			{
+				return false;
+			}
+
+			if (types.find(proto->getOutputType()) != types.end())
+			{
+				return true;
+			}
+
+			for (auto i = 0; i < proto->numParams(); i++)
+			{
+				if (types.find(proto->getParam(i)->getType()) != types.end())
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/**********************************************************************/
+	std::set<Datatype*> TypeManager::findStale(const std::vector<std::string>& names) const
 	{
-		auto typeInfo = m_archi->getTypeInfoFactory().build(func.getAddress().getOffset());
-		if (!typeInfo.has_value())
+		std::set<Datatype*> stale;
+		for (auto& name : names)
+		{
+			auto type = findByIdLocal(name, 0);
+			if (type != nullptr && !type->isCoreType())
+			{
+				stale.insert(type);
+			}
+		}
+
+		if (stale.empty())
+		{
+			return stale;
+		}
+
+		// loop until fix point because of recursive types
+		std::vector<Datatype*> order;
+		dependentOrder(order);
+		auto changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (auto type : order)
+			{
+				if (!type->isCoreType() && stale.find(type) == stale.end() && dependsOn(type, stale))
+				{
+					stale.insert(type);
+					changed = true;
+				}
+			}
+		}
+		return stale;
+	}
+
+	/**********************************************************************/
+	void TypeManager::destroyStale(const std::set<Datatype*>& stale)
+	{
+		if (stale.empty())
 		{
 			return;
 		}
 
-		// handle the pointer to function type
-		auto ptrType = typeInfo.value()->toPtr();
-		if (ptrType.has_value())
+		for (auto iter = m_typeCache.begin(); iter != m_typeCache.end();)
+		{
+			if (stale.find(iter->second.type) != stale.end())
+			{
+				iter = m_typeCache.erase(iter);
+			}
+			else
+			{
+				iter++;
+			}
+		}
+
+		for (auto type : stale)
+		{
+			m_pendingStructs.erase(type);
+		}
+		m_pendingOrder.erase(
+			std::remove_if(m_pendingOrder.begin(), m_pendingOrder.end(), [&stale](Datatype* type) { return stale.find(type) != stale.end(); }),
+			m_pendingOrder.end()
+		);
+
+		// destroy users before the type they use
+		std::vector<Datatype*> order;
+		dependentOrder(order);
+		for (auto iter = order.rbegin(); iter != order.rend(); iter++)
 		{
-			typeInfo = ptrType.value()->getPointedObject();
+			if (stale.find(*iter) != stale.end())
+			{
+				destroyType(*iter);
+			}
 		}
+	}
 
-		auto funcType = typeInfo.value()->toFunc();
+	/**********************************************************************/
+	void TypeManager::invalidate(const std::vector<std::string>& names)
+	{
+		destroyStale(findStale(names));
+	}
+
+	/**********************************************************************/
+	TypeManager::TypeChanges TypeManager::collectChanges() const
+	{
+		auto& epochs = m_archi->getEpochs();
+		TypeChanges changes{ false, {}, epochs.getCurrent() };
+		if (epochs.getTypeLibraryEpoch() > m_syncEpoch)
+		{
+			changes.flush = true;
+		}
+		else
+		{
+			changes.stale = findStale(epochs.getTypesChangedSince(m_syncEpoch));
+		}
+		return changes;
+	}
 
-		// it's not a function
-		if (!funcType.has_value())
+	/**********************************************************************/
+	void TypeManager::synchronize(const TypeChanges& changes)
+	{
+		if (changes.flush)
+		{
+			flush();
+		}
+		else
+		{
+			destroyStale(changes.stale);
+		}
+		m_syncEpoch = changes.epoch;
+	}
+
+	/**********************************************************************/
+	void TypeManager::synchronize()
+	{
+		synchronize(collectChanges());
+	}
+
+	/**********************************************************************/
+	const TypeManager::CacheStats& TypeManager::getCacheStats() const noexcept
+	{
+		return m_stats;
+	}
+
+	/**********************************************************************/
+	uint64_t TypeManager::getFlushCount() const noexcept
+	{
+		return m_flushCount;
+	}
+
+	/**********************************************************************/
+	void TypeManager::update(Funcdata& func)
+	{
+		// no backend query while the function is unchanged
+		if (applyRecovered(func))
 		{
-			m_archi->getLogger().error("Unable to update function ", func.getName(), std::string(" : symbol is not a function"));
 			return;
 		}
 
-		auto type = parseFunc(*(funcType.value()));
+		auto& epochs = m_archi->getEpochs();
+		auto ea = func.getAddress().getOffset();
+
+		auto cached = m_functionSignatures.find(ea);
+		if (cached == m_functionSignatures.end() || 
+			cached->second.epoch < std::max(epochs.getAddressEpoch(ea), epochs.getTypeEpoch(cached->second.name)))
+		{
+			cached = m_functionSignatures.insert_or_assign(ea, CachedSignature{ nullptr, "", epochs.getCurrent() }).first;
+
+			auto typeInfo = m_archi->getTypeInfoFactory().build(ea);
+			if (!typeInfo.has_value())
+			{
+				return;
+			}
+
+			// handle the pointer to function type
+			auto ptrType = typeInfo.value()->toPtr();
+			if (ptrType.has_value())
+			{
+				typeInfo = ptrType.value()->getPointedObject();
+			}
+
+			auto isFunc = typeInfo.value()->visitFunc([this, &typeInfo, &cached](const FuncInfo& funcType) {
+				cached->second.signature = findSignature(*typeInfo.value(), funcType);
+			});
+
+			// it's not a function
+			if (!isFunc)
+			{
+				m_archi->getLogger().error("Unable to update function ", func.getName(), std::string(" : symbol is not a function"));
+				return;
+			}
+
+			cached->second.name = typeInfo.value()->getName();
+		}
+
+		auto signature = cached->second.signature;
+		auto name = cached->second.name;
+		if (signature == nullptr)
+		{
+			return;
+		}
+
+		auto type = parseFunc(name, *signature);
 		auto proto = type->getPrototype();
 
 		PrototypePieces pieces;
 		proto->getPieces(pieces);
 
 		// Update with param name if possible
-		auto newParamNames = funcType.value()->getFuncParamName();
-		if (newParamNames.size() == pieces.innames.size())
+		if (signature->paramNames.size() == pieces.innames.size())
 		{
-			pieces.innames = funcType.value()->getFuncParamName();
+			pieces.innames = signature->paramNames;
 			func.getFuncProto().setPieces(pieces);
 		}
 	}
+
+	/**********************************************************************/
+	static std::string _SaveType(const Datatype& type)
+	{
+		std::stringstream ss;
+		type.saveXml(ss);
+		return ss.str();
+	}
+
+	/**********************************************************************/
+	Datatype* TypeManager::restoreRecoveredType(const std::string& xml)
+	{
+		std::istringstream ss(xml);
+		std::unique_ptr<Document> document(xml_tree(ss));
+		return restoreXmlType(document->getRoot());
+	}
+
+	/**********************************************************************/
+	uint64_t TypeManager::getValidSince(uint64_t ea) const
+	{
+		auto& epochs = m_archi->getEpochs();
+		return std::max(epochs.getAddressEpoch(ea), epochs.getLastTypeEpoch());
+	}
+
+	/**********************************************************************/
+	std::optional<RecoveredPrototype> TypeManager::findRecovered(const PrototypeStore& prototypes, uint64_t ea) const
+	{
+		// a prototype published later outdates the decompilation, even if none is found now
+		auto dependencies = m_archi->getDependencies();
+		if (dependencies != nullptr)
+		{
+			dependencies->addPrototype(ea, prototypes.getVersion(ea));
+		}
+		return prototypes.find(ea, getValidSince(ea));
+	}
+
+	/**********************************************************************/
+	bool TypeManager::applyRecovered(Funcdata& func)
+	{
+		auto prototypes = m_archi->getPrototypeStore();
+		if (prototypes == nullptr)
+		{
+			return false;
+		}
+
+		auto ea = func.getAddress().getOffset();
+		auto prototype = findRecovered(*prototypes, ea);
+		if (!prototype.has_value())
+		{
+			return false;
+		}
+
+		try
+		{
+			PrototypePieces pieces;
+			pieces.model = m_archi->getModel(prototype.value().model);
+			if (pieces.model == nullptr)
+			{
+				pieces.model = m_archi->defaultfp;
+			}
+			pieces.name = func.getName();
+			pieces.outtype = restoreRecoveredType(prototype.value().output);
+			for (auto& input : prototype.value().inputs)
+			{
+				pieces.intypes.push_back(restoreRecoveredType(input));
+			}
+			pieces.innames = prototype.value().names;
+			pieces.dotdotdot = prototype.value().isDotDotDot;
+
+			func.getFuncProto().setPieces(pieces);
+
+			// a guess of too few call sites may be wrong,
+			// the backend type and the decompilation can still replace it
+			if (!prototype.value().isLocked())
+			{
+				func.getFuncProto().setInputLock(false);
+				func.getFuncProto().setOutputLock(false);
+				return false;
+			}
+			return true;
+		}
+		catch (LowlevelError& e)
+		{
+			m_archi->getLogger().error("Unable to apply recovered prototype of ", func.getName(), std::string(" : ") + e.explain);
+		}
+		catch (XmlError& e)
+		{
+			m_archi->getLogger().error("Unable to apply recovered prototype of ", func.getName(), std::string(" : ") + e.explain);
+		}
+		return false;
+	}
+
+	/**********************************************************************/
+	bool TypeManager::publish(uint64_t ea, const FuncProto& proto, RecoveredPrototype::Source source, const std::set<uint64_t>& callers, uint64_t epoch)
+	{
+		auto prototypes = m_archi->getPrototypeStore();
+		if (prototypes == nullptr)
+		{
+			return false;
+		}
+
+		PrototypePieces pieces;
+		pieces.outtype = nullptr;
+		proto.getPieces(pieces);
+		if (pieces.model == nullptr || pieces.outtype == nullptr)
+		{
+			return false;
+		}
+
+		RecoveredPrototype prototype{ 
+			pieces.model->getName(), 
+			_SaveType(*pieces.outtype), 
+			{}, 
+			pieces.innames, 
+			pieces.dotdotdot,
+			source,
+			1,
+			callers,
+			{},
+			epoch
+		};
+		for (auto type : pieces.intypes)
+		{
+			prototype.inputs.push_back(_SaveType(*type));
+		}
+		prototypes->publish(ea, std::move(prototype), getValidSince(ea));
+		return true;
+	}
+
+	/**********************************************************************/
+	bool TypeManager::prepareRecovery(Funcdata& func)
+	{
+		auto& proto = func.getFuncProto();
+		if (!proto.isInputLocked())
+		{
+			return true;
+		}
+
+		auto prototypes = m_archi->getPrototypeStore();
+		if (prototypes == nullptr)
+		{
+			return false;
+		}
+
+		auto ea = func.getAddress().getOffset();
+		auto prototype = findRecovered(*prototypes, ea);
+		if (!prototype.has_value() || prototype.value().source != RecoveredPrototype::Source::CallSite)
+		{
+			return false;
+		}
+
+		// the function itself knows its prototype better than its callers
+		proto.setInputLock(false);
+		proto.setOutputLock(false);
+		return true;
+	}
+
+	/**********************************************************************/
+	void TypeManager::publish(Funcdata& func, uint64_t epoch)
+	{
+		if (!publish(func.getAddress().getOffset(), func.getFuncProto(), RecoveredPrototype::Source::Decompilation, {}, epoch))
+		{
+			return;
+		}
+
+		// callers already built read the prototype from the function itself
+		PrototypePieces pieces;
+		func.getFuncProto().getPieces(pieces);
+		pieces.name = func.getName();
+		func.getFuncProto().setPieces(pieces);
+	}
+
+	/**********************************************************************/
+	void TypeManager::publishCallSites(Funcdata& func, uint64_t epoch)
+	{
+		for (int4 i = 0; i < func.numCalls(); i++)
+		{
+			auto callSpecs = func.getCallSpecs(i);
+			auto& entry = callSpecs->getEntryAddress();
+
+			// a locked prototype comes from the backend or from the store
+			if (callSpecs->isInputLocked() || entry.isInvalid() || entry.getSpace() != m_archi->getDefaultCodeSpace())
+			{
+				continue;
+			}
+			publish(entry.getOffset(), *callSpecs, RecoveredPrototype::Source::CallSite, { func.getAddress().getOffset() }, epoch);
+		}
+	}
 } // end of namespace yagi
\ No newline at end of file
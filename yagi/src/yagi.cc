@@ -25,6 +25,9 @@
 #include "idasymbol.hh"
 #include "idalogger.hh"
 #include "loader.hh"
+#include "epoch.hh"
+#include "trace.hh"
+#include "idasync.hh"
 
 
 static int processor_id() {
@@ -119,6 +122,10 @@ static yagi::Compiler compute_compiler() {
 static plugmod_t* idaapi yagi_init(void)
 {
 	auto logger = std::make_unique<yagi::IdaLogger>();
+	if (yagi::Plugin::hasOption("verbose"))
+	{
+		logger->setLevel(yagi::Logger::Level::Debug);
+	}
 
 	try
 	{
@@ -140,15 +147,43 @@ static plugmod_t* idaapi yagi_init(void)
 
 		auto compilerId = compute_compiler();
 
+		// the worker only reads the database, so copy legacy storage now
+		yagi::IdaFunctionSymbolInfo::migrateStorage();
+
+		auto epochs = std::make_shared<yagi::EpochTracker>();
+
+		// decompilation runs on a worker, IDA is only queried from its main thread
+		auto mainThread = std::make_shared<yagi::MainThread>();
+		auto snapshots = std::make_shared<yagi::TypeSnapshots>();
+		std::unique_ptr<yagi::SymbolInfoFactory> symbols = std::make_unique<yagi::MainThreadSymbolInfoFactory>(
+			std::make_unique<yagi::IdaSymbolInfoFactory>(), mainThread, epochs, snapshots
+		);
+		std::unique_ptr<yagi::TypeInfoFactory> types = std::make_unique<yagi::MainThreadTypeInfoFactory>(
+			std::make_unique<yagi::IdaTypeInfoFactory>(), mainThread, epochs, snapshots
+		);
+
+		// record every backend answer to replay the session without IDA
+		std::shared_ptr<yagi::TraceRecorder> recorder;
+		if (yagi::Plugin::hasOption("record_trace"))
+		{
+			logger->info("Recording of backend trace enabled");
+			recorder = std::make_shared<yagi::TraceRecorder>();
+			symbols = std::make_unique<yagi::RecordingSymbolInfoFactory>(std::move(symbols), recorder);
+			types = std::make_unique<yagi::RecordingTypeInfoFactory>(std::move(types), recorder);
+		}
+
 		auto decompiler = yagi::GhidraDecompiler::build(
 			compilerId,
 			std::move(logger),
-			std::make_unique<yagi::IdaSymbolInfoFactory>(),
-			std::make_unique<yagi::IdaTypeInfoFactory>()
+			std::move(symbols),
+			std::move(types),
+			epochs,
+			mainThread,
+			recorder
 		);
 		if (decompiler.has_value())
 		{
-			return new yagi::Plugin(std::move(decompiler.value()));
+			return new yagi::Plugin(std::move(decompiler.value()), epochs, mainThread, recorder);
 		}
 	}
 	catch (yagi::Error& e)
@@ -4,9 +4,79 @@
 #include "typemanager.hh"
 #include "coreaction.hh"
 #include "scope.hh"
+#include "exception.hh"
+
+#include <chrono>
+#include <sstream>
 
 namespace yagi 
 {
+	/*!
+	 * \brief	name of the ghidra root actions of each profile
+	 */
+	static const char* DECOMPILE_ACTION = "decompile";
+	static const char* PREVIEW_ACTION = "preview";
+
+	/*!
+	 * \brief	ghidra groups removed from the decompile group list
+	 *			for the preview profile, structuring and type recovery are kept
+	 *			"deindirect" resolves indirect calls and restarts the whole
+	 *			main loop each time a call becomes direct, "subvar" traces
+	 *			sub variable flows for every masked or truncated value,
+	 *			both are the expensive part of a decompilation
+	 *			"switchnorm" is kept, jump tables are still recovered
+	 *			and a switch can't be printed without its normalization
+	 */
+	static const char* PREVIEW_REMOVED_GROUPS[] = {
+		"deindirect",		// indirect call resolution, full restarts
+		"subvar",			// sub variable flow tracing
+		"doubleprecis",		// double precision recovery
+		"doubleload",
+		"floatprecision",
+		"splitcopy",		// splitting of structure copies
+		"splitpointer",
+		"conditionalexe",	// conditional execution simplification
+		"nodejoin",
+		"returnsplit"		// duplication of return blocks
+	};
+
+	/*!
+	 * \brief	Record loaded pages into the dependencies of the architecture
+	 *			Sleigh caches decoded instructions, so a function
+	 *			decompiled again may not load its code
+	 */
+	class DependencyLoader : public LoadImage
+	{
+	protected:
+		std::unique_ptr<LoadImage> m_inner;
+		YagiArchitecture* m_architecture;
+
+	public:
+		explicit DependencyLoader(std::unique_ptr<LoadImage> inner, YagiArchitecture* architecture)
+			: LoadImage(inner->getFileName()), m_inner{ std::move(inner) }, m_architecture{ architecture }
+		{}
+
+		std::string getArchType(void) const override
+		{
+			return m_inner->getArchType();
+		}
+
+		void loadFill(uint1* ptr, int4 size, const Address& addr) override
+		{
+			auto dependencies = m_architecture->getDependencies();
+			if (dependencies != nullptr)
+			{
+				dependencies->addBytes(addr.getOffset(), size);
+			}
+			m_inner->loadFill(ptr, size, addr);
+		}
+
+		void adjustVma(long adjust) override
+		{
+			m_inner->adjustVma(adjust);
+		}
+	};
+
 	/**********************************************************************/
 	YagiArchitecture::YagiArchitecture(
 		const std::string& name,
@@ -15,17 +85,21 @@ namespace yagi
 		std::unique_ptr<Logger> logger,
 		std::unique_ptr<SymbolInfoFactory> symbols,
 		std::unique_ptr<TypeInfoFactory> type,
-		std::string defaultCC
+		std::string defaultCC,
+		std::shared_ptr<EpochTracker> epochs
 	) : SleighArchitecture(name, sleighId, &m_err),
 		m_loaderFactory{ std::move(loaderFactory)},
 		m_logger{ std::move(logger) }, 
 		m_symbols{ std::move(symbols) }, 
 		m_type{ std::move(type) },
 		m_defaultCC { defaultCC },
+		m_epochs { epochs },
 		m_renameAction(Action::rule_onceperfunc, "yagirename"),
 		m_retypeAction(Action::rule_onceperfunc, "yagiretype"),
 		m_archSpecific(Action::rule_onceperfunc, "yagiarch"),
-		m_initAction(Action::rule_onceperfunc, "yagiinit")
+		m_initAction(Action::rule_onceperfunc, "yagiinit"),
+		m_dependencies{ nullptr },
+		m_canceled{ false }
 	{
 	}
 
@@ -37,7 +111,7 @@ namespace yagi
 		if (error.str().length() > 0) {
 			m_logger->error("spec files loading", error.str());
 		}
-		loader = m_loaderFactory->build();
+		loader = new DependencyLoader(std::unique_ptr<LoadImage>(m_loaderFactory->build()), this);
 	}
 
 	/**********************************************************************/
@@ -86,18 +160,37 @@ namespace yagi
 	void YagiArchitecture::buildAction(DocumentStorage& store)
 	{
 		SleighArchitecture::buildAction(store);
+
+		// copy the group list of decompile, the root action
+		// itself is only built by setCurrent
+		allacts.cloneGroup(DECOMPILE_ACTION, PREVIEW_ACTION);
+		for (auto group : PREVIEW_REMOVED_GROUPS)
+		{
+			allacts.removeFromGroup(PREVIEW_ACTION, group);
+		}
+
 		// by default we will map name use in the frame view
 		m_renameAction.addAction(new ActionSyncStackVar("yagi"));
 
-		m_renameAction.addAction(new ActionRenameVar("yagi", "register"));
-		m_renameAction.addAction(new ActionRenameVar("yagi", "stack"));
-		m_renameAction.addAction(new ActionRenameVar("yagi", "unique"));
-		m_renameAction.addAction(new ActionRenameVar("yagi", "const"));
+		// one pass for all spaces (register, stack, unique, const)
+		m_renameAction.addAction(new ActionRenameVar("yagi"));
+		m_retypeAction.addAction(new ActionLoadLocalScope("yagi"));
+	}
 
-		m_retypeAction.addAction(new ActionLoadLocalScope("yagi", "register"));
-		m_retypeAction.addAction(new ActionLoadLocalScope("yagi", "stack"));
-		m_retypeAction.addAction(new ActionLoadLocalScope("yagi", "unique"));
-		m_retypeAction.addAction(new ActionLoadLocalScope("yagi", "const"));
+	/**********************************************************************/
+	int4 YagiArchitecture::performStage(const std::string& stage, Action& action, Funcdata& data)
+	{
+		checkCanceled();
+
+		if (m_profiler == nullptr)
+		{
+			return action.perform(data);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		auto res = action.perform(data);
+		m_profiler->addStage(stage, std::chrono::steady_clock::now() - start, res);
+		return res;
 	}
 
 	/**********************************************************************/
@@ -109,30 +202,67 @@ namespace yagi
 		m_retypeAction.reset(data);
 		m_initAction.reset(data);
 
+		// stages are named after their groups in the profile
+		std::vector<std::pair<std::string, Action*>> stages = {
+			{ "init", &m_initAction },
+			{ "universal", allacts.getCurrent() },
+			{ "arch", &m_archSpecific },
+			{ "retype", &m_retypeAction },
+			{ "rename", &m_renameAction }
+		};
+
+		TypeManager::CacheStats typeStats{ 0, 0 };
+		if (m_profiler != nullptr)
+		{
+			m_profiler->begin(data.getName());
+			for (auto& [stage, action] : stages)
+			{
+				action->resetStats();
+			}
+			typeStats = static_cast<TypeManager*>(types)->getCacheStats();
+		}
+
 		// perform init action
-		m_initAction.perform(data);
+		performStage("init", m_initAction, data);
 
 		// Break just after start action
 		// to have the CFG built
 		allacts.getCurrent()->setBreakPoint(Action::break_start, "constbase");
 
-		auto res = allacts.getCurrent()->perform(data);
+		auto res = performStage("universal.start", *allacts.getCurrent(), data);
 
 		// perform Arch specific action
-		m_archSpecific.perform(data);
+		performStage("arch", m_archSpecific, data);
 
 		// provisionning of type action
-		m_retypeAction.perform(data);
+		performStage("retype", m_retypeAction, data);
 
 		allacts.getCurrent()->clearBreakPoints();
-		res = allacts.getCurrent()->perform(data);
+		res = performStage("universal", *allacts.getCurrent(), data);
+
+		if (res >= 0)
+		{
+			res += performStage("rename", m_renameAction, data);
+		}
 
-		if (res < 0)
+		if (m_profiler != nullptr)
 		{
-			return res;
+			for (auto& [stage, action] : stages)
+			{
+				std::stringstream statistics;
+				action->printStatistics(statistics);
+				m_profiler->addStatistics(stage, statistics);
+			}
+
+			auto& after = static_cast<TypeManager*>(types)->getCacheStats();
+			m_profiler->addCounter("types/cache", 
+				(after.hits + after.misses) - (typeStats.hits + typeStats.misses), 
+				after.misses - typeStats.misses
+			);
+			m_profiler->end();
 		}
 
-		return res + m_renameAction.perform(data);
+		return res;
 	}
 
 	/**********************************************************************/
@@ -171,6 +301,12 @@ namespace yagi
 		return *m_logger.get();
 	}
 
+	/**********************************************************************/
+	EpochTracker& YagiArchitecture::getEpochs() const
+	{
+		return *m_epochs.get();
+	}
+
 	/**********************************************************************/
 	const std::string& YagiArchitecture::getDefaultCC() const
 	{
@@ -194,4 +330,71 @@ namespace yagi
 		return iter->second;
 	}
 
-} // end of namespace yagi
\ No newline at end of file
+	/**********************************************************************/
+	void YagiArchitecture::setActionProfile(Decompiler::Profile profile)
+	{
+		std::string root = profile == Decompiler::Profile::Preview ? PREVIEW_ACTION : DECOMPILE_ACTION;
+		if (allacts.getCurrentName() != root)
+		{
+			allacts.setCurrent(root);
+		}
+	}
+
+	/**********************************************************************/
+	void YagiArchitecture::setProfiling(bool enable)
+	{
+		if (!enable)
+		{
+			m_profiler.reset();
+		}
+		else if (m_profiler == nullptr)
+		{
+			m_profiler = std::make_unique<Profiler>();
+		}
+	}
+
+	/**********************************************************************/
+	void YagiArchitecture::cancel() noexcept
+	{
+		m_canceled = true;
+	}
+
+	/**********************************************************************/
+	void YagiArchitecture::checkCanceled() const
+	{
+		if (m_canceled)
+		{
+			throw DecompilationCanceled();
+		}
+	}
+
+	/**********************************************************************/
+	Profiler* YagiArchitecture::getProfiler() const
+	{
+		return m_profiler.get();
+	}
+
+	/**********************************************************************/
+	void YagiArchitecture::setPrototypeStore(std::shared_ptr<PrototypeStore> prototypes)
+	{
+		m_prototypes = prototypes;
+	}
+
+	/**********************************************************************/
+	PrototypeStore* YagiArchitecture::getPrototypeStore() const
+	{
+		return m_prototypes.get();
+	}
+
+	/**********************************************************************/
+	void YagiArchitecture::setDependencies(DependencySet* dependencies)
+	{
+		m_dependencies = dependencies;
+	}
+
+	/**********************************************************************/
+	DependencySet* YagiArchitecture::getDependencies() const
+	{
+		return m_dependencies;
+	}
+} // end of namespace yagi
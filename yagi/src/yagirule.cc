@@ -3,6 +3,8 @@
 #include "typemanager.hh"
 #include "base.hh"
 
+#include <algorithm>
+
 namespace yagi 
 {
 	/**********************************************************************/
@@ -12,17 +14,48 @@ namespace yagi
 	}
 
 	/**********************************************************************/
-	int4 RuleWindowsControlFlowGuard::applyOp(PcodeOp* op, Funcdata& data)
+	bool RuleWindowsControlFlowGuard::isWrapper(PcodeOp* op, Funcdata& data)
 	{
-		auto addrSize = data.getArch()->getDefaultCodeSpace()->getAddrSize();
+		auto arch = static_cast<YagiArchitecture*>(data.getArch());
+		auto& target = op->getIn(0)->getAddr();
+
+		// wrappers are global pointers, registers and temporaries can't match
+		if (target.getSpace() != arch->getDefaultCodeSpace())
+		{
+			return false;
+		}
+
+		auto& epochs = arch->getEpochs();
+		auto cached = m_cache->find(target.getOffset());
+		if (cached != m_cache->end() && cached->second.epoch >= epochs.getAddressEpoch(target.getOffset()))
+		{
+			// the lookup is skipped, the decompilation still depends on the symbol
+			auto dependencies = arch->getDependencies();
+			if (dependencies != nullptr)
+			{
+				dependencies->addAddress(target.getOffset());
+			}
+			return cached->second.isWrapper;
+		}
+
+		auto addrSize = arch->getDefaultCodeSpace()->getAddrSize();
+		auto sym = arch->symboltab->getGlobalScope()->findContainer(target, addrSize, op->getAddr());
+		auto found = sym != nullptr && sym->getSymbol() != nullptr &&
+			std::find(m_cfgWrapperNames.begin(), m_cfgWrapperNames.end(), sym->getSymbol()->getName()) != m_cfgWrapperNames.end();
+
+		m_cache->insert_or_assign(target.getOffset(), CacheEntry{ found, epochs.getCurrent() });
+		return found;
+	}
 
-		auto sym = data.getArch()->symboltab->getGlobalScope()->findContainer(op->getIn(0)->getAddr(), addrSize, op->getAddr());
-		
+	/**********************************************************************/
+	int4 RuleWindowsControlFlowGuard::applyOp(PcodeOp* op, Funcdata& data)
+	{
 		// If the indirect call match the symbol name of the wrapped function
 		// We replace the input varnode from const space (with the associated symbol)
 		// with a register namespace
-		if (sym != nullptr && sym->getSymbol() != nullptr && sym->getSymbol()->getName() == m_cfgWrapperName)
+		if (isWrapper(op, data))
 		{
+			auto addrSize = data.getArch()->getDefaultCodeSpace()->getAddrSize();
 			auto raxAddr = data.getArch()->getDefaultCodeSpace()->getTrans()->getRegister("RAX").getAddr();
 			auto raxVn = data.newVarnode(
 				addrSize,
@@ -35,4 +68,4 @@ namespace yagi
 
 		return 0;
 	}
-} // end of namespace yagi
\ No newline at end of file
+} // end of namespace yagi